@@ -33,6 +33,7 @@ public BalancedFPSLevelGenerator(ReadOnlyTargetRules Target) : base(Target)
                 "Slate",
                 "AssetTools",
                 "UnrealEd",                
+                "BalancedFPSLevelGeneratorRuntime",
             }
 			);
 			
@@ -56,6 +57,8 @@ public BalancedFPSLevelGenerator(ReadOnlyTargetRules Target) : base(Target)
                 "DetailCustomizations",
                 "Settings",
                 "RenderCore",
+                "Json",
+                "HierarchicalLODUtilities",
             }
 			);
 		
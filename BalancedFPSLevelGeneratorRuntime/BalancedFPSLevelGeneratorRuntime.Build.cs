@@ -0,0 +1,39 @@
+// Copyright 1998-2017 Epic Games, Inc. All Rights Reserved.
+
+using System.IO;
+using UnrealBuildTool;
+
+/**
+* The parts of the level generator that a packaged game (or dedicated server) needs: the
+* solver, the Zone classes, and AZoneArenaGenerator. Nothing here may depend on the editor.
+*/
+public class BalancedFPSLevelGeneratorRuntime : ModuleRules
+{
+	public BalancedFPSLevelGeneratorRuntime(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+		
+		PublicIncludePaths.AddRange(
+			new string[] {
+				Path.Combine(ModuleDirectory, "Public")
+			}
+			);
+				
+		
+		PrivateIncludePaths.AddRange(
+			new string[] {
+				Path.Combine(ModuleDirectory, "Private"),
+			}
+			);
+			
+		
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+                "CoreUObject",
+                "Engine",
+            }
+			);
+	}
+}
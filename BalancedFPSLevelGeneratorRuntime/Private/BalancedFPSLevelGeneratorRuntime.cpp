@@ -0,0 +1,35 @@
+// Copyright 1998-2017 Epic Games, Inc. All Rights Reserved.
+
+#include "BalancedFPSLevelGeneratorRuntime.h"
+#include "UObject/CoreRedirects.h"
+
+void FBalancedFPSLevelGeneratorRuntimeModule::StartupModule()
+{
+	// This module must be loaded before the Zone Blueprints are (its loading phase is set in the .uplugin file):
+	AddClassRedirects();
+}
+
+void FBalancedFPSLevelGeneratorRuntimeModule::ShutdownModule()
+{
+}
+
+void FBalancedFPSLevelGeneratorRuntimeModule::AddClassRedirects()
+{
+	const FString EditorPackage = "/Script/BalancedFPSLevelGenerator.";
+	const FString RuntimePackage = "/Script/BalancedFPSLevelGeneratorRuntime.";
+
+	TArray<FCoreRedirect> ClassRedirects;
+
+	for (const TCHAR* MovedClassName : { TEXT("Zone"), TEXT("FPSLevelGeneratorEdge"), TEXT("InstancedStaticMeshActor") })
+	{
+		ClassRedirects.Emplace(ECoreRedirectFlags::Type_Class, EditorPackage + MovedClassName,
+			RuntimePackage + MovedClassName);
+	}
+
+	ClassRedirects.Emplace(ECoreRedirectFlags::Type_Enum, EditorPackage + TEXT("EZoneEdgeSide"),
+		RuntimePackage + TEXT("EZoneEdgeSide"));
+
+	FCoreRedirects::AddRedirectList(ClassRedirects, TEXT("BalancedFPSLevelGeneratorRuntime"));
+}
+
+IMPLEMENT_MODULE(FBalancedFPSLevelGeneratorRuntimeModule, BalancedFPSLevelGeneratorRuntime)
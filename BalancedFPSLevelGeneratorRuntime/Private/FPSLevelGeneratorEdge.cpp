@@ -3,4 +3,10 @@
 #include "FPSLevelGeneratorEdge.h"
 #include "Runtime/Engine/Classes/GameFramework/Actor.h"
 #include "Runtime/Engine/Classes/Components/StaticMeshComponent.h"
-#include "Editor/UnrealEd/Public/Editor.h"
+
+// Initialise:
+UFPSLevelGeneratorEdge::UFPSLevelGeneratorEdge()
+{
+	Side = EZoneEdgeSide::North;
+	EdgeColour = NO_EDGE_COLOUR;
+}
@@ -0,0 +1,41 @@
+// Copyright 1998-2013 Epic Games, Inc. All Rights Reserved.
+
+#include "InstancedStaticMeshActor.h"
+#include "ConstructorHelpers.h"
+#include "Runtime/Engine/Classes/Engine/World.h"
+
+// Initialise:
+AInstancedStaticMeshActor::AInstancedStaticMeshActor(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UHierarchicalInstancedStaticMeshComponent>(
+		TEXT("StaticMeshComponent0")))
+{
+}
+
+void AInstancedStaticMeshActor::AddInstances(const TArray<FTransform>& InstanceTransforms)
+{
+	UHierarchicalInstancedStaticMeshComponent* InstancedComponent = GetInstancedStaticMeshComponent();
+
+	// Sanity check:
+	if (!InstancedComponent)
+	{
+		return;
+	}
+
+	// Don't rebuild the tree for every instance added:
+	InstancedComponent->bAutoRebuildTreeOnInstanceChanges = false;
+	InstancedComponent->PerInstanceSMData.Reserve(InstancedComponent->PerInstanceSMData.Num() +
+		InstanceTransforms.Num());
+
+	for (const FTransform& InstanceTransform : InstanceTransforms)
+	{
+		InstancedComponent->AddInstanceWorldSpace(InstanceTransform);
+	}
+
+	InstancedComponent->bAutoRebuildTreeOnInstanceChanges = true;
+	InstancedComponent->BuildTreeIfOutdated(false, true);
+}
+
+UHierarchicalInstancedStaticMeshComponent* AInstancedStaticMeshActor::GetInstancedStaticMeshComponent() const
+{
+	return Cast<UHierarchicalInstancedStaticMeshComponent>(GetStaticMeshComponent());
+}
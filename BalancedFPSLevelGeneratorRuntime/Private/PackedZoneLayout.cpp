@@ -0,0 +1,165 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PackedZoneLayout.h"
+#include "ZoneMeshMerge.h"
+#include "Components/SceneComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+
+// Initialise:
+APackedZoneLayout::APackedZoneLayout()
+{
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("PackedZoneLayoutRoot"));
+
+	RegionMin = FIntPoint::ZeroValue;
+	RegionSize = FIntPoint::ZeroValue;
+	FirstZoneLocation = FVector::ZeroVector;
+	CellStep = FVector2D::ZeroVector;
+	ZoneScale = FVector(1.0f);
+}
+
+void APackedZoneLayout::InitialiseRegion(const FIntRect& ZoneRegion, const TArray<TSubclassOf<AZone>>& InZoneClasses,
+	const FVector& InFirstZoneLocation, const FVector2D& InCellStep, const FVector& InZoneScale)
+{
+	RegionMin = ZoneRegion.Min;
+	RegionSize = ZoneRegion.Size();
+	ZoneClasses = InZoneClasses;
+	FirstZoneLocation = InFirstZoneLocation;
+	CellStep = InCellStep;
+	ZoneScale = InZoneScale;
+
+	WangTileIndices.Init(NO_ZONE, RegionSize.X * RegionSize.Y);
+}
+
+void APackedZoneLayout::SetWangTileIndex(int GridX, int GridY, int WangTileIndex)
+{
+	const int RegionX = GridX - RegionMin.X;
+	const int RegionY = GridY - RegionMin.Y;
+
+	// Sanity check:
+	if (RegionX < 0 || RegionY < 0 || RegionX >= RegionSize.X || RegionY >= RegionSize.Y)
+	{
+		return;
+	}
+
+	WangTileIndices[RegionY * RegionSize.X + RegionX] = ZoneClasses.IsValidIndex(WangTileIndex) ?
+		static_cast<uint8>(WangTileIndex) : NO_ZONE;
+}
+
+int32 APackedZoneLayout::GetWangTileIndex(int32 GridX, int32 GridY) const
+{
+	const int RegionX = GridX - RegionMin.X;
+	const int RegionY = GridY - RegionMin.Y;
+
+	if (RegionX < 0 || RegionY < 0 || RegionX >= RegionSize.X || RegionY >= RegionSize.Y)
+	{
+		return INDEX_NONE;
+	}
+
+	const uint8 WangTileIndex = WangTileIndices[RegionY * RegionSize.X + RegionX];
+	return WangTileIndex == NO_ZONE ? INDEX_NONE : WangTileIndex;
+}
+
+TSubclassOf<AZone> APackedZoneLayout::GetZoneClass(int32 GridX, int32 GridY) const
+{
+	const int32 WangTileIndex = GetWangTileIndex(GridX, GridY);
+	return ZoneClasses.IsValidIndex(WangTileIndex) ? ZoneClasses[WangTileIndex] : nullptr;
+}
+
+FIntPoint APackedZoneLayout::GetCellAtLocation(const FVector& WorldLocation) const
+{
+	const FVector RelativeLocation = GetActorTransform().InverseTransformPosition(WorldLocation) - FirstZoneLocation;
+
+	// Sanity check:
+	if (CellStep.X == 0.0f || CellStep.Y == 0.0f)
+	{
+		return FIntPoint(INDEX_NONE, INDEX_NONE);
+	}
+
+	return FIntPoint(FMath::RoundToInt(RelativeLocation.X / CellStep.X), FMath::RoundToInt(RelativeLocation.Y / CellStep.Y));
+}
+
+FTransform APackedZoneLayout::GetZoneTransform(int GridX, int GridY) const
+{
+	return GetZoneRelativeTransform(GridX, GridY) * GetActorTransform();
+}
+
+FTransform APackedZoneLayout::GetZoneRelativeTransform(int GridX, int GridY) const
+{
+	const FVector ZoneLocation = FirstZoneLocation + FVector(GridX * CellStep.X, GridY * CellStep.Y, 0.0f);
+	return FTransform(FQuat::Identity, ZoneLocation, ZoneScale);
+}
+
+void APackedZoneLayout::RealiseZoneMeshes()
+{
+	for (UHierarchicalInstancedStaticMeshComponent* ZoneMeshComponent : ZoneMeshComponents)
+	{
+		if (ZoneMeshComponent)
+		{
+			ZoneMeshComponent->DestroyComponent();
+		}
+	}
+
+	ZoneMeshComponents.Empty();
+
+	// The objects of each Zone Blueprint are only found once:
+	TArray<TArray<FZoneObjectTemplate>> ZoneObjectTemplates;
+	ZoneObjectTemplates.SetNum(ZoneClasses.Num());
+
+	for (int WangTileIndex = 0; WangTileIndex < ZoneClasses.Num(); WangTileIndex++)
+	{
+		AZone::GetZoneObjectTemplates(*ZoneClasses[WangTileIndex], ZoneObjectTemplates[WangTileIndex]);
+	}
+
+	// Group the (relative) transforms of every Zone object by what it draws and collides as:
+	TMap<FZoneMeshMergeKey, TArray<FTransform>> MergeGroups;
+
+	for (int RegionY = 0; RegionY < RegionSize.Y; RegionY++)
+	{
+		for (int RegionX = 0; RegionX < RegionSize.X; RegionX++)
+		{
+			const uint8 WangTileIndex = WangTileIndices[RegionY * RegionSize.X + RegionX];
+
+			if (!ZoneObjectTemplates.IsValidIndex(WangTileIndex))
+			{
+				continue;
+			}
+
+			const FTransform ZoneTransform = GetZoneRelativeTransform(RegionMin.X + RegionX, RegionMin.Y + RegionY);
+
+			for (const FZoneObjectTemplate& ZoneObjectTemplate : ZoneObjectTemplates[WangTileIndex])
+			{
+				if (ZoneObjectTemplate.Template->GetStaticMesh() && ZoneObjectTemplate.Template->IsVisible())
+				{
+					MergeGroups.FindOrAdd(FZoneMeshMergeKey(ZoneObjectTemplate.Template, true)).Add(
+						ZoneObjectTemplate.ZoneObjectTransform * ZoneTransform);
+				}
+			}
+		}
+	}
+
+	// Then add one instanced component for each group:
+	for (const TPair<FZoneMeshMergeKey, TArray<FTransform>>& MergeGroup : MergeGroups)
+	{
+		UHierarchicalInstancedStaticMeshComponent* ZoneMeshComponent =
+			NewObject<UHierarchicalInstancedStaticMeshComponent>(this, NAME_None, RF_Transactional);
+		ZoneMeshComponent->SetupAttachment(RootComponent);
+		MergeGroup.Key.ApplyTo(ZoneMeshComponent);
+
+		// Don't rebuild the tree for every instance added:
+		ZoneMeshComponent->bAutoRebuildTreeOnInstanceChanges = false;
+		ZoneMeshComponent->PerInstanceSMData.Reserve(MergeGroup.Value.Num());
+
+		for (const FTransform& InstanceTransform : MergeGroup.Value)
+		{
+			ZoneMeshComponent->AddInstance(InstanceTransform);
+		}
+
+		ZoneMeshComponent->bAutoRebuildTreeOnInstanceChanges = true;
+		ZoneMeshComponent->RegisterComponent();
+		ZoneMeshComponent->BuildTreeIfOutdated(false, true);
+
+		// So that it is saved with this actor:
+		AddInstanceComponent(ZoneMeshComponent);
+		ZoneMeshComponents.Add(ZoneMeshComponent);
+	}
+}
@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WangTileAliasTable.h"
+#include "WangTileMask.h"
+
+void FWangTileAliasTable::Build(const uint64_t* Mask, int WordCount, const float* Weights,
+	std::vector<FWangTileAliasEntry>& OutEntries)
+{
+	const std::size_t TableStart = OutEntries.size();
+
+	double TotalWeight = 0.0;
+	for (int WordIndex = 0; WordIndex < WordCount; WordIndex++)
+	{
+		for (int Bit = 0; Bit < 64; Bit++)
+		{
+			if ((Mask[WordIndex] >> Bit) & 1)
+			{
+				const int Tile = WordIndex * 64 + Bit;
+
+				FWangTileAliasEntry Entry;
+				Entry.Tile = static_cast<uint16_t>(Tile);
+				Entry.AliasTile = Entry.Tile;
+				OutEntries.push_back(Entry);
+
+				TotalWeight += Weights[Tile] > 0.0f ? Weights[Tile] : 0.0f;
+			}
+		}
+	}
+
+	const int EntryCount = static_cast<int>(OutEntries.size() - TableStart);
+	FWangTileAliasEntry* Entries = EntryCount > 0 ? &OutEntries[TableStart] : nullptr;
+
+	// Sanity check (equal weights keep every column, as does a set with no weight at all):
+	if (EntryCount == 0 || TotalWeight <= 0.0)
+	{
+		return;
+	}
+
+	// Scale the weights so that they average 1, then pair each column below 1 with one above it:
+	std::vector<double> ScaledWeights(EntryCount);
+	std::vector<int> SmallColumns;
+	std::vector<int> LargeColumns;
+
+	for (int Column = 0; Column < EntryCount; Column++)
+	{
+		const float Weight = Weights[Entries[Column].Tile];
+		ScaledWeights[Column] = (Weight > 0.0f ? Weight : 0.0) * EntryCount / TotalWeight;
+		(ScaledWeights[Column] < 1.0 ? SmallColumns : LargeColumns).push_back(Column);
+	}
+
+	while (!SmallColumns.empty() && !LargeColumns.empty())
+	{
+		const int SmallColumn = SmallColumns.back();
+		const int LargeColumn = LargeColumns.back();
+		SmallColumns.pop_back();
+
+		Entries[SmallColumn].Threshold = static_cast<uint32_t>(ScaledWeights[SmallColumn] * 4294967296.0);
+		Entries[SmallColumn].AliasTile = Entries[LargeColumn].Tile;
+
+		// The large column gives up what the small column lacked:
+		ScaledWeights[LargeColumn] -= 1.0 - ScaledWeights[SmallColumn];
+		if (ScaledWeights[LargeColumn] < 1.0)
+		{
+			LargeColumns.pop_back();
+			SmallColumns.push_back(LargeColumn);
+		}
+	}
+
+	// Whatever is left (by rounding, if it is in SmallColumns) keeps its own tile:
+	for (int Column : SmallColumns)
+	{
+		Entries[Column].Threshold = FWangTileAliasEntry::ALWAYS_KEEP;
+		Entries[Column].AliasTile = Entries[Column].Tile;
+	}
+}
@@ -0,0 +1,227 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WangTileBalanceMap.h"
+#include <algorithm>
+#include <cmath>
+
+static const int COEFFICIENT_COUNT = static_cast<int>(EWangTileCoefficient::Count);
+
+/** The first row (or column) of the band of Count rows (or columns) that worker WorkerIndex of WorkerCount takes. */
+static int GetBalanceWorkerBandStart(int Count, int WorkerIndex, int WorkerCount)
+{
+	return static_cast<int>(static_cast<int64_t>(Count) * WorkerIndex / WorkerCount);
+}
+
+void FWangTileBalanceMap::Build(const std::vector<FWangTileDefinition>& TileSet, const FWangTileGrid& Grid,
+	const FWangTileSolverSettings& Settings)
+{
+	Width = Grid.GetWidth();
+	Height = Grid.GetHeight();
+
+	// Each Coefficient only depends on the tile and where it is placed, so they are found once:
+	const int TileCount = static_cast<int>(TileSet.size());
+	const int PlacementCount = static_cast<int>(EWangTilePlacement::Count);
+	std::vector<float> TileCoefficients[COEFFICIENT_COUNT];
+
+	for (int CoefficientIndex = 0; CoefficientIndex < COEFFICIENT_COUNT; CoefficientIndex++)
+	{
+		TileCoefficients[CoefficientIndex].resize(PlacementCount * TileCount);
+		Coefficients[CoefficientIndex].assign(static_cast<std::size_t>(Width) * Height, 0.0f);
+		SummedAreas[CoefficientIndex].assign(static_cast<std::size_t>(Width + 1) * (Height + 1), 0.0);
+	}
+
+	for (int PlacementIndex = 0; PlacementIndex < PlacementCount; PlacementIndex++)
+	{
+		const EWangTilePlacement Placement = static_cast<EWangTilePlacement>(PlacementIndex);
+
+		for (int Tile = 0; Tile < TileCount; Tile++)
+		{
+			const int TileCoefficientIndex = PlacementIndex * TileCount + Tile;
+
+			TileCoefficients[static_cast<int>(EWangTileCoefficient::Defensiveness)][TileCoefficientIndex] =
+				FWangTileCoefficients::FindDefensivenessCoefficient(TileSet[Tile],
+				FWangTileCoefficients::GetAdjacentZones(Placement));
+			TileCoefficients[static_cast<int>(EWangTileCoefficient::Flanking)][TileCoefficientIndex] =
+				FWangTileSolver::GetFlankingCoefficient(Placement);
+			TileCoefficients[static_cast<int>(EWangTileCoefficient::Dispersion)][TileCoefficientIndex] =
+				TileSet[Tile].DispersionCoefficient;
+		}
+	}
+
+	if (IsEmpty())
+	{
+		return;
+	}
+
+	// First each row's Coefficients (the mean of each column of floors), and their running sums along the
+	// row (a band of rows for each worker)...
+	const int RowWorkerCount = std::max(1, std::min(Settings.ThreadCount, Height));
+
+	FWangTileSolver::RunWorkers(Settings, RowWorkerCount, [&](int WorkerIndex)
+	{
+		const int MaxY = GetBalanceWorkerBandStart(Height, WorkerIndex + 1, RowWorkerCount);
+
+		for (int Y = GetBalanceWorkerBandStart(Height, WorkerIndex, RowWorkerCount); Y < MaxY; Y++)
+		{
+			double RowSums[COEFFICIENT_COUNT] = { 0.0, 0.0, 0.0 };
+
+			for (int X = 0; X < Width; X++)
+			{
+				for (int CoefficientIndex = 0; CoefficientIndex < COEFFICIENT_COUNT; CoefficientIndex++)
+				{
+					float Coefficient = 0.0f;
+
+					for (int Z = 0; Z < Grid.GetDepth(); Z++)
+					{
+						const FWangTileCell& Cell = Grid.At(X, Y, Z);
+						const int TileCoefficientIndex = static_cast<int>(Cell.Placement) * TileCount + Cell.TileId;
+
+						// (A cell with no tile counts as 0):
+						Coefficient += Cell.TileId < TileCount ? TileCoefficients[CoefficientIndex][TileCoefficientIndex] : 0.0f;
+					}
+
+					Coefficient = Grid.GetDepth() > 1 ? Coefficient / Grid.GetDepth() : Coefficient;
+
+					Coefficients[CoefficientIndex][Grid.GetIndex(X, Y)] = Coefficient;
+					RowSums[CoefficientIndex] += Coefficient;
+					SummedAreas[CoefficientIndex][static_cast<std::size_t>(Y + 1) * (Width + 1) + X + 1] =
+						RowSums[CoefficientIndex];
+				}
+			}
+		}
+	});
+
+	// ...then down each column (a band of columns for each worker, still a row at a time for the cache):
+	const int ColumnWorkerCount = std::max(1, std::min(Settings.ThreadCount, Width));
+
+	FWangTileSolver::RunWorkers(Settings, ColumnWorkerCount, [&](int WorkerIndex)
+	{
+		const int MinX = 1 + GetBalanceWorkerBandStart(Width, WorkerIndex, ColumnWorkerCount);
+		const int MaxX = 1 + GetBalanceWorkerBandStart(Width, WorkerIndex + 1, ColumnWorkerCount);
+
+		for (int CoefficientIndex = 0; CoefficientIndex < COEFFICIENT_COUNT; CoefficientIndex++)
+		{
+			for (int Y = 2; Y <= Height; Y++)
+			{
+				double* SummedAreaRow = &SummedAreas[CoefficientIndex][static_cast<std::size_t>(Y) * (Width + 1)];
+				const double* SouthSummedAreaRow = SummedAreaRow - (Width + 1);
+
+				for (int X = MinX; X < MaxX; X++)
+				{
+					SummedAreaRow[X] += SouthSummedAreaRow[X];
+				}
+			}
+		}
+	});
+}
+
+FWangTileRegionBalance FWangTileBalanceMap::GetRegionBalance(const FWangTileRect& Rect) const
+{
+	FWangTileRegionBalance RegionBalance;
+
+	const FWangTileRect ClippedRect(std::max(Rect.MinX, 0), std::max(Rect.MinY, 0), std::min(Rect.MaxX, Width),
+		std::min(Rect.MaxY, Height));
+
+	if (ClippedRect.IsEmpty())
+	{
+		return RegionBalance;
+	}
+
+	RegionBalance.CellCount = (ClippedRect.MaxX - ClippedRect.MinX) * (ClippedRect.MaxY - ClippedRect.MinY);
+
+	for (int CoefficientIndex = 0; CoefficientIndex < COEFFICIENT_COUNT; CoefficientIndex++)
+	{
+		RegionBalance.Sums[CoefficientIndex] = GetSummedArea(CoefficientIndex, ClippedRect.MaxX, ClippedRect.MaxY)
+			- GetSummedArea(CoefficientIndex, ClippedRect.MinX, ClippedRect.MaxY)
+			- GetSummedArea(CoefficientIndex, ClippedRect.MaxX, ClippedRect.MinY)
+			+ GetSummedArea(CoefficientIndex, ClippedRect.MinX, ClippedRect.MinY);
+	}
+
+	return RegionBalance;
+}
+
+FWangTileBalanceReport FWangTileBalanceMap::ComputeReport(const FWangTileSolverSettings& Settings) const
+{
+	FWangTileBalanceReport Report;
+
+	if (IsEmpty())
+	{
+		return Report;
+	}
+
+	// The sums come straight from the tables:
+	const int HalfHeight = Height / 2;
+	Report.Level = GetRegionBalance(FWangTileRect(0, 0, Width, Height));
+	Report.SouthHalf = GetRegionBalance(FWangTileRect(0, 0, Width, HalfHeight));
+	Report.NorthHalf = GetRegionBalance(FWangTileRect(0, Height - HalfHeight, Width, Height));
+
+	if (Report.SouthHalf.CellCount > 0)
+	{
+		const int DefensivenessIndex = static_cast<int>(EWangTileCoefficient::Defensiveness);
+		const int DispersionIndex = static_cast<int>(EWangTileCoefficient::Dispersion);
+
+		Report.Score.DefensivenessImbalance = static_cast<float>(std::abs(Report.SouthHalf.Sums[DefensivenessIndex] -
+			Report.NorthHalf.Sums[DefensivenessIndex]) / Report.SouthHalf.CellCount);
+		Report.Score.DispersionImbalance = static_cast<float>(std::abs(Report.SouthHalf.Sums[DispersionIndex] -
+			Report.NorthHalf.Sums[DispersionIndex]) / Report.SouthHalf.CellCount);
+	}
+
+	// The spread needs every cell, so each worker reduces a band of rows (about the mean, for precision):
+	struct FBalanceSpread
+	{
+		double SquaredDeviationSums[COEFFICIENT_COUNT] = { 0.0, 0.0, 0.0 };
+		float Minimums[COEFFICIENT_COUNT];
+		float Maximums[COEFFICIENT_COUNT];
+	};
+
+	const int WorkerCount = std::max(1, std::min(Settings.ThreadCount, Height));
+	std::vector<FBalanceSpread> WorkerSpreads(WorkerCount);
+
+	FWangTileSolver::RunWorkers(Settings, WorkerCount, [&](int WorkerIndex)
+	{
+		FBalanceSpread& Spread = WorkerSpreads[WorkerIndex];
+		const std::size_t MinIndex = static_cast<std::size_t>(GetBalanceWorkerBandStart(Height, WorkerIndex, WorkerCount)) * Width;
+		const std::size_t MaxIndex = static_cast<std::size_t>(GetBalanceWorkerBandStart(Height, WorkerIndex + 1, WorkerCount)) * Width;
+
+		for (int CoefficientIndex = 0; CoefficientIndex < COEFFICIENT_COUNT; CoefficientIndex++)
+		{
+			const float* CellCoefficients = Coefficients[CoefficientIndex].data();
+			const double Mean = Report.Level.Sums[CoefficientIndex] / Report.Level.CellCount;
+			double SquaredDeviationSum = 0.0;
+			float Minimum = CellCoefficients[MinIndex];
+			float Maximum = CellCoefficients[MinIndex];
+
+			for (std::size_t CellIndex = MinIndex; CellIndex < MaxIndex; CellIndex++)
+			{
+				const double Deviation = CellCoefficients[CellIndex] - Mean;
+				SquaredDeviationSum += Deviation * Deviation;
+				Minimum = std::min(Minimum, CellCoefficients[CellIndex]);
+				Maximum = std::max(Maximum, CellCoefficients[CellIndex]);
+			}
+
+			Spread.SquaredDeviationSums[CoefficientIndex] = SquaredDeviationSum;
+			Spread.Minimums[CoefficientIndex] = Minimum;
+			Spread.Maximums[CoefficientIndex] = Maximum;
+		}
+	});
+
+	// Then the workers' results, in order (so the report is the same however many threads there are, to within rounding):
+	for (int CoefficientIndex = 0; CoefficientIndex < COEFFICIENT_COUNT; CoefficientIndex++)
+	{
+		double SquaredDeviationSum = 0.0;
+		Report.Minimums[CoefficientIndex] = WorkerSpreads[0].Minimums[CoefficientIndex];
+		Report.Maximums[CoefficientIndex] = WorkerSpreads[0].Maximums[CoefficientIndex];
+
+		for (const FBalanceSpread& Spread : WorkerSpreads)
+		{
+			SquaredDeviationSum += Spread.SquaredDeviationSums[CoefficientIndex];
+			Report.Minimums[CoefficientIndex] = std::min(Report.Minimums[CoefficientIndex], Spread.Minimums[CoefficientIndex]);
+			Report.Maximums[CoefficientIndex] = std::max(Report.Maximums[CoefficientIndex], Spread.Maximums[CoefficientIndex]);
+		}
+
+		Report.StandardDeviations[CoefficientIndex] = static_cast<float>(std::sqrt(SquaredDeviationSum /
+			Report.Level.CellCount));
+	}
+
+	return Report;
+}
@@ -0,0 +1,303 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WangTileConnectivity.h"
+#include <algorithm>
+#include <numeric>
+
+static const int CONNECTIVITY_SIDE_COUNT = static_cast<int>(EWangTileSide::Count);
+static const uint8_t ALL_CONNECTIVITY_SIDES = (1 << CONNECTIVITY_SIDE_COUNT) - 1;
+static const int8_t NO_SIDE_ROOT = -1;
+
+/** For the bit of a side (in FWangTileFootprint::SideLinks, and FWangTileConnectivity::OpenSides). */
+static uint8_t GetConnectivitySideBit(EWangTileSide Side)
+{
+	return static_cast<uint8_t>(1 << static_cast<int>(Side));
+}
+
+FWangTileConnectivity::FWangTileConnectivity(const std::vector<FWangTileDefinition>& TileSet)
+{
+	OpenSides.resize(TileSet.size());
+	VerticalLinks.resize(TileSet.size());
+	SideLinks.resize(TileSet.size() * CONNECTIVITY_SIDE_COUNT);
+	SideRoots.resize(TileSet.size() * CONNECTIVITY_SIDE_COUNT);
+
+	for (std::size_t Tile = 0; Tile < TileSet.size(); Tile++)
+	{
+		const FWangTileFootprint& Footprint = TileSet[Tile].Footprint;
+		OpenSides[Tile] = Footprint.IsMeasured() ? 0 : ALL_CONNECTIVITY_SIDES;
+		VerticalLinks[Tile] = TileSet[Tile].VerticalLinks;
+
+		for (int SideIndex = 0; SideIndex < CONNECTIVITY_SIDE_COUNT; SideIndex++)
+		{
+			uint8_t& TileSideLinks = SideLinks[Tile * CONNECTIVITY_SIDE_COUNT + SideIndex];
+			TileSideLinks = Footprint.IsMeasured() ? Footprint.SideLinks[SideIndex] :
+				static_cast<uint8_t>(ALL_CONNECTIVITY_SIDES & ~(1 << SideIndex));
+
+			// (A side is only open if it leads somewhere):
+			if (TileSideLinks != 0)
+			{
+				OpenSides[Tile] |= 1 << SideIndex;
+			}
+		}
+
+		// Each open side's root is the first side it leads to (or itself, if that comes first):
+		for (int SideIndex = 0; SideIndex < CONNECTIVITY_SIDE_COUNT; SideIndex++)
+		{
+			int8_t& RootSideIndex = SideRoots[Tile * CONNECTIVITY_SIDE_COUNT + SideIndex];
+			RootSideIndex = NO_SIDE_ROOT;
+
+			if (!(OpenSides[Tile] & (1 << SideIndex)))
+			{
+				continue;
+			}
+
+			const uint8_t LinkedSides = SideLinks[Tile * CONNECTIVITY_SIDE_COUNT + SideIndex] | (1 << SideIndex);
+			for (int OtherSideIndex = 0; RootSideIndex == NO_SIDE_ROOT; OtherSideIndex++)
+			{
+				if (LinkedSides & (1 << OtherSideIndex))
+				{
+					RootSideIndex = static_cast<int8_t>(OtherSideIndex);
+				}
+			}
+		}
+	}
+}
+
+const FWangTileConnectivityReport& FWangTileConnectivity::Check(const FWangTileGrid& Grid)
+{
+	Report = FWangTileConnectivityReport();
+
+	const int Width = Grid.GetWidth();
+	const int Height = Grid.GetHeight();
+	const int Depth = Grid.GetDepth();
+	const int CellCount = Grid.GetCellCount();
+	const int TileCount = static_cast<int>(OpenSides.size());
+
+	Parents.assign(static_cast<std::size_t>(CellCount) * CONNECTIVITY_SIDE_COUNT, -1);
+
+	auto GetOpenSides = [&](int CellIndex) -> uint8_t
+	{
+		const int Tile = Grid[CellIndex].TileId;
+		return Tile < TileCount ? OpenSides[Tile] : 0;
+	};
+
+	auto GetVerticalLinks = [&](int CellIndex) -> uint8_t
+	{
+		const int Tile = Grid[CellIndex].TileId;
+		return Tile < TileCount ? VerticalLinks[Tile] : 0;
+	};
+
+	const uint8_t NorthBit = GetConnectivitySideBit(EWangTileSide::North);
+	const uint8_t EastBit = GetConnectivitySideBit(EWangTileSide::East);
+	const uint8_t SouthBit = GetConnectivitySideBit(EWangTileSide::South);
+	const uint8_t WestBit = GetConnectivitySideBit(EWangTileSide::West);
+
+	// A stair or ramp joins the part of its tile on its first open side to the same part of the tile
+	// it leads to (a tile with no open side leads nowhere):
+	auto GetStairNode = [&](int CellIndex) -> int
+	{
+		const uint8_t CellOpenSides = GetOpenSides(CellIndex);
+		for (int SideIndex = 0; SideIndex < CONNECTIVITY_SIDE_COUNT; SideIndex++)
+		{
+			if (CellOpenSides & (1 << SideIndex))
+			{
+				return CellIndex * CONNECTIVITY_SIDE_COUNT + SideIndex;
+			}
+		}
+
+		return -1;
+	};
+
+	// Join the sides within each tile (while its nodes are still on their own, so without finding
+	// their roots), then each tile to the tiles to its west and south, and below it:
+	int WalkableCellCount = 0;
+
+	for (int Z = 0; Z < Depth; Z++)
+	{
+		for (int Y = 0; Y < Height; Y++)
+		{
+			for (int X = 0; X < Width; X++)
+			{
+				const int CellIndex = Grid.GetIndex(X, Y, Z);
+				const uint8_t CellOpenSides = GetOpenSides(CellIndex);
+
+				if (CellOpenSides == 0)
+				{
+					continue;
+				}
+
+				WalkableCellCount++;
+
+				const int FirstNode = CellIndex * CONNECTIVITY_SIDE_COUNT;
+				const int8_t* CellSideRoots = &SideRoots[Grid[CellIndex].TileId * CONNECTIVITY_SIDE_COUNT];
+
+				for (int SideIndex = 0; SideIndex < CONNECTIVITY_SIDE_COUNT; SideIndex++)
+				{
+					const int RootSideIndex = CellSideRoots[SideIndex];
+					if (RootSideIndex != SideIndex && RootSideIndex != NO_SIDE_ROOT)
+					{
+						Parents[FirstNode + SideIndex] = FirstNode + RootSideIndex;
+						Parents[FirstNode + RootSideIndex]--;
+					}
+				}
+
+				if (X > 0 && (CellOpenSides & WestBit) && (GetOpenSides(CellIndex - 1) & EastBit))
+				{
+					JoinNodes(FirstNode + static_cast<int>(EWangTileSide::West),
+						(CellIndex - 1) * CONNECTIVITY_SIDE_COUNT + static_cast<int>(EWangTileSide::East));
+				}
+
+				if (Y > 0 && (CellOpenSides & SouthBit) && (GetOpenSides(CellIndex - Width) & NorthBit))
+				{
+					JoinNodes(FirstNode + static_cast<int>(EWangTileSide::South),
+						(CellIndex - Width) * CONNECTIVITY_SIDE_COUNT + static_cast<int>(EWangTileSide::North));
+				}
+
+				if (Z > 0 && (GetVerticalLinks(CellIndex) & FWangTileDefinition::VERTICAL_LINK_DOWN))
+				{
+					const int BelowIndex = Grid.GetBelowIndex(CellIndex);
+					const int BelowStairNode = GetStairNode(BelowIndex);
+
+					if (BelowStairNode != -1 && (GetVerticalLinks(BelowIndex) & FWangTileDefinition::VERTICAL_LINK_UP))
+					{
+						JoinNodes(GetStairNode(CellIndex), BelowStairNode);
+					}
+				}
+			}
+		}
+	}
+
+	// Each region has one root (among the open sides), so they can be counted without finding any...
+	for (int CellIndex = 0; CellIndex < CellCount; CellIndex++)
+	{
+		const uint8_t CellOpenSides = GetOpenSides(CellIndex);
+
+		for (int SideIndex = 0; SideIndex < CONNECTIVITY_SIDE_COUNT; SideIndex++)
+		{
+			if ((CellOpenSides & (1 << SideIndex)) && Parents[CellIndex * CONNECTIVITY_SIDE_COUNT + SideIndex] < 0)
+			{
+				Report.ComponentCount++;
+			}
+		}
+	}
+
+	if (Report.IsConnected())
+	{
+		Report.MainComponentCellCount = WalkableCellCount;
+		return Report;
+	}
+
+	// ...and only a layout that is not connected needs its regions (a tile split in two can be in two), and their
+	// tiles (bounded on the floor plan, whichever floors they are on):
+	ComponentIndices.assign(Parents.size(), -1);
+	ComponentCellCounts.clear();
+	ComponentBounds.clear();
+
+	for (int CellIndex = 0; CellIndex < CellCount; CellIndex++)
+	{
+		const int X = Grid.GetX(CellIndex);
+		const int Y = Grid.GetY(CellIndex);
+		const uint8_t CellOpenSides = GetOpenSides(CellIndex);
+		int CellComponents[CONNECTIVITY_SIDE_COUNT];
+		int CellComponentCount = 0;
+
+		for (int SideIndex = 0; SideIndex < CONNECTIVITY_SIDE_COUNT; SideIndex++)
+		{
+			if (!(CellOpenSides & (1 << SideIndex)))
+			{
+				continue;
+			}
+
+			int& ComponentIndex = ComponentIndices[FindRoot(CellIndex * CONNECTIVITY_SIDE_COUNT + SideIndex)];
+			if (ComponentIndex == -1)
+			{
+				ComponentIndex = static_cast<int>(ComponentCellCounts.size());
+				ComponentCellCounts.push_back(0);
+				ComponentBounds.push_back(FWangTileRect(X, Y, X + 1, Y + 1));
+			}
+
+			if (std::find(CellComponents, CellComponents + CellComponentCount, ComponentIndex) ==
+				CellComponents + CellComponentCount)
+			{
+				CellComponents[CellComponentCount++] = ComponentIndex;
+				ComponentCellCounts[ComponentIndex]++;
+
+				FWangTileRect& Bounds = ComponentBounds[ComponentIndex];
+				Bounds = FWangTileRect(std::min(Bounds.MinX, X), std::min(Bounds.MinY, Y),
+					std::max(Bounds.MaxX, X + 1), std::max(Bounds.MaxY, Y + 1));
+			}
+		}
+	}
+
+	// The largest region (the first found, of those the same size) is the one the others are cut off from:
+	const int MainComponent = static_cast<int>(std::max_element(ComponentCellCounts.begin(), ComponentCellCounts.end()) -
+		ComponentCellCounts.begin());
+	Report.MainComponentCellCount = ComponentCellCounts[MainComponent];
+
+	for (int CellIndex = 0; CellIndex < CellCount; CellIndex++)
+	{
+		const uint8_t CellOpenSides = GetOpenSides(CellIndex);
+
+		for (int SideIndex = 0; SideIndex < CONNECTIVITY_SIDE_COUNT; SideIndex++)
+		{
+			if ((CellOpenSides & (1 << SideIndex)) &&
+				ComponentIndices[FindRoot(CellIndex * CONNECTIVITY_SIDE_COUNT + SideIndex)] != MainComponent)
+			{
+				Report.CutOffCells.push_back(CellIndex);
+				break;
+			}
+		}
+	}
+
+	// Smallest first (and in the order found, of those the same size):
+	std::vector<int> CutOffComponents(ComponentCellCounts.size());
+	std::iota(CutOffComponents.begin(), CutOffComponents.end(), 0);
+	CutOffComponents.erase(CutOffComponents.begin() + MainComponent);
+	std::stable_sort(CutOffComponents.begin(), CutOffComponents.end(), [this](int ComponentA, int ComponentB)
+	{
+		return ComponentCellCounts[ComponentA] < ComponentCellCounts[ComponentB];
+	});
+
+	for (int CutOffComponent : CutOffComponents)
+	{
+		Report.CutOffBounds.push_back(ComponentBounds[CutOffComponent]);
+	}
+
+	return Report;
+}
+
+int FWangTileConnectivity::FindRoot(int Node)
+{
+	while (Parents[Node] >= 0)
+	{
+		const int Parent = Parents[Node];
+		if (Parents[Parent] >= 0)
+		{
+			Parents[Node] = Parents[Parent];
+		}
+
+		Node = Parent;
+	}
+
+	return Node;
+}
+
+void FWangTileConnectivity::JoinNodes(int NodeA, int NodeB)
+{
+	int RootA = FindRoot(NodeA);
+	int RootB = FindRoot(NodeB);
+
+	if (RootA == RootB)
+	{
+		return;
+	}
+
+	// (The sizes are negative):
+	if (Parents[RootA] > Parents[RootB])
+	{
+		std::swap(RootA, RootB);
+	}
+
+	Parents[RootA] += Parents[RootB];
+	Parents[RootB] = RootA;
+}
@@ -0,0 +1,627 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WangTileConstraintPropagator.h"
+#include "WangTileMask.h"
+#include "WangTileSolver.h"
+#include <algorithm>
+
+FWangTileConstraintPropagator::FWangTileConstraintPropagator(int InTileCount, int InMaskWordCount,
+	const std::vector<uint64_t>& InEastNeighbourMasks, const std::vector<uint64_t>& InNorthNeighbourMasks,
+	const std::vector<uint8_t>& InTileVerticalLinks, const std::vector<float>& InSelectionWeights)
+	: TileCount(InTileCount)
+	, MaskWordCount(InMaskWordCount)
+	, EastNeighbourMasks(InEastNeighbourMasks)
+	, NorthNeighbourMasks(InNorthNeighbourMasks)
+	, SelectionWeights(InSelectionWeights)
+	, Grid(nullptr)
+	, Width(0)
+	, Height(0)
+	, Depth(0)
+{
+	// For a cell to keep a tile, the cells to its west and south need a tile that allows it,
+	// so each mask is transposed (for each placement of the tile to the west or south):
+	WestNeighbourMasks.assign(EastNeighbourMasks.size(), 0);
+	SouthNeighbourMasks.assign(NorthNeighbourMasks.size(), 0);
+
+	const int PlacedTileCount = static_cast<int>(EastNeighbourMasks.size()) / MaskWordCount;
+
+	for (int PlacedTileIndex = 0; PlacedTileIndex < PlacedTileCount; PlacedTileIndex++)
+	{
+		const int PlacementStart = PlacedTileIndex - PlacedTileIndex % TileCount;
+		const int PlacedTile = PlacedTileIndex % TileCount;
+
+		FWangTileMask::ForEachTile(&EastNeighbourMasks[PlacedTileIndex * MaskWordCount], MaskWordCount,
+			[&](int EastTile)
+		{
+			FWangTileMask::AddTile(&WestNeighbourMasks[(PlacementStart + EastTile) * MaskWordCount], PlacedTile);
+		});
+
+		FWangTileMask::ForEachTile(&NorthNeighbourMasks[PlacedTileIndex * MaskWordCount], MaskWordCount,
+			[&](int NorthTile)
+		{
+			FWangTileMask::AddTile(&SouthNeighbourMasks[(PlacementStart + NorthTile) * MaskWordCount], PlacedTile);
+		});
+	}
+
+	// The floors are joined by the tiles' links alone (whichever way the tiles are placed):
+	UpLinkedTiles.assign(MaskWordCount, 0);
+	DownLinkedTiles.assign(MaskWordCount, 0);
+	AllTiles.assign(MaskWordCount, 0);
+	VerticalSupport.assign(MaskWordCount, 0);
+
+	for (int Tile = 0; Tile < TileCount; Tile++)
+	{
+		FWangTileMask::AddTile(AllTiles.data(), Tile);
+
+		if (InTileVerticalLinks[Tile] & FWangTileDefinition::VERTICAL_LINK_UP)
+		{
+			FWangTileMask::AddTile(UpLinkedTiles.data(), Tile);
+		}
+
+		if (InTileVerticalLinks[Tile] & FWangTileDefinition::VERTICAL_LINK_DOWN)
+		{
+			FWangTileMask::AddTile(DownLinkedTiles.data(), Tile);
+		}
+	}
+
+	// For whether a cell that could hold any tile rules out any tile next to it:
+	IsEveryTileSupported = true;
+
+	const std::vector<uint64_t>* AllNeighbourMasks[] = { &EastNeighbourMasks, &NorthNeighbourMasks,
+		&WestNeighbourMasks, &SouthNeighbourMasks };
+
+	for (const std::vector<uint64_t>* NeighbourMasks : AllNeighbourMasks)
+	{
+		for (int PlacementStart = 0; PlacementStart < PlacedTileCount; PlacementStart += TileCount)
+		{
+			std::vector<uint64_t> Support(MaskWordCount, 0);
+			for (int Tile = 0; Tile < TileCount; Tile++)
+			{
+				for (int WordIndex = 0; WordIndex < MaskWordCount; WordIndex++)
+				{
+					Support[WordIndex] |= (*NeighbourMasks)[(PlacementStart + Tile) * MaskWordCount + WordIndex];
+				}
+			}
+
+			IsEveryTileSupported &= FWangTileMask::CountTiles(Support.data(), MaskWordCount) == TileCount;
+		}
+	}
+}
+
+bool FWangTileConstraintPropagator::Solve(const FWangTileSolverSettings& Settings, FWangTileGrid& InGrid,
+	FWangTileSolverStats& OutStats)
+{
+	Grid = &InGrid;
+	Width = InGrid.GetWidth();
+	Height = InGrid.GetHeight();
+	Depth = InGrid.GetDepth();
+
+	// Sanity check (the grid has no interior to fill):
+	if (Width < 3 || Height < 3)
+	{
+		return true;
+	}
+
+	const int CellCount = InGrid.GetCellCount();
+	Domains.assign(static_cast<std::size_t>(CellCount) * MaskWordCount, 0);
+	IsInWorklist.assign(CellCount, 0);
+	Worklist.clear();
+	TrailCells.clear();
+	TrailDomains.clear();
+	Placements.clear();
+	SupportCacheKeys.assign((static_cast<std::size_t>(1) << SUPPORT_CACHE_BITS) * (MaskWordCount + 1), 0);
+	SupportCacheValues.assign((static_cast<std::size_t>(1) << SUPPORT_CACHE_BITS) * MaskWordCount, 0);
+
+	// The boundary tiles are already placed, and an interior cell could hold any tile its floor allows
+	// to begin with (so it only needs propagating if that rules out a tile next to it, or on another floor):
+	for (int CellIndex = 0; CellIndex < CellCount; CellIndex++)
+	{
+		uint64_t* Domain = GetDomain(CellIndex);
+		const bool IsInterior = InGrid.IsInterior(CellIndex);
+
+		if (IsInterior)
+		{
+			GetFloorTiles(InGrid.GetZ(CellIndex), Domain);
+		}
+		else
+		{
+			FWangTileMask::AddTile(Domain, InGrid[CellIndex].TileId);
+		}
+
+		if (!IsInterior || !IsEveryTileSupported || Depth > 1)
+		{
+			Worklist.push_back(CellIndex);
+			IsInWorklist[CellIndex] = 1;
+		}
+	}
+
+	// A cell that no tile can fill (whatever is placed elsewhere) is left for PickScanlineTile():
+	Propagate(false);
+	TrimTrail(0);
+
+	const int InteriorWidth = Width - 2;
+	const int FloorInteriorCount = InteriorWidth * (Height - 2);
+	const int InteriorCount = FloorInteriorCount * Depth;
+	int BacktracksLeft = Settings.MaxBacktracks;
+
+	auto GetPosition = [&](int CellIndex)
+	{
+		return InGrid.GetZ(CellIndex) * FloorInteriorCount + (InGrid.GetY(CellIndex) - 1) * InteriorWidth +
+			(InGrid.GetX(CellIndex) - 1);
+	};
+
+	for (int Position = 0; Position < InteriorCount; )
+	{
+		const int FloorPosition = Position % FloorInteriorCount;
+		const int CellIndex = InGrid.GetIndex(1 + FloorPosition % InteriorWidth, 1 + FloorPosition / InteriorWidth,
+			Position / FloorInteriorCount);
+
+		if (Position % InteriorWidth == 0 && Settings.CancellationFlag &&
+			Settings.CancellationFlag->load(std::memory_order_relaxed))
+		{
+			return false;
+		}
+
+		// Each cell has its own stream (as with the scanline solver):
+		FWangTileRandomStream CellRandomStream(FWangTileRandomStream::DeriveSeed(Settings.Seed,
+			static_cast<uint64_t>(CellIndex)));
+
+		const uint64_t* Domain = GetDomain(CellIndex);
+		const int DomainSize = FWangTileMask::CountTiles(Domain, MaskWordCount);
+
+		if (DomainSize == 0)
+		{
+			// No tile fits here, so choose as the scanline solver would (this cannot be undone,
+			// so nor can any placement before it):
+			OutStats.RelaxedCells++;
+			PlaceTile(CellIndex, PickScanlineTile(CellIndex, CellRandomStream), false);
+			TrimTrail(0);
+			Position++;
+			continue;
+		}
+
+		OutStats.CandidatesConsidered += DomainSize;
+
+		const int Tile = PickTile(Domain, CellRandomStream);
+		Placements.push_back({ CellIndex, Tile, TrailCells.size() });
+
+		if (PlaceTile(CellIndex, Tile, true))
+		{
+			TrimTrail(Settings.MaxBacktrackDepth);
+			Position++;
+			continue;
+		}
+
+		// Undo placements until one can be swapped for another tile:
+		while (true)
+		{
+			const FPlacement Undone = Placements.back();
+			Placements.pop_back();
+			UndoTrail(Undone.TrailStart);
+
+			if (BacktracksLeft > 0)
+			{
+				BacktracksLeft--;
+				OutStats.Backtracks++;
+
+				if (ExcludeTile(Undone.CellIndex, Undone.Tile))
+				{
+					Position = GetPosition(Undone.CellIndex);
+					break;
+				}
+
+				// No other tile fits there either, so go back a placement further (if there is one):
+				if (!Placements.empty())
+				{
+					continue;
+				}
+
+				UndoTrail(Undone.TrailStart);
+			}
+
+			// Keep the tile after all (leaving any cell that it empties to the scanline solver's choice):
+			PlaceTile(Undone.CellIndex, Undone.Tile, false);
+			TrimTrail(0);
+			Position = GetPosition(Undone.CellIndex) + 1;
+			break;
+		}
+	}
+
+	return true;
+}
+
+bool FWangTileConstraintPropagator::PlaceTile(int CellIndex, int Tile, bool IsStrict)
+{
+	uint64_t* Domain = GetDomain(CellIndex);
+
+	TrailCells.push_back(CellIndex);
+	TrailDomains.insert(TrailDomains.end(), Domain, Domain + MaskWordCount);
+
+	std::fill(Domain, Domain + MaskWordCount, 0);
+	FWangTileMask::AddTile(Domain, Tile);
+	(*Grid)[CellIndex].TileId = static_cast<uint16_t>(Tile);
+
+	if (!IsInWorklist[CellIndex])
+	{
+		Worklist.push_back(CellIndex);
+		IsInWorklist[CellIndex] = 1;
+	}
+
+	return Propagate(IsStrict);
+}
+
+bool FWangTileConstraintPropagator::ExcludeTile(int CellIndex, int Tile)
+{
+	uint64_t* Domain = GetDomain(CellIndex);
+
+	TrailCells.push_back(CellIndex);
+	TrailDomains.insert(TrailDomains.end(), Domain, Domain + MaskWordCount);
+
+	Domain[Tile >> 6] &= ~(uint64_t(1) << (Tile & 63));
+	if (FWangTileMask::CountTiles(Domain, MaskWordCount) == 0)
+	{
+		return false;
+	}
+
+	Worklist.push_back(CellIndex);
+	IsInWorklist[CellIndex] = 1;
+
+	return Propagate(true);
+}
+
+bool FWangTileConstraintPropagator::Propagate(bool IsStrict)
+{
+	while (!Worklist.empty())
+	{
+		const int CellIndex = Worklist.back();
+		Worklist.pop_back();
+		IsInWorklist[CellIndex] = 0;
+
+		// (An empty domain, left by a placement that was not strict, supports nothing):
+		if (FWangTileMask::CountTiles(GetDomain(CellIndex), MaskWordCount) == 0)
+		{
+			continue;
+		}
+
+		const int X = Grid->GetX(CellIndex);
+		const int Y = Grid->GetY(CellIndex);
+		const int Z = Grid->GetZ(CellIndex);
+		const int Placement = static_cast<int>((*Grid)[CellIndex].Placement);
+		bool IsConsistent = true;
+
+		// The cells to the east and north need a tile that this cell's tiles allow...
+		if (IsInteriorCell(X + 1, Y))
+		{
+			IsConsistent = Revise(Grid->GetEastIndex(CellIndex), GatherSupport(CellIndex, EWangTileSide::East,
+				Placement), IsStrict);
+		}
+
+		if (IsConsistent && IsInteriorCell(X, Y + 1))
+		{
+			IsConsistent = Revise(Grid->GetNorthIndex(CellIndex), GatherSupport(CellIndex, EWangTileSide::North,
+				Placement), IsStrict);
+		}
+
+		// ...and (if this cell is in the interior) the cells to the west and south need a tile that allows one of them:
+		if (IsConsistent && IsInteriorCell(X, Y))
+		{
+			const int WestIndex = Grid->GetWestIndex(CellIndex);
+			IsConsistent = Revise(WestIndex, GatherSupport(CellIndex, EWangTileSide::West,
+				static_cast<int>((*Grid)[WestIndex].Placement)), IsStrict);
+
+			if (IsConsistent)
+			{
+				const int SouthIndex = Grid->GetSouthIndex(CellIndex);
+				IsConsistent = Revise(SouthIndex, GatherSupport(CellIndex, EWangTileSide::South,
+					static_cast<int>((*Grid)[SouthIndex].Placement)), IsStrict);
+			}
+
+			// (And the cells above and below it, which are in the interior too):
+			if (IsConsistent && Z + 1 < Depth)
+			{
+				IsConsistent = Revise(Grid->GetAboveIndex(CellIndex), GatherVerticalSupport(CellIndex, true), IsStrict);
+			}
+
+			if (IsConsistent && Z > 0)
+			{
+				IsConsistent = Revise(Grid->GetBelowIndex(CellIndex), GatherVerticalSupport(CellIndex, false), IsStrict);
+			}
+		}
+
+		if (!IsConsistent)
+		{
+			for (int PendingCell : Worklist)
+			{
+				IsInWorklist[PendingCell] = 0;
+			}
+
+			Worklist.clear();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FWangTileConstraintPropagator::Revise(int CellIndex, const uint64_t* Support, bool IsStrict)
+{
+	uint64_t* Domain = GetDomain(CellIndex);
+
+	bool IsChanged = false;
+	for (int WordIndex = 0; WordIndex < MaskWordCount; WordIndex++)
+	{
+		IsChanged |= (Domain[WordIndex] & ~Support[WordIndex]) != 0;
+	}
+
+	if (!IsChanged)
+	{
+		return true;
+	}
+
+	TrailCells.push_back(CellIndex);
+	TrailDomains.insert(TrailDomains.end(), Domain, Domain + MaskWordCount);
+
+	bool IsEmpty = true;
+	for (int WordIndex = 0; WordIndex < MaskWordCount; WordIndex++)
+	{
+		Domain[WordIndex] &= Support[WordIndex];
+		IsEmpty &= Domain[WordIndex] == 0;
+	}
+
+	if (IsEmpty)
+	{
+		return !IsStrict;
+	}
+
+	if (!IsInWorklist[CellIndex])
+	{
+		Worklist.push_back(CellIndex);
+		IsInWorklist[CellIndex] = 1;
+	}
+
+	return true;
+}
+
+const uint64_t* FWangTileConstraintPropagator::GatherSupport(int CellIndex, EWangTileSide Direction,
+	int NeighbourPlacement)
+{
+	const std::vector<uint64_t>* NeighbourMasks[] = { &NorthNeighbourMasks, &EastNeighbourMasks,
+		&SouthNeighbourMasks, &WestNeighbourMasks };
+	const uint64_t* PlacementMasks = &(*NeighbourMasks[static_cast<int>(Direction)])[
+		NeighbourPlacement * TileCount * MaskWordCount];
+	const uint64_t* Domain = GetDomain(CellIndex);
+
+	// A placed tile's support needs no gathering:
+	int SingleTile = -1;
+	for (int WordIndex = 0; WordIndex < MaskWordCount; WordIndex++)
+	{
+		if (Domain[WordIndex] != 0)
+		{
+			if (SingleTile != -1 || (Domain[WordIndex] & (Domain[WordIndex] - 1)) != 0)
+			{
+				SingleTile = -2;
+				break;
+			}
+
+			SingleTile = WordIndex * 64 + FWangTileMask::GetLowestBit(Domain[WordIndex]);
+		}
+	}
+
+	if (SingleTile >= 0)
+	{
+		return PlacementMasks + SingleTile * MaskWordCount;
+	}
+
+	// Otherwise, look for it in the cache (by an FNV-1a hash of the domain, with its top bits
+	// mixed by a Fibonacci hash, as those pick the entry):
+	const uint64_t CacheTag = 1 + static_cast<uint64_t>(Direction) * static_cast<int>(EWangTilePlacement::Count) +
+		NeighbourPlacement;
+	uint64_t CacheHash = 14695981039346656037ULL;
+	for (int WordIndex = 0; WordIndex < MaskWordCount; WordIndex++)
+	{
+		CacheHash = (CacheHash ^ Domain[WordIndex]) * 1099511628211ULL;
+	}
+	CacheHash = (CacheHash ^ CacheTag) * 0x9E3779B97F4A7C15ULL;
+
+	const std::size_t CacheSlot = static_cast<std::size_t>(CacheHash >> (64 - SUPPORT_CACHE_BITS));
+	uint64_t* CacheKey = &SupportCacheKeys[CacheSlot * (MaskWordCount + 1)];
+	uint64_t* Support = &SupportCacheValues[CacheSlot * MaskWordCount];
+
+	if (CacheKey[0] == CacheTag && std::equal(Domain, Domain + MaskWordCount, CacheKey + 1))
+	{
+		return Support;
+	}
+
+	std::fill(Support, Support + MaskWordCount, 0);
+	FWangTileMask::ForEachTile(Domain, MaskWordCount, [&](int Tile)
+	{
+		const uint64_t* TileMask = PlacementMasks + Tile * MaskWordCount;
+		for (int WordIndex = 0; WordIndex < MaskWordCount; WordIndex++)
+		{
+			Support[WordIndex] |= TileMask[WordIndex];
+		}
+	});
+
+	CacheKey[0] = CacheTag;
+	std::copy(Domain, Domain + MaskWordCount, CacheKey + 1);
+
+	return Support;
+}
+
+const uint64_t* FWangTileConstraintPropagator::GatherVerticalSupport(int CellIndex, bool IsUpwards)
+{
+	// Going up, a tile that leads up allows the tiles that lead down (and one that doesn't, those
+	// that don't); going down, the other way around:
+	const uint64_t* Domain = GetDomain(CellIndex);
+	const uint64_t* LinkedTiles = IsUpwards ? UpLinkedTiles.data() : DownLinkedTiles.data();
+	const uint64_t* NeighbourLinkedTiles = IsUpwards ? DownLinkedTiles.data() : UpLinkedTiles.data();
+
+	bool HasLinkedTile = false;
+	bool HasUnlinkedTile = false;
+	for (int WordIndex = 0; WordIndex < MaskWordCount; WordIndex++)
+	{
+		HasLinkedTile |= (Domain[WordIndex] & LinkedTiles[WordIndex]) != 0;
+		HasUnlinkedTile |= (Domain[WordIndex] & ~LinkedTiles[WordIndex]) != 0;
+	}
+
+	for (int WordIndex = 0; WordIndex < MaskWordCount; WordIndex++)
+	{
+		VerticalSupport[WordIndex] = (HasLinkedTile ? NeighbourLinkedTiles[WordIndex] : 0) |
+			(HasUnlinkedTile ? AllTiles[WordIndex] & ~NeighbourLinkedTiles[WordIndex] : 0);
+	}
+
+	return VerticalSupport.data();
+}
+
+void FWangTileConstraintPropagator::GetFloorTiles(int Z, uint64_t* Mask) const
+{
+	for (int WordIndex = 0; WordIndex < MaskWordCount; WordIndex++)
+	{
+		Mask[WordIndex] = AllTiles[WordIndex] & (Z == 0 ? ~DownLinkedTiles[WordIndex] : ~uint64_t(0)) &
+			(Z == Depth - 1 ? ~UpLinkedTiles[WordIndex] : ~uint64_t(0));
+	}
+}
+
+void FWangTileConstraintPropagator::UndoTrail(std::size_t TrailLength)
+{
+	while (TrailCells.size() > TrailLength)
+	{
+		const std::size_t TrailDomainStart = TrailDomains.size() - MaskWordCount;
+		std::copy(TrailDomains.begin() + TrailDomainStart, TrailDomains.end(), GetDomain(TrailCells.back()));
+
+		TrailDomains.resize(TrailDomainStart);
+		TrailCells.pop_back();
+	}
+}
+
+void FWangTileConstraintPropagator::TrimTrail(int MaxBacktrackDepth)
+{
+	if (MaxBacktrackDepth <= 0)
+	{
+		Placements.clear();
+		TrailCells.clear();
+		TrailDomains.clear();
+		return;
+	}
+
+	// Only trimmed once it is twice as long as it needs to be (so that this is cheap on average):
+	if (Placements.size() <= static_cast<std::size_t>(2 * MaxBacktrackDepth))
+	{
+		return;
+	}
+
+	const std::size_t FirstKept = Placements.size() - MaxBacktrackDepth;
+	const std::size_t TrimmedLength = Placements[FirstKept].TrailStart;
+
+	TrailCells.erase(TrailCells.begin(), TrailCells.begin() + TrimmedLength);
+	TrailDomains.erase(TrailDomains.begin(), TrailDomains.begin() + TrimmedLength * MaskWordCount);
+	Placements.erase(Placements.begin(), Placements.begin() + FirstKept);
+
+	for (FPlacement& KeptPlacement : Placements)
+	{
+		KeptPlacement.TrailStart -= TrimmedLength;
+	}
+}
+
+int FWangTileConstraintPropagator::PickTile(const uint64_t* Mask, FWangTileRandomStream& RandomStream) const
+{
+	int MaskTileCount = 0;
+	double TotalWeight = 0.0;
+
+	FWangTileMask::ForEachTile(Mask, MaskWordCount, [&](int Tile)
+	{
+		MaskTileCount++;
+		TotalWeight += std::max(SelectionWeights[Tile], 0.0f);
+	});
+
+	// By weight (from the cumulative weights), or uniformly if the tiles have no weight at all:
+	int PickedTile = -1;
+	if (TotalWeight > 0.0)
+	{
+		double Remaining = RandomStream.GetNextUInt32() / 4294967296.0 * TotalWeight;
+
+		FWangTileMask::ForEachTile(Mask, MaskWordCount, [&](int Tile)
+		{
+			if (Remaining >= 0.0 && SelectionWeights[Tile] > 0.0f)
+			{
+				PickedTile = Tile;
+				Remaining -= SelectionWeights[Tile];
+			}
+		});
+	}
+	else
+	{
+		int Remaining = static_cast<int>(RandomStream.GetBoundedUInt32(static_cast<uint32_t>(MaskTileCount)));
+
+		FWangTileMask::ForEachTile(Mask, MaskWordCount, [&](int Tile)
+		{
+			if (Remaining-- == 0)
+			{
+				PickedTile = Tile;
+			}
+		});
+	}
+
+	return PickedTile;
+}
+
+int FWangTileConstraintPropagator::PickScanlineTile(int CellIndex, FWangTileRandomStream& RandomStream) const
+{
+	const FWangTileCell& WestCell = (*Grid)[Grid->GetWestIndex(CellIndex)];
+	const FWangTileCell& SouthCell = (*Grid)[Grid->GetSouthIndex(CellIndex)];
+
+	const uint64_t* WestAllows = &EastNeighbourMasks[(static_cast<int>(WestCell.Placement) * TileCount +
+		WestCell.TileId) * MaskWordCount];
+	const uint64_t* SouthAllows = &NorthNeighbourMasks[(static_cast<int>(SouthCell.Placement) * TileCount +
+		SouthCell.TileId) * MaskWordCount];
+
+	// The tiles that suit the tile below (and the floor):
+	const int Z = Grid->GetZ(CellIndex);
+	std::vector<uint64_t> VerticalTiles(MaskWordCount);
+	GetFloorTiles(Z, VerticalTiles.data());
+
+	if (Z > 0)
+	{
+		const int BelowTile = (*Grid)[Grid->GetBelowIndex(CellIndex)].TileId;
+		const bool IsLinkedBelow = BelowTile < TileCount && FWangTileMask::ContainsTile(UpLinkedTiles.data(), BelowTile);
+
+		for (int WordIndex = 0; WordIndex < MaskWordCount; WordIndex++)
+		{
+			VerticalTiles[WordIndex] &= IsLinkedBelow ? DownLinkedTiles[WordIndex] : ~DownLinkedTiles[WordIndex];
+		}
+	}
+
+	// Prefer a tile that suits both neighbours, then one that suits the tile to the west, then any tile
+	// (of those that suit the tile below, as the scanline solver does, unless none of them do):
+	std::vector<uint64_t> Candidates(MaskWordCount);
+	std::vector<uint64_t> VerticalCandidates(MaskWordCount);
+
+	if (FWangTileMask::Intersect(WestAllows, SouthAllows, MaskWordCount, Candidates.data()) > 0)
+	{
+		if (FWangTileMask::Intersect(Candidates.data(), VerticalTiles.data(), MaskWordCount, VerticalCandidates.data()) > 0)
+		{
+			return PickTile(VerticalCandidates.data(), RandomStream);
+		}
+	}
+	else
+	{
+		Candidates.assign(WestAllows, WestAllows + MaskWordCount);
+	}
+
+	if (FWangTileMask::Intersect(WestAllows, VerticalTiles.data(), MaskWordCount, VerticalCandidates.data()) > 0)
+	{
+		return PickTile(VerticalCandidates.data(), RandomStream);
+	}
+
+	if (FWangTileMask::CountTiles(VerticalTiles.data(), MaskWordCount) > 0)
+	{
+		return PickTile(VerticalTiles.data(), RandomStream);
+	}
+
+	if (FWangTileMask::CountTiles(Candidates.data(), MaskWordCount) == 0)
+	{
+		Candidates = AllTiles;
+	}
+
+	return PickTile(Candidates.data(), RandomStream);
+}
@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WangTileGrid.h"
+
+void FWangTileGrid::Reset(int InWidth, int InHeight, int InDepth)
+{
+	Width = InWidth > 0 ? InWidth : 0;
+	Height = InHeight > 0 ? InHeight : 0;
+	Depth = Width > 0 && Height > 0 && InDepth > 0 ? InDepth : 0;
+
+	Cells.assign(static_cast<std::size_t>(Width) * Height * Depth, FWangTileCell());
+
+	// The classification only depends on the size of the grid, so it is stored once here:
+	for (int Z = 0; Z < Depth; Z++)
+	{
+		for (int Y = 0; Y < Height; Y++)
+		{
+			for (int X = 0; X < Width; X++)
+			{
+				Cells[GetIndex(X, Y, Z)].Placement = GetPlacement(X, Y, Width, Height);
+			}
+		}
+	}
+}
+
+void FWangTileGrid::Resize(int NewWidth, int NewHeight, int OffsetX, int OffsetY,
+	std::vector<FWangTileRect>& OutClearedRects)
+{
+	FWangTileGrid ResizedGrid(NewWidth, NewHeight, Depth > 0 ? Depth : 1);
+	OutClearedRects.clear();
+
+	for (int Y = 0; Y < ResizedGrid.Height; Y++)
+	{
+		// For the span of cleared cells in this row (on any floor):
+		int ClearedMinX = ResizedGrid.Width;
+		int ClearedMaxX = 0;
+
+		for (int X = 0; X < ResizedGrid.Width; X++)
+		{
+			int PreviousX = X - OffsetX;
+			int PreviousY = Y - OffsetY;
+
+			for (int Z = 0; Z < ResizedGrid.Depth; Z++)
+			{
+				FWangTileCell& ResizedCell = ResizedGrid.At(X, Y, Z);
+
+				if (IsValid(PreviousX, PreviousY, Z) && At(PreviousX, PreviousY, Z).Placement == ResizedCell.Placement)
+				{
+					ResizedCell.TileId = At(PreviousX, PreviousY, Z).TileId;
+					ResizedCell.Flags = At(PreviousX, PreviousY, Z).Flags;
+				}
+
+				if (!ResizedCell.HasTile())
+				{
+					ClearedMinX = X < ClearedMinX ? X : ClearedMinX;
+					ClearedMaxX = X + 1;
+				}
+			}
+		}
+
+		if (ClearedMinX < ClearedMaxX)
+		{
+			OutClearedRects.push_back(FWangTileRect(ClearedMinX, Y, ClearedMaxX, Y + 1));
+		}
+	}
+
+	*this = std::move(ResizedGrid);
+}
+
+EWangTilePlacement FWangTileGrid::GetPlacement(int X, int Y, int GridWidth, int GridHeight)
+{
+	bool IsOnWestOrEastEdge = X == 0 || X == GridWidth - 1;
+	bool IsOnSouthOrNorthEdge = Y == 0 || Y == GridHeight - 1;
+
+	if (IsOnWestOrEastEdge && IsOnSouthOrNorthEdge)
+	{
+		return EWangTilePlacement::Corner;
+	}
+	else if (IsOnWestOrEastEdge || IsOnSouthOrNorthEdge)
+	{
+		return EWangTilePlacement::Edge;
+	}
+
+	return EWangTilePlacement::Interior;
+}
+
+// For the layout checksum (64-bit FNV-1a):
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+/** Hash the value a byte at a time, little-endian whatever the platform. */
+static void HashLittleEndianBytes(uint64_t& Checksum, uint32_t Value, int ByteCount)
+{
+	for (int ByteIndex = 0; ByteIndex < ByteCount; ByteIndex++)
+	{
+		Checksum ^= (Value >> (ByteIndex * 8)) & 0xFF;
+		Checksum *= FNV_PRIME;
+	}
+}
+
+uint64_t FWangTileGrid::ComputeLayoutChecksum() const
+{
+	uint64_t Checksum = FNV_OFFSET_BASIS;
+
+	HashLittleEndianBytes(Checksum, static_cast<uint32_t>(Width), 4);
+	HashLittleEndianBytes(Checksum, static_cast<uint32_t>(Height), 4);
+
+	if (Depth > 1)
+	{
+		HashLittleEndianBytes(Checksum, static_cast<uint32_t>(Depth), 4);
+	}
+
+	for (const FWangTileCell& Cell : Cells)
+	{
+		HashLittleEndianBytes(Checksum, Cell.TileId, 2);
+	}
+
+	return Checksum;
+}
@@ -0,0 +1,261 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WangTileLayoutFile.h"
+#include "WangTileSolver.h"
+#include <cstring>
+
+// The header keeps the whole Seed, so that a layout can always be solved again from its file:
+static_assert(sizeof(FWangTileLayoutHeader::Seed) == sizeof(FWangTileSolverSettings::Seed),
+	"A layout file's Seed must be as wide as the solver's");
+
+/** Write the value a byte at a time, little-endian whatever the platform. */
+static void WriteLayoutFileValue(uint8_t*& Cursor, uint64_t Value, int ByteCount)
+{
+	for (int ByteIndex = 0; ByteIndex < ByteCount; ByteIndex++)
+	{
+		*Cursor++ = static_cast<uint8_t>(Value >> (ByteIndex * 8));
+	}
+}
+
+static uint64_t ReadLayoutFileValue(const uint8_t*& Cursor, int ByteCount)
+{
+	uint64_t Value = 0;
+	for (int ByteIndex = 0; ByteIndex < ByteCount; ByteIndex++)
+	{
+		Value |= static_cast<uint64_t>(*Cursor++) << (ByteIndex * 8);
+	}
+
+	return Value;
+}
+
+/** For the bits of a float (so that it is stored, and hashed, exactly). */
+static uint32_t GetLayoutFileFloatBits(float Value)
+{
+	uint32_t Bits;
+	std::memcpy(&Bits, &Value, sizeof(Bits));
+	return Bits;
+}
+
+static float GetLayoutFileFloat(uint32_t Bits)
+{
+	float Value;
+	std::memcpy(&Value, &Bits, sizeof(Value));
+	return Value;
+}
+
+std::vector<uint8_t> FWangTileLayoutFile::Encode(const FWangTileGrid& Grid, FWangTileLayoutHeader Header)
+{
+	Header.Width = Grid.GetWidth();
+	Header.Height = Grid.GetHeight();
+	Header.Depth = Grid.GetDepth() > 1 ? Grid.GetDepth() : 1;
+	Header.LayoutChecksum = Grid.ComputeLayoutChecksum();
+
+	// Enough bits for the highest tile id, with the highest value left for a cell with no tile:
+	int HighestTileId = 0;
+	for (const FWangTileCell& Cell : Grid.GetCells())
+	{
+		HighestTileId = Cell.HasTile() && Cell.TileId > HighestTileId ? Cell.TileId : HighestTileId;
+	}
+
+	Header.BitsPerTile = 1;
+	while ((1 << Header.BitsPerTile) - 1 <= HighestTileId)
+	{
+		Header.BitsPerTile++;
+	}
+
+	std::vector<uint8_t> FileData(GetFileSize(Header), 0);
+	uint8_t* Cursor = FileData.data();
+
+	// (In version 1, the floors were the high half of the bits per tile, which was always 0):
+	WriteLayoutFileValue(Cursor, FILE_MAGIC, 4);
+	WriteLayoutFileValue(Cursor, Header.Depth > 1 ? FILE_VERSION : FLAT_FILE_VERSION, 4);
+	WriteLayoutFileValue(Cursor, Header.Seed, 4);
+	WriteLayoutFileValue(Cursor, static_cast<uint32_t>(Header.Width), 4);
+	WriteLayoutFileValue(Cursor, static_cast<uint32_t>(Header.Height), 4);
+	WriteLayoutFileValue(Cursor, static_cast<uint32_t>(Header.BitsPerTile), 2);
+	WriteLayoutFileValue(Cursor, static_cast<uint32_t>(Header.Depth > 1 ? Header.Depth : 0), 2);
+	WriteLayoutFileValue(Cursor, GetLayoutFileFloatBits(Header.ExtentX), 4);
+	WriteLayoutFileValue(Cursor, GetLayoutFileFloatBits(Header.ExtentY), 4);
+	WriteLayoutFileValue(Cursor, Header.TileSetHash, 8);
+	WriteLayoutFileValue(Cursor, Header.LayoutChecksum, 8);
+
+	// Each row's tiles, from the lowest bit of its first byte upwards:
+	const uint32_t NoTileValue = (1u << Header.BitsPerTile) - 1;
+
+	for (int Row = 0; Row < GetRowCount(Header); Row++)
+	{
+		uint8_t* RowData = &FileData[GetRowOffset(Header, Row)];
+		uint64_t BitBuffer = 0;
+		int BufferedBitCount = 0;
+
+		for (int X = 0; X < Header.Width; X++)
+		{
+			// (The rows of the floors follow one another, as do the cells of the grid):
+			const FWangTileCell& Cell = Grid[Row * Header.Width + X];
+			BitBuffer |= static_cast<uint64_t>(Cell.HasTile() ? Cell.TileId : NoTileValue) << BufferedBitCount;
+			BufferedBitCount += Header.BitsPerTile;
+
+			for (; BufferedBitCount >= 8; BufferedBitCount -= 8)
+			{
+				*RowData++ = static_cast<uint8_t>(BitBuffer);
+				BitBuffer >>= 8;
+			}
+		}
+
+		if (BufferedBitCount > 0)
+		{
+			*RowData = static_cast<uint8_t>(BitBuffer);
+		}
+	}
+
+	return FileData;
+}
+
+bool FWangTileLayoutFile::DecodeHeader(const uint8_t* Data, std::size_t Size, FWangTileLayoutHeader& OutHeader)
+{
+	// Sanity check:
+	if (!Data || Size < static_cast<std::size_t>(HEADER_SIZE))
+	{
+		return false;
+	}
+
+	const uint8_t* Cursor = Data;
+	if (ReadLayoutFileValue(Cursor, 4) != FILE_MAGIC)
+	{
+		return false;
+	}
+
+	const uint64_t Version = ReadLayoutFileValue(Cursor, 4);
+	if (Version != FILE_VERSION && Version != FLAT_FILE_VERSION)
+	{
+		return false;
+	}
+
+	OutHeader.Seed = static_cast<uint32_t>(ReadLayoutFileValue(Cursor, 4));
+	OutHeader.Width = static_cast<int>(ReadLayoutFileValue(Cursor, 4));
+	OutHeader.Height = static_cast<int>(ReadLayoutFileValue(Cursor, 4));
+	OutHeader.BitsPerTile = static_cast<int>(ReadLayoutFileValue(Cursor, 2));
+	const int Depth = static_cast<int>(ReadLayoutFileValue(Cursor, 2));
+	OutHeader.Depth = Version == FILE_VERSION ? Depth : 1;
+	OutHeader.ExtentX = GetLayoutFileFloat(static_cast<uint32_t>(ReadLayoutFileValue(Cursor, 4)));
+	OutHeader.ExtentY = GetLayoutFileFloat(static_cast<uint32_t>(ReadLayoutFileValue(Cursor, 4)));
+	OutHeader.TileSetHash = ReadLayoutFileValue(Cursor, 8);
+	OutHeader.LayoutChecksum = ReadLayoutFileValue(Cursor, 8);
+
+	// (A tile id is no more than 16 bits):
+	return OutHeader.Width >= 0 && OutHeader.Height >= 0 && OutHeader.Depth >= 1 && OutHeader.BitsPerTile >= 1 &&
+		OutHeader.BitsPerTile <= 16 && (Version == FILE_VERSION || Depth == 0);
+}
+
+bool FWangTileLayoutFile::Decode(const uint8_t* Data, std::size_t Size, int TileCount, FWangTileLayoutHeader& OutHeader,
+	FWangTileGrid& OutGrid)
+{
+	if (!DecodeHeader(Data, Size, OutHeader) || Size < GetFileSize(OutHeader))
+	{
+		return false;
+	}
+
+	OutGrid.Reset(OutHeader.Width, OutHeader.Height, OutHeader.Depth);
+
+	for (int Row = 0; Row < GetRowCount(OutHeader); Row++)
+	{
+		DecodeRow(OutHeader, Data + GetRowOffset(OutHeader, Row), Row, OutGrid);
+	}
+
+	return OutGrid.ComputeLayoutChecksum() == OutHeader.LayoutChecksum && HasOnlyTiles(OutGrid, TileCount);
+}
+
+void FWangTileLayoutFile::DecodeRow(const FWangTileLayoutHeader& Header, const uint8_t* RowData, int Row,
+	FWangTileGrid& Grid)
+{
+	const uint32_t NoTileValue = (1u << Header.BitsPerTile) - 1;
+	uint64_t BitBuffer = 0;
+	int BufferedBitCount = 0;
+
+	for (int X = 0; X < Header.Width; X++)
+	{
+		for (; BufferedBitCount < Header.BitsPerTile; BufferedBitCount += 8)
+		{
+			BitBuffer |= static_cast<uint64_t>(*RowData++) << BufferedBitCount;
+		}
+
+		const uint32_t TileValue = static_cast<uint32_t>(BitBuffer) & NoTileValue;
+		BitBuffer >>= Header.BitsPerTile;
+		BufferedBitCount -= Header.BitsPerTile;
+
+		Grid[Row * Header.Width + X].TileId = TileValue == NoTileValue ? FWangTileCell::NO_TILE : static_cast<uint16_t>(TileValue);
+	}
+}
+
+bool FWangTileLayoutFile::HasOnlyTiles(const FWangTileGrid& Grid, int TileCount)
+{
+	for (const FWangTileCell& Cell : Grid.GetCells())
+	{
+		if (!Cell.HasTile() || Cell.TileId >= TileCount)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+std::size_t FWangTileLayoutFile::GetRowSize(const FWangTileLayoutHeader& Header)
+{
+	return (static_cast<std::size_t>(Header.Width) * Header.BitsPerTile + 7) / 8;
+}
+
+std::size_t FWangTileLayoutFile::GetRowOffset(const FWangTileLayoutHeader& Header, int Row)
+{
+	return HEADER_SIZE + static_cast<std::size_t>(Row) * GetRowSize(Header);
+}
+
+std::size_t FWangTileLayoutFile::GetFileSize(const FWangTileLayoutHeader& Header)
+{
+	return GetRowOffset(Header, GetRowCount(Header));
+}
+
+uint64_t FWangTileLayoutFile::ComputeTileSetHash(const std::vector<FWangTileDefinition>& TileSet)
+{
+	// 64-bit FNV-1a, a byte at a time (as with the layout checksum):
+	uint64_t TileSetHash = 14695981039346656037ULL;
+	auto HashValue = [&TileSetHash](uint32_t Value)
+	{
+		for (int ByteIndex = 0; ByteIndex < 4; ByteIndex++)
+		{
+			TileSetHash ^= (Value >> (ByteIndex * 8)) & 0xFF;
+			TileSetHash *= 1099511628211ULL;
+		}
+	};
+
+	HashValue(static_cast<uint32_t>(TileSet.size()));
+
+	for (const FWangTileDefinition& Tile : TileSet)
+	{
+		HashValue(GetLayoutFileFloatBits(Tile.DispersionCoefficient));
+		HashValue(static_cast<uint32_t>(Tile.ZoneObjectCount));
+		HashValue(GetLayoutFileFloatBits(Tile.TotalZoneObjectArea));
+		HashValue(GetLayoutFileFloatBits(Tile.SelectionWeight));
+		HashValue(GetLayoutFileFloatBits(Tile.Footprint.OpenArea));
+		HashValue(GetLayoutFileFloatBits(Tile.Footprint.ChokepointWidth));
+
+		for (int SideIndex = 0; SideIndex < static_cast<int>(EWangTileSide::Count); SideIndex++)
+		{
+			HashValue(GetLayoutFileFloatBits(Tile.Footprint.SideOpenings[SideIndex]));
+			HashValue(Tile.Footprint.SideLinks[SideIndex]);
+		}
+
+		for (int EdgeColour : Tile.EdgeColours)
+		{
+			HashValue(static_cast<uint32_t>(EdgeColour));
+		}
+
+		// (Only for a stair or ramp, so that a tile-set without any hashes as it did before there were floors):
+		if (Tile.VerticalLinks != 0)
+		{
+			HashValue(Tile.VerticalLinks);
+		}
+	}
+
+	return TileSetHash;
+}
@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WangTileMask.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WANG_TILE_MASK_USE_SSE 1
+#include <emmintrin.h>
+#else
+#define WANG_TILE_MASK_USE_SSE 0
+#endif
+
+/** For the number of set bits in a word (without needing the POPCNT instruction). */
+static int CountWangTileMaskBits(uint64_t Word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcountll(Word);
+#else
+	Word = Word - ((Word >> 1) & 0x5555555555555555ULL);
+	Word = (Word & 0x3333333333333333ULL) + ((Word >> 2) & 0x3333333333333333ULL);
+	Word = (Word + (Word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return static_cast<int>((Word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/** Compare() for one comparison (so that it is chosen once, rather than per tile). */
+template<typename ScalarComparison, typename VectorComparison>
+static void CompareWangTileValues(const float* Values, int TileCount, float Bound, uint64_t* OutMask,
+	ScalarComparison CompareScalar, VectorComparison CompareVector)
+{
+	for (int WordStart = 0; WordStart < TileCount; WordStart += 64)
+	{
+		const int WordEnd = TileCount - WordStart < 64 ? TileCount : WordStart + 64;
+		uint64_t Word = 0;
+		int Tile = WordStart;
+
+#if WANG_TILE_MASK_USE_SSE
+		const __m128 Bounds = _mm_set1_ps(Bound);
+
+		// Four tiles at a time, with one bit per lane from the comparison:
+		for (; Tile + 4 <= WordEnd; Tile += 4)
+		{
+			const int LaneBits = _mm_movemask_ps(CompareVector(_mm_loadu_ps(Values + Tile), Bounds));
+			Word |= static_cast<uint64_t>(LaneBits) << (Tile - WordStart);
+		}
+#else
+		(void)CompareVector;
+#endif
+
+		// The rest (or every tile, without SSE):
+		for (; Tile < WordEnd; Tile++)
+		{
+			Word |= static_cast<uint64_t>(CompareScalar(Values[Tile], Bound)) << (Tile - WordStart);
+		}
+
+		OutMask[WordStart >> 6] = Word;
+	}
+}
+
+#if WANG_TILE_MASK_USE_SSE
+#define WANG_TILE_VECTOR_COMPARISON(Intrinsic) [](__m128 Vector, __m128 Bounds) { return Intrinsic(Vector, Bounds); }
+#else
+#define WANG_TILE_VECTOR_COMPARISON(Intrinsic) 0
+#endif
+
+void FWangTileMask::Compare(const float* Values, int TileCount, EWangTileComparison Comparison, float Bound,
+	uint64_t* OutMask)
+{
+	switch (Comparison)
+	{
+	case EWangTileComparison::LessOrEqual:
+		CompareWangTileValues(Values, TileCount, Bound, OutMask, [](float Value, float Limit) { return Value <= Limit; },
+			WANG_TILE_VECTOR_COMPARISON(_mm_cmple_ps));
+		break;
+	case EWangTileComparison::GreaterOrEqual:
+		CompareWangTileValues(Values, TileCount, Bound, OutMask, [](float Value, float Limit) { return Value >= Limit; },
+			WANG_TILE_VECTOR_COMPARISON(_mm_cmpge_ps));
+		break;
+	default:
+		CompareWangTileValues(Values, TileCount, Bound, OutMask, [](float Value, float Limit) { return Value < Limit; },
+			WANG_TILE_VECTOR_COMPARISON(_mm_cmplt_ps));
+		break;
+	}
+}
+
+#undef WANG_TILE_VECTOR_COMPARISON
+
+int FWangTileMask::Intersect(const uint64_t* A, const uint64_t* B, int WordCount, uint64_t* OutMask)
+{
+	int TileCount = 0;
+	for (int WordIndex = 0; WordIndex < WordCount; WordIndex++)
+	{
+		OutMask[WordIndex] = A[WordIndex] & B[WordIndex];
+		TileCount += CountWangTileMaskBits(OutMask[WordIndex]);
+	}
+
+	return TileCount;
+}
+
+int FWangTileMask::CountTiles(const uint64_t* Mask, int WordCount)
+{
+	int TileCount = 0;
+	for (int WordIndex = 0; WordIndex < WordCount; WordIndex++)
+	{
+		TileCount += CountWangTileMaskBits(Mask[WordIndex]);
+	}
+
+	return TileCount;
+}
@@ -0,0 +1,272 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WangTileOccupancy.h"
+#include "WangTileMask.h"
+#include <algorithm>
+#include <cmath>
+
+static const uint64_t ALL_OCCUPANCY_CELLS = ~uint64_t(0);
+
+/** Spread the set bits of Row eastwards (to higher bits) through the open bits, 1, 2, 4, ... 32 cells at a time. */
+static uint64_t SpreadOccupancyRowEast(uint64_t Row, uint64_t Open)
+{
+	Row &= Open;
+	for (int Shift = 1; Shift < FWangTileOccupancy::RESOLUTION; Shift *= 2)
+	{
+		Row |= Open & (Row << Shift);
+		Open &= Open << Shift;
+	}
+
+	return Row;
+}
+
+/** As SpreadOccupancyRowEast(), westwards (to lower bits). */
+static uint64_t SpreadOccupancyRowWest(uint64_t Row, uint64_t Open)
+{
+	Row &= Open;
+	for (int Shift = 1; Shift < FWangTileOccupancy::RESOLUTION; Shift *= 2)
+	{
+		Row |= Open & (Row >> Shift);
+		Open &= Open >> Shift;
+	}
+
+	return Row;
+}
+
+void FWangTileOccupancy::AddBox(float MinX, float MinY, float MaxX, float MaxY)
+{
+	// The cells the box overlaps at all (a box touching a cell's edge doesn't cover it):
+	const int MinCellX = std::max(0, static_cast<int>(std::floor(MinX * RESOLUTION)));
+	const int MinCellY = std::max(0, static_cast<int>(std::floor(MinY * RESOLUTION)));
+	const int MaxCellX = std::min(RESOLUTION - 1, static_cast<int>(std::ceil(MaxX * RESOLUTION)) - 1);
+	const int MaxCellY = std::min(RESOLUTION - 1, static_cast<int>(std::ceil(MaxY * RESOLUTION)) - 1);
+
+	// Sanity check:
+	if (MinCellX > MaxCellX || MinCellY > MaxCellY)
+	{
+		return;
+	}
+
+	const uint64_t BoxRow = (ALL_OCCUPANCY_CELLS >> (RESOLUTION - 1 - MaxCellX)) & (ALL_OCCUPANCY_CELLS << MinCellX);
+
+	for (int Y = MinCellY; Y <= MaxCellY; Y++)
+	{
+		Rows[Y] |= BoxRow;
+	}
+}
+
+int FWangTileOccupancy::GetOccupiedCellCount() const
+{
+	return CountCells(Rows);
+}
+
+FWangTileFootprint FWangTileOccupancy::Measure() const
+{
+	FWangTileFootprint Footprint;
+
+	FOccupancyBitmap Open;
+	for (int Y = 0; Y < RESOLUTION; Y++)
+	{
+		Open[Y] = ~Rows[Y];
+	}
+
+	Footprint.OpenArea = static_cast<float>(CountCells(Open)) / (RESOLUTION * RESOLUTION);
+
+	// The open cells along each side that a path from another side reaches:
+	for (int SideIndex = 0; SideIndex < static_cast<int>(EWangTileSide::Count); SideIndex++)
+	{
+		FOccupancyBitmap OtherSideCells = {};
+		for (int OtherSideIndex = 0; OtherSideIndex < static_cast<int>(EWangTileSide::Count); OtherSideIndex++)
+		{
+			if (OtherSideIndex != SideIndex)
+			{
+				const FOccupancyBitmap OtherSide = GetSideCells(static_cast<EWangTileSide>(OtherSideIndex), 0);
+				for (int Y = 0; Y < RESOLUTION; Y++)
+				{
+					OtherSideCells[Y] |= OtherSide[Y];
+				}
+			}
+		}
+
+		FOccupancyBitmap SideOpening = FloodFill(Open, OtherSideCells);
+		const FOccupancyBitmap SideCells = GetSideCells(static_cast<EWangTileSide>(SideIndex), 0);
+		for (int Y = 0; Y < RESOLUTION; Y++)
+		{
+			SideOpening[Y] &= SideCells[Y];
+		}
+
+		Footprint.SideOpenings[SideIndex] = static_cast<float>(CountCells(SideOpening)) / (RESOLUTION - 2);
+	}
+
+	// Which sides lead to which (so that a tile split in two only links the sides on each part):
+	for (int SideIndex = 0; SideIndex < static_cast<int>(EWangTileSide::Count); SideIndex++)
+	{
+		const FOccupancyBitmap Reached = FloodFill(Open, GetSideCells(static_cast<EWangTileSide>(SideIndex), 0));
+
+		for (int OtherSideIndex = 0; OtherSideIndex < static_cast<int>(EWangTileSide::Count); OtherSideIndex++)
+		{
+			if (OtherSideIndex == SideIndex)
+			{
+				continue;
+			}
+
+			const FOccupancyBitmap OtherSideCells = GetSideCells(static_cast<EWangTileSide>(OtherSideIndex), 0);
+
+			for (int Y = 0; Y < RESOLUTION; Y++)
+			{
+				if (Reached[Y] & OtherSideCells[Y])
+				{
+					Footprint.SideLinks[SideIndex] |= 1 << OtherSideIndex;
+					break;
+				}
+			}
+		}
+	}
+
+	// (A tile with nothing in the way is open all the way across)...
+	if (GetOccupiedCellCount() == 0)
+	{
+		Footprint.ChokepointWidth = 1.0f;
+		return Footprint;
+	}
+
+	// ...otherwise, a path Width cells wide survives (Width - 1) / 2 erosions, so the chokepoint is
+	// found from the last erosion that still leaves a path between two sides (each side then being
+	// as many cells in as there were erosions):
+	FOccupancyBitmap ErodedOpen = Open;
+	for (int ErosionCount = 0; 2 * ErosionCount + 1 <= RESOLUTION && HasPathBetweenSides(ErodedOpen, ErosionCount);
+		ErosionCount++)
+	{
+		Footprint.ChokepointWidth = static_cast<float>(2 * ErosionCount + 1) / RESOLUTION;
+		ErodedOpen = Erode(ErodedOpen);
+	}
+
+	return Footprint;
+}
+
+FWangTileOccupancy::FOccupancyBitmap FWangTileOccupancy::FloodFill(const FOccupancyBitmap& Open,
+	const FOccupancyBitmap& Seeds)
+{
+	FOccupancyBitmap Filled;
+	for (int Y = 0; Y < RESOLUTION; Y++)
+	{
+		Filled[Y] = Seeds[Y] & Open[Y];
+	}
+
+	// Sweep northwards then southwards (spreading along each row as it goes), until nothing changes:
+	bool IsFillChanged = true;
+	while (IsFillChanged)
+	{
+		IsFillChanged = false;
+
+		for (int Pass = 0; Pass < 2; Pass++)
+		{
+			const int FirstY = Pass == 0 ? 0 : RESOLUTION - 1;
+			const int StepY = Pass == 0 ? 1 : -1;
+
+			for (int Y = FirstY; Y >= 0 && Y < RESOLUTION; Y += StepY)
+			{
+				uint64_t Row = Filled[Y];
+				if (Y != FirstY)
+				{
+					Row |= Filled[Y - StepY] & Open[Y];
+				}
+
+				Row = SpreadOccupancyRowEast(Row, Open[Y]) | SpreadOccupancyRowWest(Row, Open[Y]);
+
+				if (Row != Filled[Y])
+				{
+					Filled[Y] = Row;
+					IsFillChanged = true;
+				}
+			}
+		}
+	}
+
+	return Filled;
+}
+
+FWangTileOccupancy::FOccupancyBitmap FWangTileOccupancy::Erode(const FOccupancyBitmap& Open)
+{
+	// Along each row first (the cells beyond the west and east sides count as covered)...
+	FOccupancyBitmap RowEroded;
+	for (int Y = 0; Y < RESOLUTION; Y++)
+	{
+		RowEroded[Y] = Open[Y] & (Open[Y] << 1) & (Open[Y] >> 1);
+	}
+
+	// ...then across the rows (as do the rows beyond the south and north sides):
+	FOccupancyBitmap Eroded;
+	for (int Y = 0; Y < RESOLUTION; Y++)
+	{
+		Eroded[Y] = RowEroded[Y] & (Y > 0 ? RowEroded[Y - 1] : 0) & (Y < RESOLUTION - 1 ? RowEroded[Y + 1] : 0);
+	}
+
+	return Eroded;
+}
+
+FWangTileOccupancy::FOccupancyBitmap FWangTileOccupancy::GetSideCells(EWangTileSide Side, int Inset)
+{
+	FOccupancyBitmap SideCells = {};
+
+	// Sanity check:
+	if (2 * Inset + 2 >= RESOLUTION)
+	{
+		return SideCells;
+	}
+
+	// Not including the first and last cell of each row or column (the corners):
+	const int FirstCell = Inset + 1;
+	const int LastCell = RESOLUTION - 2 - Inset;
+	const uint64_t InnerCells = (ALL_OCCUPANCY_CELLS >> (RESOLUTION - 1 - LastCell)) & (ALL_OCCUPANCY_CELLS << FirstCell);
+
+	switch (Side)
+	{
+	case EWangTileSide::North:
+		SideCells[RESOLUTION - 1 - Inset] = InnerCells;
+		break;
+	case EWangTileSide::South:
+		SideCells[Inset] = InnerCells;
+		break;
+	case EWangTileSide::East:
+	case EWangTileSide::West:
+		for (int Y = FirstCell; Y <= LastCell; Y++)
+		{
+			SideCells[Y] = uint64_t(1) << (Side == EWangTileSide::East ? RESOLUTION - 1 - Inset : Inset);
+		}
+		break;
+	default:
+		break;
+	}
+
+	return SideCells;
+}
+
+bool FWangTileOccupancy::HasPathBetweenSides(const FOccupancyBitmap& Open, int Inset)
+{
+	// Fill from each side in turn (a path to the last side is found from the other end):
+	for (int SideIndex = 0; SideIndex < static_cast<int>(EWangTileSide::Count) - 1; SideIndex++)
+	{
+		const FOccupancyBitmap Reached = FloodFill(Open, GetSideCells(static_cast<EWangTileSide>(SideIndex), Inset));
+
+		for (int OtherSideIndex = SideIndex + 1; OtherSideIndex < static_cast<int>(EWangTileSide::Count); OtherSideIndex++)
+		{
+			const FOccupancyBitmap OtherSideCells = GetSideCells(static_cast<EWangTileSide>(OtherSideIndex), Inset);
+
+			for (int Y = 0; Y < RESOLUTION; Y++)
+			{
+				if (Reached[Y] & OtherSideCells[Y])
+				{
+					return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+int FWangTileOccupancy::CountCells(const FOccupancyBitmap& Bitmap)
+{
+	return FWangTileMask::CountTiles(Bitmap.data(), RESOLUTION);
+}
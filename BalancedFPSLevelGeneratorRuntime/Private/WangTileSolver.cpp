@@ -0,0 +1,1275 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WangTileSolver.h"
+#include "WangTileConstraintPropagator.h"
+#include "WangTileConnectivity.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <thread>
+
+// Coefficients:
+
+float FWangTileCoefficients::FindFlankingCoefficient(float SurroundingZones, float AdjacentZones)
+{
+	return 1.0f - (AdjacentZones / SurroundingZones);
+}
+
+float FWangTileCoefficients::FindDefensivenessCoefficient(int ZoneObjectCount, float TotalZoneObjectArea,
+	float AdjacentZones)
+{
+	float ZoneObjectVolume = ZoneObjectCount / HIGHEST_ZONE_OBJECT_COUNT;
+
+	// The absolute value is what matters here (for comparison):
+	float PathDensity = std::abs(FindNonAbsolutePathDensity(AdjacentZones));
+	PathDensity /= HIGHEST_ZONE_OBJECT_COUNT;
+
+	// Now take into account the area of objects in this Zone:
+	return (ZoneObjectVolume + PathDensity) / 2.0f + TotalZoneObjectArea;
+}
+
+float FWangTileCoefficients::FindDefensivenessCoefficient(const FWangTileDefinition& Tile, float AdjacentZones)
+{
+	if (!Tile.Footprint.IsMeasured())
+	{
+		return FindDefensivenessCoefficient(Tile.ZoneObjectCount, Tile.TotalZoneObjectArea, AdjacentZones);
+	}
+
+	float ZoneObjectVolume = Tile.ZoneObjectCount / HIGHEST_ZONE_OBJECT_COUNT;
+	float PathDensity = FindMeasuredPathDensity(Tile.Footprint, AdjacentZones) / HIGHEST_ZONE_OBJECT_COUNT;
+
+	return (ZoneObjectVolume + PathDensity) / 2.0f + Tile.TotalZoneObjectArea;
+}
+
+float FWangTileCoefficients::FindMeasuredPathDensity(const FWangTileFootprint& Footprint, float AdjacentZones)
+{
+	return AdjacentZones * Footprint.GetMeanSideOpening() * Footprint.ChokepointWidth;
+}
+
+float FWangTileCoefficients::GetSurroundingZones(EWangTilePlacement Placement)
+{
+	switch (Placement)
+	{
+	case EWangTilePlacement::Corner:
+		return 3.0f;
+	case EWangTilePlacement::Edge:
+		return 5.0f;
+	default:
+		return 8.0f;
+	}
+}
+
+float FWangTileCoefficients::GetAdjacentZones(EWangTilePlacement Placement)
+{
+	switch (Placement)
+	{
+	case EWangTilePlacement::Corner:
+		return 2.0f;
+	case EWangTilePlacement::Edge:
+		return 3.0f;
+	default:
+		return 4.0f;
+	}
+}
+
+// As this will be decremented, then the absolute value will be obtained from this:
+float FWangTileCoefficients::FindNonAbsolutePathDensity(float AdjacentZones)
+{
+	float PathDensity = HIGHEST_ZONE_OBJECT_COUNT;
+
+	// 7 Edges are touching 2 of the Edges that matter in this case (for 2 or 3 adjacent Zones),
+	// 12 Edges are also considered to be touching the East Edge for 3 adjacent Zones, or
+	// 12 Edges are considered to be touching all 4 Edges:
+	std::vector<float> TouchingEdgeCount;
+
+	if (AdjacentZones != 4.0f)
+	{
+		TouchingEdgeCount.push_back(7.0f);
+	}
+
+	if (AdjacentZones == 3.0f || AdjacentZones == 4.0f)
+	{
+		TouchingEdgeCount.push_back(12.0f);
+	}
+
+	// To swap between the first and last Edge-Volume Values (for 3 adjacent Zones):
+	bool IsFlipFlopRequired = TouchingEdgeCount.size() > 1;
+	int FlipFlopIndex = 0;
+
+	for (int SummationCounter = 0; SummationCounter < AdjacentZones; SummationCounter++)
+	{
+		PathDensity -= TouchingEdgeCount[FlipFlopIndex];
+
+		if (IsFlipFlopRequired)
+		{
+			FlipFlopIndex = 1 - FlipFlopIndex;
+		}
+	}
+
+	return PathDensity;
+}
+
+/** For the solver's stats (plain C++, so std::chrono rather than FPlatformTime). */
+static double GetWangTileSolverSeconds()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Solver:
+
+FWangTileSolver::FWangTileSolver(std::vector<FWangTileDefinition> InTileSet)
+	: TileSet(std::move(InTileSet))
+{
+}
+
+bool FWangTileSolver::Solve(const FWangTileSolverSettings& Settings, FWangTileGrid& OutGrid)
+{
+	if (!SettingsAreValid(Settings))
+	{
+		OutGrid.Reset(0, 0);
+		return false;
+	}
+
+	PrepareCandidates(Settings);
+
+	const double PlacementStartTime = GetWangTileSolverSeconds();
+	bool Solved = SolvePrepared(Settings, OutGrid, Stats);
+
+	if (Solved && Settings.RequireConnectivity)
+	{
+		FWangTileConnectivity Connectivity(TileSet);
+		RepairConnectivity(Settings, OutGrid, Connectivity, nullptr, Stats);
+	}
+
+	Stats.PlacementSeconds = GetWangTileSolverSeconds() - PlacementStartTime;
+
+	return Solved;
+}
+
+bool FWangTileSolver::SolveBestOf(const FWangTileSolverSettings& Settings, int CandidateCount,
+	FWangTileGrid& OutGrid, FWangTileCandidateReport& OutReport)
+{
+	OutReport = FWangTileCandidateReport();
+
+	if (CandidateCount <= 0 || !SettingsAreValid(Settings))
+	{
+		OutGrid.Reset(0, 0);
+		return false;
+	}
+
+	// The candidates only differ by Seed, so they share the same prepared candidates:
+	PrepareCandidates(Settings);
+	const double PlacementStartTime = GetWangTileSolverSeconds();
+
+	std::vector<float> CandidateImbalances(CandidateCount, 0.0f);
+	std::vector<uint8_t> CandidatesConnected(CandidateCount, 1);
+	std::atomic<int> NextCandidate(0);
+	std::atomic<bool> SolveCancelled(false);
+
+	// Each worker solves whole candidates on its own (one thread each), keeping its best one:
+	const int WorkerCount = std::max(1, std::min(Settings.ThreadCount, CandidateCount));
+	std::vector<FWangTileGrid> WorkerBestGrids(WorkerCount);
+	std::vector<int> WorkerBestCandidates(WorkerCount, -1);
+	std::vector<FWangTileLayoutScore> WorkerBestScores(WorkerCount);
+	std::vector<uint8_t> WorkerBestConnected(WorkerCount, 1);
+	std::vector<FWangTileSolverStats> WorkerStats(WorkerCount);
+
+	// A connected candidate beats any that is cut off, then the most balanced wins:
+	auto IsBetterCandidate = [](bool IsConnected, float Imbalance, bool IsBestConnected, float BestImbalance)
+	{
+		return IsConnected != IsBestConnected ? IsConnected : Imbalance < BestImbalance;
+	};
+
+	RunWorkers(Settings, WorkerCount, [&](int WorkerIndex)
+	{
+		FWangTileSolverSettings CandidateSettings = Settings;
+		CandidateSettings.ThreadCount = 1;
+		CandidateSettings.ParallelFor = nullptr;
+
+		FWangTileGrid CandidateGrid;
+
+		// (Only built if it is needed, and once for each worker):
+		std::unique_ptr<FWangTileConnectivity> Connectivity;
+		if (Settings.RequireConnectivity)
+		{
+			Connectivity.reset(new FWangTileConnectivity(TileSet));
+		}
+
+		for (int Candidate = NextCandidate.fetch_add(1); Candidate < CandidateCount;
+			Candidate = NextCandidate.fetch_add(1))
+		{
+			CandidateSettings.Seed = Settings.Seed + static_cast<uint32_t>(Candidate);
+
+			if (SolveCancelled.load(std::memory_order_relaxed) ||
+				!SolvePrepared(CandidateSettings, CandidateGrid, WorkerStats[WorkerIndex]))
+			{
+				SolveCancelled.store(true);
+				return;
+			}
+
+			if (Connectivity)
+			{
+				CandidatesConnected[Candidate] = RepairConnectivity(CandidateSettings, CandidateGrid, *Connectivity,
+					nullptr, WorkerStats[WorkerIndex]);
+			}
+
+			FWangTileLayoutScore CandidateScore = ScoreLayout(CandidateGrid);
+			CandidateImbalances[Candidate] = CandidateScore.GetTotalImbalance();
+
+			// Candidates are claimed in order, so a tie goes to the earlier candidate:
+			int& BestCandidate = WorkerBestCandidates[WorkerIndex];
+			if (BestCandidate == -1 || IsBetterCandidate(CandidatesConnected[Candidate] != 0,
+				CandidateScore.GetTotalImbalance(), WorkerBestConnected[WorkerIndex] != 0,
+				WorkerBestScores[WorkerIndex].GetTotalImbalance()))
+			{
+				BestCandidate = Candidate;
+				WorkerBestScores[WorkerIndex] = CandidateScore;
+				WorkerBestConnected[WorkerIndex] = CandidatesConnected[Candidate];
+				std::swap(WorkerBestGrids[WorkerIndex], CandidateGrid);
+			}
+		}
+	});
+
+	for (const FWangTileSolverStats& CandidateStats : WorkerStats)
+	{
+		Stats.AddPlacementCounts(CandidateStats);
+	}
+
+	Stats.PlacementSeconds = GetWangTileSolverSeconds() - PlacementStartTime;
+
+	if (SolveCancelled.load())
+	{
+		OutGrid.Reset(0, 0);
+		return false;
+	}
+
+	// The best of the workers' best (the same one, however the candidates were shared out):
+	int BestWorker = -1;
+	for (int WorkerIndex = 0; WorkerIndex < WorkerCount; WorkerIndex++)
+	{
+		if (WorkerBestCandidates[WorkerIndex] == -1)
+		{
+			continue;
+		}
+
+		if (BestWorker == -1)
+		{
+			BestWorker = WorkerIndex;
+			continue;
+		}
+
+		const bool IsConnected = WorkerBestConnected[WorkerIndex] != 0;
+		const bool IsBestConnected = WorkerBestConnected[BestWorker] != 0;
+		float Imbalance = WorkerBestScores[WorkerIndex].GetTotalImbalance();
+		float BestImbalance = WorkerBestScores[BestWorker].GetTotalImbalance();
+
+		if (IsBetterCandidate(IsConnected, Imbalance, IsBestConnected, BestImbalance) ||
+			(IsConnected == IsBestConnected && Imbalance == BestImbalance &&
+			WorkerBestCandidates[WorkerIndex] < WorkerBestCandidates[BestWorker]))
+		{
+			BestWorker = WorkerIndex;
+		}
+	}
+
+	std::swap(OutGrid, WorkerBestGrids[BestWorker]);
+
+	OutReport.CandidateCount = CandidateCount;
+	OutReport.BestCandidate = WorkerBestCandidates[BestWorker];
+	OutReport.BestSeed = Settings.Seed + static_cast<uint32_t>(OutReport.BestCandidate);
+	OutReport.BestScore = WorkerBestScores[BestWorker];
+	OutReport.DisconnectedCandidates = static_cast<int>(std::count(CandidatesConnected.begin(),
+		CandidatesConnected.end(), 0));
+
+	// For the spread of the scores:
+	double ImbalanceSum = 0.0;
+	for (float Imbalance : CandidateImbalances)
+	{
+		ImbalanceSum += Imbalance;
+		OutReport.WorstImbalance = std::max(OutReport.WorstImbalance, Imbalance);
+	}
+
+	double MeanImbalance = ImbalanceSum / CandidateCount;
+	double SquaredDeviationSum = 0.0;
+	for (float Imbalance : CandidateImbalances)
+	{
+		SquaredDeviationSum += (Imbalance - MeanImbalance) * (Imbalance - MeanImbalance);
+	}
+
+	OutReport.MeanImbalance = static_cast<float>(MeanImbalance);
+	OutReport.ImbalanceStandardDeviation = static_cast<float>(std::sqrt(SquaredDeviationSum / CandidateCount));
+
+	return true;
+}
+
+bool FWangTileSolver::Resolve(const FWangTileSolverSettings& Settings, FWangTileGrid& Grid,
+	const FWangTileRect& RerollRect, const std::vector<FWangTileRect>& RefillRects, uint64_t RerollSeed,
+	std::vector<int>& OutChangedCells)
+{
+	OutChangedCells.clear();
+
+	if (!SettingsAreValid(Settings) || Grid.GetWidth() != Settings.GridWidth ||
+		Grid.GetHeight() != Settings.GridHeight || Grid.GetDepth() != Settings.GridDepth)
+	{
+		return false;
+	}
+
+	PrepareCandidates(Settings);
+
+	const double PlacementStartTime = GetWangTileSolverSeconds();
+	ResolvePrepared(Settings, Grid, RerollRect, RefillRects, RerollSeed, OutChangedCells, Stats);
+
+	if (Settings.RequireConnectivity)
+	{
+		FWangTileConnectivity Connectivity(TileSet);
+		RepairConnectivity(Settings, Grid, Connectivity, &OutChangedCells, Stats);
+
+		// (A cell may have changed more than once):
+		std::sort(OutChangedCells.begin(), OutChangedCells.end());
+		OutChangedCells.erase(std::unique(OutChangedCells.begin(), OutChangedCells.end()), OutChangedCells.end());
+	}
+
+	Stats.PlacementSeconds = GetWangTileSolverSeconds() - PlacementStartTime;
+
+	return true;
+}
+
+void FWangTileSolver::ResolvePrepared(const FWangTileSolverSettings& Settings, FWangTileGrid& Grid,
+	const FWangTileRect& RerollRect, const std::vector<FWangTileRect>& RefillRects, uint64_t RerollSeed,
+	std::vector<int>& OutChangedCells, FWangTileSolverStats& OutPlacementStats) const
+{
+	const int Width = Grid.GetWidth();
+	const int Height = Grid.GetHeight();
+
+	std::vector<FWangTileRect> EditedRects = RefillRects;
+	EditedRects.push_back(RerollRect);
+
+	// Only the rows from the first edited row can change, and after the last edited row,
+	// only while changes carry on into them (the edits are the same on every floor):
+	int FirstEditedRow = Height;
+	int LastEditedRow = 0;
+	for (const FWangTileRect& EditedRect : EditedRects)
+	{
+		if (!EditedRect.IsEmpty())
+		{
+			FirstEditedRow = std::min(FirstEditedRow, std::max(0, EditedRect.MinY));
+			LastEditedRow = std::max(LastEditedRow, std::min(Height, EditedRect.MaxY));
+		}
+	}
+
+	// For the columns that might change in this row, and the columns that did in the row to the south:
+	std::vector<int> RowCandidates;
+	std::vector<int> ChangedInSouthRow;
+	std::vector<int> ChangedInRow;
+
+	// For the columns that changed in each row of the floor below, and of this floor:
+	std::vector<std::vector<int>> ChangedBelowPerRow(Height);
+	std::vector<std::vector<int>> ChangedPerRow(Height);
+
+	for (int Z = 0; Z < Grid.GetDepth(); Z++)
+	{
+		// A changed tile may also change the tile above it:
+		int FirstRow = FirstEditedRow;
+		int LastChangedRow = LastEditedRow;
+		for (int Y = 0; Y < Height; Y++)
+		{
+			if (!ChangedBelowPerRow[Y].empty())
+			{
+				FirstRow = std::min(FirstRow, Y);
+				LastChangedRow = std::max(LastChangedRow, Y + 1);
+			}
+		}
+
+		ChangedInSouthRow.clear();
+
+		for (int Y = FirstRow; Y < Height; Y++)
+		{
+			if (Y >= LastChangedRow && ChangedInSouthRow.empty())
+			{
+				break;
+			}
+
+			RowCandidates = ChangedInSouthRow;
+			RowCandidates.insert(RowCandidates.end(), ChangedBelowPerRow[Y].begin(), ChangedBelowPerRow[Y].end());
+			for (const FWangTileRect& EditedRect : EditedRects)
+			{
+				if (Y >= EditedRect.MinY && Y < EditedRect.MaxY)
+				{
+					for (int X = std::max(0, EditedRect.MinX); X < std::min(Width, EditedRect.MaxX); X++)
+					{
+						RowCandidates.push_back(X);
+					}
+				}
+			}
+
+			std::sort(RowCandidates.begin(), RowCandidates.end());
+			RowCandidates.erase(std::unique(RowCandidates.begin(), RowCandidates.end()), RowCandidates.end());
+
+			// A changed tile may also change the tile to its east (and so on, along the row):
+			ChangedInRow.clear();
+			int EastOfChangedX = Width;
+			std::size_t CandidateIndex = 0;
+
+			while (true)
+			{
+				int NextCandidateX = CandidateIndex < RowCandidates.size() ? RowCandidates[CandidateIndex] : Width;
+				int X = std::min(NextCandidateX, EastOfChangedX);
+
+				if (X >= Width)
+				{
+					break;
+				}
+
+				if (X == NextCandidateX)
+				{
+					CandidateIndex++;
+				}
+
+				EastOfChangedX = Width;
+
+				if (ResolveCell(Settings, Grid, X, Y, Z, RerollRect, RerollSeed, OutPlacementStats))
+				{
+					ChangedInRow.push_back(X);
+					OutChangedCells.push_back(Grid.GetIndex(X, Y, Z));
+					EastOfChangedX = X + 1;
+				}
+			}
+
+			ChangedPerRow[Y] = ChangedInRow;
+			std::swap(ChangedInSouthRow, ChangedInRow);
+		}
+
+		std::swap(ChangedBelowPerRow, ChangedPerRow);
+		for (std::vector<int>& ChangedColumns : ChangedPerRow)
+		{
+			ChangedColumns.clear();
+		}
+	}
+}
+
+bool FWangTileSolver::RepairConnectivity(const FWangTileSolverSettings& Settings, FWangTileGrid& Grid,
+	FWangTileConnectivity& Connectivity, std::vector<int>* OutChangedCells, FWangTileSolverStats& OutPlacementStats) const
+{
+	std::vector<int> RepairChangedCells;
+
+	for (int RepairIndex = 0; ; RepairIndex++)
+	{
+		const FWangTileConnectivityReport& ConnectivityReport = Connectivity.Check(Grid);
+
+		if (ConnectivityReport.IsConnected())
+		{
+			return true;
+		}
+
+		if (RepairIndex >= Settings.MaxConnectivityRepairs)
+		{
+			return false;
+		}
+
+		// The smallest region, and the tiles around it (what cuts it off may be on either side of its edge):
+		const FWangTileRect& CutOffBounds = ConnectivityReport.CutOffBounds.front();
+		const FWangTileRect RepairRect(CutOffBounds.MinX - 1, CutOffBounds.MinY - 1, CutOffBounds.MaxX + 1,
+			CutOffBounds.MaxY + 1);
+		const uint64_t RepairSeed = FWangTileRandomStream::DeriveSeed(Settings.Seed,
+			CONNECTIVITY_REPAIR_STREAM_OFFSET + static_cast<uint64_t>(RepairIndex));
+
+		RepairChangedCells.clear();
+		ResolvePrepared(Settings, Grid, RepairRect, std::vector<FWangTileRect>(), RepairSeed, RepairChangedCells,
+			OutPlacementStats);
+		OutPlacementStats.ConnectivityRepairs++;
+
+		if (OutChangedCells)
+		{
+			OutChangedCells->insert(OutChangedCells->end(), RepairChangedCells.begin(), RepairChangedCells.end());
+		}
+	}
+}
+
+bool FWangTileSolver::ResolveCell(const FWangTileSolverSettings& Settings, FWangTileGrid& Grid, int X, int Y, int Z,
+	const FWangTileRect& RerollRect, uint64_t RerollSeed, FWangTileSolverStats& OutPlacementStats) const
+{
+	const int CellIndex = Grid.GetIndex(X, Y, Z);
+	FWangTileCell& Cell = Grid[CellIndex];
+	const uint16_t PreviousTileId = Cell.TileId;
+
+	if (!Grid.IsInterior(CellIndex))
+	{
+		Cell.TileId = static_cast<uint16_t>(GetBoundaryTile(Settings, X, Y));
+	}
+	else if (!Cell.IsPinned() || !Cell.HasTile())
+	{
+		const FWangTileCell& WestCell = Grid[Grid.GetWestIndex(CellIndex)];
+		const FWangTileCell& SouthCell = Grid[Grid.GetSouthIndex(CellIndex)];
+		const int VerticalClass = GetVerticalClass(Grid, CellIndex, Z);
+		const bool IsRerolled = RerollRect.Contains(X, Y);
+
+		// Keep the tile, unless it is to be rerolled or no longer suits its neighbours:
+		bool IsTileKept = false;
+		if (!IsRerolled && Cell.HasTile())
+		{
+			const FWangTileCandidateSet& Candidates = GetInteriorCandidates(WestCell, SouthCell, VerticalClass);
+			IsTileKept = FWangTileMask::ContainsTile(&CandidateMasks[Candidates.MaskStart], Cell.TileId);
+		}
+
+		if (!IsTileKept)
+		{
+			FWangTileRandomStream CellRandomStream(FWangTileRandomStream::DeriveSeed(
+				IsRerolled ? RerollSeed : Settings.Seed, static_cast<uint64_t>(CellIndex)));
+
+			Cell.TileId = static_cast<uint16_t>(GetInteriorTile(WestCell, SouthCell, VerticalClass, CellRandomStream,
+				OutPlacementStats));
+		}
+	}
+
+	return Cell.TileId != PreviousTileId;
+}
+
+FWangTileLayoutScore FWangTileSolver::ScoreLayout(const FWangTileGrid& Grid) const
+{
+	FWangTileLayoutScore Score;
+
+	// The middle row (of an odd number of rows) belongs to neither half:
+	const int HalfHeight = Grid.GetHeight() / 2;
+	const int HalfCellCount = HalfHeight * Grid.GetWidth();
+	if (HalfCellCount == 0)
+	{
+		return Score;
+	}
+
+	float SouthDefensiveness = 0.0f;
+	float NorthDefensiveness = 0.0f;
+	float SouthDispersion = 0.0f;
+	float NorthDispersion = 0.0f;
+
+	// Each half of each floor (every floor is split the same way):
+	for (int FloorStart = 0; FloorStart < Grid.GetCellCount(); FloorStart += Grid.GetFloorCellCount())
+	{
+		for (int SouthIndex = FloorStart; SouthIndex < FloorStart + HalfCellCount; SouthIndex++)
+		{
+			const FWangTileCell& Cell = Grid[SouthIndex];
+			SouthDefensiveness += GetDefensivenessCoefficient(Cell);
+			SouthDispersion += TileSet[Cell.TileId].DispersionCoefficient;
+		}
+
+		const int FloorEnd = FloorStart + Grid.GetFloorCellCount();
+		for (int NorthIndex = FloorEnd - HalfCellCount; NorthIndex < FloorEnd; NorthIndex++)
+		{
+			const FWangTileCell& Cell = Grid[NorthIndex];
+			NorthDefensiveness += GetDefensivenessCoefficient(Cell);
+			NorthDispersion += TileSet[Cell.TileId].DispersionCoefficient;
+		}
+	}
+
+	const int HalvesCellCount = HalfCellCount * Grid.GetDepth();
+	Score.DefensivenessImbalance = std::abs(SouthDefensiveness - NorthDefensiveness) / HalvesCellCount;
+	Score.DispersionImbalance = std::abs(SouthDispersion - NorthDispersion) / HalvesCellCount;
+
+	return Score;
+}
+
+bool FWangTileSolver::SolvePrepared(const FWangTileSolverSettings& Settings, FWangTileGrid& OutGrid,
+	FWangTileSolverStats& OutPlacementStats) const
+{
+	if (Settings.PropagateConstraints)
+	{
+		return SolvePropagating(Settings, OutGrid, OutPlacementStats);
+	}
+
+	OutGrid.Reset(Settings.GridWidth, Settings.GridHeight, Settings.GridDepth);
+
+	// Each row records how many of its cells have been placed, so the row to the north (and the
+	// row above) can follow just behind it (a tile only depends on the tiles to its west and south,
+	// and below it):
+	const int RowCount = OutGrid.GetHeight() * OutGrid.GetDepth();
+	std::vector<std::atomic<int>> PlacedCellsPerRow(RowCount);
+	for (std::atomic<int>& PlacedCells : PlacedCellsPerRow)
+	{
+		PlacedCells.store(0, std::memory_order_relaxed);
+	}
+
+	std::atomic<int> NextRow(0);
+	std::atomic<bool> SolveCancelled(false);
+
+	const int WorkerCount = std::max(1, std::min(Settings.ThreadCount, RowCount));
+	std::vector<FWangTileSolverStats> WorkerStats(WorkerCount);
+
+	// Rows are claimed in order (a floor at a time), so the rows each worker waits on are always being worked on:
+	auto SolveRows = [&](int WorkerIndex)
+	{
+		// Counted locally, so that the workers do not share cache lines:
+		FWangTileSolverStats RowStats;
+
+		for (int Row = NextRow.fetch_add(1); Row < RowCount; Row = NextRow.fetch_add(1))
+		{
+			if (Settings.CancellationFlag && Settings.CancellationFlag->load(std::memory_order_relaxed))
+			{
+				SolveCancelled.store(true);
+			}
+
+			if (SolveCancelled.load(std::memory_order_relaxed))
+			{
+				// Release any worker waiting on this row:
+				PlacedCellsPerRow[Row].store(OutGrid.GetWidth(), std::memory_order_release);
+				continue;
+			}
+
+			SolveRow(Settings, Row, OutGrid, PlacedCellsPerRow, SolveCancelled, RowStats);
+		}
+
+		WorkerStats[WorkerIndex] = RowStats;
+	};
+
+	RunWorkers(Settings, WorkerCount, SolveRows);
+
+	for (const FWangTileSolverStats& RowStats : WorkerStats)
+	{
+		OutPlacementStats.AddPlacementCounts(RowStats);
+	}
+
+	if (SolveCancelled.load())
+	{
+		OutGrid.Reset(0, 0);
+		return false;
+	}
+
+	return true;
+}
+
+bool FWangTileSolver::SolvePropagating(const FWangTileSolverSettings& Settings, FWangTileGrid& OutGrid,
+	FWangTileSolverStats& OutPlacementStats) const
+{
+	OutGrid.Reset(Settings.GridWidth, Settings.GridHeight, Settings.GridDepth);
+
+	for (int CellIndex = 0; CellIndex < OutGrid.GetCellCount(); CellIndex++)
+	{
+		if (!OutGrid.IsInterior(CellIndex))
+		{
+			OutGrid[CellIndex].TileId = static_cast<uint16_t>(GetBoundaryTile(Settings, OutGrid.GetX(CellIndex),
+				OutGrid.GetY(CellIndex)));
+		}
+	}
+
+	FWangTileConstraintPropagator Propagator(GetTileCount(), MaskWordCount, EastNeighbourMasks, NorthNeighbourMasks,
+		TileVerticalLinks, SelectionWeights);
+
+	if (!Propagator.Solve(Settings, OutGrid, OutPlacementStats))
+	{
+		OutGrid.Reset(0, 0);
+		return false;
+	}
+
+	return true;
+}
+
+void FWangTileSolver::RunWorkers(const FWangTileSolverSettings& Settings, int WorkerCount,
+	const std::function<void(int WorkerIndex)>& Task)
+{
+	if (WorkerCount <= 1)
+	{
+		Task(0);
+	}
+	else if (Settings.ParallelFor)
+	{
+		Settings.ParallelFor(WorkerCount, Task);
+	}
+	else
+	{
+		std::vector<std::thread> Workers;
+		for (int WorkerIndex = 1; WorkerIndex < WorkerCount; WorkerIndex++)
+		{
+			Workers.emplace_back(Task, WorkerIndex);
+		}
+
+		Task(0);
+
+		for (std::thread& Worker : Workers)
+		{
+			Worker.join();
+		}
+	}
+}
+
+/**
+* Wait until more than X cells of the given row have been placed (PlacedCells being how many were,
+* when last looked at). Returns false if the solve is cancelled first.
+*/
+static bool WaitForPlacedWangTiles(const std::vector<std::atomic<int>>& PlacedCellsPerRow, int Row, int X,
+	int& PlacedCells, const std::atomic<bool>& SolveCancelled)
+{
+	while (PlacedCells <= X)
+	{
+		PlacedCells = PlacedCellsPerRow[Row].load(std::memory_order_acquire);
+
+		if (PlacedCells <= X)
+		{
+			if (SolveCancelled.load(std::memory_order_relaxed))
+			{
+				return false;
+			}
+
+			std::this_thread::yield();
+		}
+	}
+
+	return true;
+}
+
+void FWangTileSolver::SolveRow(const FWangTileSolverSettings& Settings, int Row, FWangTileGrid& Grid,
+	std::vector<std::atomic<int>>& PlacedCellsPerRow, const std::atomic<bool>& SolveCancelled,
+	FWangTileSolverStats& WorkerStats) const
+{
+	const int Width = Grid.GetWidth();
+	const int Height = Grid.GetHeight();
+	const int Y = Row % Height;
+	const int Z = Row / Height;
+
+	// The first row (of each floor) has no row to the south to wait for, and the lowest floor has
+	// no floor below:
+	int PlacedSouthCells = Y == 0 ? Width : 0;
+	int PlacedBelowCells = Z == 0 ? Width : 0;
+
+	for (int X = 0; X < Width; X++)
+	{
+		const int CellIndex = Grid.GetIndex(X, Y, Z);
+		FWangTileCell& Cell = Grid[CellIndex];
+
+		if (Grid.IsInterior(CellIndex))
+		{
+			// Wait for the tiles to the south and below (the tile to the west was placed by this worker):
+			if (!WaitForPlacedWangTiles(PlacedCellsPerRow, Row - 1, X, PlacedSouthCells, SolveCancelled) ||
+				!WaitForPlacedWangTiles(PlacedCellsPerRow, Row - Height, X, PlacedBelowCells, SolveCancelled))
+			{
+				return;
+			}
+
+			// Each cell has its own stream, so the layout does not depend on which worker placed it:
+			FWangTileRandomStream CellRandomStream(FWangTileRandomStream::DeriveSeed(Settings.Seed,
+				static_cast<uint64_t>(CellIndex)));
+
+			Cell.TileId = static_cast<uint16_t>(GetInteriorTile(Grid[Grid.GetWestIndex(CellIndex)],
+				Grid[Grid.GetSouthIndex(CellIndex)], GetVerticalClass(Grid, CellIndex, Z), CellRandomStream,
+				WorkerStats));
+		}
+		else
+		{
+			Cell.TileId = static_cast<uint16_t>(GetBoundaryTile(Settings, X, Y));
+		}
+
+		// Let the rows to the north and above follow, every so often:
+		if ((X + 1) % ROW_PROGRESS_INTERVAL == 0)
+		{
+			PlacedCellsPerRow[Row].store(X + 1, std::memory_order_release);
+		}
+	}
+
+	PlacedCellsPerRow[Row].store(Width, std::memory_order_release);
+}
+
+float FWangTileSolver::GetDefensivenessCoefficient(const FWangTileCell& Cell) const
+{
+	return DefensivenessCoefficients[static_cast<int>(Cell.Placement) * GetTileCount() + Cell.TileId];
+}
+
+float FWangTileSolver::GetFlankingCoefficient(EWangTilePlacement Placement)
+{
+	return FWangTileCoefficients::FindFlankingCoefficient(FWangTileCoefficients::GetSurroundingZones(Placement),
+		FWangTileCoefficients::GetAdjacentZones(Placement));
+}
+
+bool FWangTileSolver::SettingsAreValid(const FWangTileSolverSettings& Settings) const
+{
+	if (Settings.GridWidth <= 0 || Settings.GridHeight <= 0 || Settings.GridDepth <= 0 || TileSet.empty() ||
+		TileSet.size() >= FWangTileCell::NO_TILE)
+	{
+		return false;
+	}
+
+	const int FixedTiles[] = { Settings.SouthWestCornerTile, Settings.SouthEastCornerTile,
+		Settings.NorthEastCornerTile, Settings.NorthWestCornerTile, Settings.NorthEdgeTile,
+		Settings.EastEdgeTile, Settings.SouthEdgeTile, Settings.WestEdgeTile };
+
+	for (int FixedTile : FixedTiles)
+	{
+		if (FixedTile < 0 || FixedTile >= GetTileCount())
+		{
+			return false;
+		}
+
+		// The corners and edges are the same on every floor, so they cannot lead to another:
+		if (Settings.GridDepth > 1 && TileSet[FixedTile].VerticalLinks != 0)
+		{
+			return false;
+		}
+	}
+
+	for (const FWangTileDefinition& Tile : TileSet)
+	{
+		for (int EdgeColour : Tile.EdgeColours)
+		{
+			if (EdgeColour >= FWangTileDefinition::MAX_EDGE_COLOUR_COUNT)
+			{
+				return false;
+			}
+		}
+	}
+
+	for (const std::vector<int>* PredefinedTiles : { &Settings.ApplicableTilesForWangTile2,
+		&Settings.ApplicableTilesForWangTile10 })
+	{
+		for (int PredefinedTile : *PredefinedTiles)
+		{
+			if (PredefinedTile < 0 || PredefinedTile >= GetTileCount())
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FWangTileSolver::UsesEdgeColours() const
+{
+	for (const FWangTileDefinition& Tile : TileSet)
+	{
+		for (int EdgeColour : Tile.EdgeColours)
+		{
+			if (EdgeColour < 0)
+			{
+				return false;
+			}
+		}
+	}
+
+	return !TileSet.empty();
+}
+
+void FWangTileSolver::PrepareCandidates(const FWangTileSolverSettings& Settings)
+{
+	const double PrepareStartTime = GetWangTileSolverSeconds();
+	Stats = FWangTileSolverStats();
+
+	const int TileCount = GetTileCount();
+	const int PlacementCount = static_cast<int>(EWangTilePlacement::Count);
+
+	DefensivenessCoefficients.assign(PlacementCount * TileCount, 0.0f);
+
+	for (int PlacementIndex = 0; PlacementIndex < PlacementCount; PlacementIndex++)
+	{
+		float AdjacentZones = FWangTileCoefficients::GetAdjacentZones(
+			static_cast<EWangTilePlacement>(PlacementIndex));
+
+		for (int Tile = 0; Tile < TileCount; Tile++)
+		{
+			DefensivenessCoefficients[PlacementIndex * TileCount + Tile] =
+				FWangTileCoefficients::FindDefensivenessCoefficient(TileSet[Tile], AdjacentZones);
+		}
+	}
+
+	DispersionCoefficients.resize(TileCount);
+	SelectionWeights.resize(TileCount);
+	for (int Tile = 0; Tile < TileCount; Tile++)
+	{
+		DispersionCoefficients[Tile] = TileSet[Tile].DispersionCoefficient;
+		SelectionWeights[Tile] = TileSet[Tile].SelectionWeight;
+	}
+
+	MaskWordCount = FWangTileMask::GetWordCount(TileCount);
+	CandidateSets.clear();
+	CandidateMasks.clear();
+	AliasEntries.clear();
+
+	PrepareVerticalClassMasks();
+
+	if (UsesEdgeColours())
+	{
+		PrepareEdgeColourCandidates();
+	}
+	else
+	{
+		PrepareCoefficientCandidates(Settings);
+	}
+
+	Stats.PrepareSeconds = GetWangTileSolverSeconds() - PrepareStartTime;
+}
+
+int FWangTileSolver::GetBoundaryTile(const FWangTileSolverSettings& Settings, int X, int Y) const
+{
+	bool IsWest = X == 0;
+	bool IsEast = X == Settings.GridWidth - 1;
+	bool IsSouth = Y == 0;
+	bool IsNorth = Y == Settings.GridHeight - 1;
+
+	// Corners first...
+	if (IsSouth && IsWest)
+	{
+		return Settings.SouthWestCornerTile;
+	}
+	else if (IsSouth && IsEast)
+	{
+		return Settings.SouthEastCornerTile;
+	}
+	else if (IsNorth && IsEast)
+	{
+		return Settings.NorthEastCornerTile;
+	}
+	else if (IsNorth && IsWest)
+	{
+		return Settings.NorthWestCornerTile;
+	}
+
+	// ...then the edges:
+	if (IsWest)
+	{
+		return Settings.WestEdgeTile;
+	}
+	else if (IsSouth)
+	{
+		return Settings.SouthEdgeTile;
+	}
+	else if (IsEast)
+	{
+		return Settings.EastEdgeTile;
+	}
+
+	return Settings.NorthEdgeTile;
+}
+
+int FWangTileSolver::GetVerticalClass(const FWangTileGrid& Grid, int CellIndex, int Z) const
+{
+	int VerticalClass = Z == Grid.GetDepth() - 1 ? VERTICAL_CLASS_TOP_FLOOR : 0;
+
+	if (Z > 0)
+	{
+		const int BelowTile = Grid[Grid.GetBelowIndex(CellIndex)].TileId;
+		if (BelowTile < GetTileCount() && (TileVerticalLinks[BelowTile] & FWangTileDefinition::VERTICAL_LINK_UP))
+		{
+			VerticalClass |= VERTICAL_CLASS_LINKED_BELOW;
+		}
+	}
+
+	return VerticalClass;
+}
+
+void FWangTileSolver::PrepareVerticalClassMasks()
+{
+	const int TileCount = GetTileCount();
+	bool IsAnyTileLinkedUp = false;
+
+	TileVerticalLinks.resize(TileCount);
+	for (int Tile = 0; Tile < TileCount; Tile++)
+	{
+		TileVerticalLinks[Tile] = TileSet[Tile].VerticalLinks;
+		IsAnyTileLinkedUp = IsAnyTileLinkedUp || TileSet[Tile].LinksUp();
+	}
+
+	VerticalClassMasks.assign(VERTICAL_CLASS_COUNT * MaskWordCount, 0);
+
+	for (int VerticalClass = 0; VerticalClass < VERTICAL_CLASS_COUNT; VerticalClass++)
+	{
+		const bool IsLinkedBelow = (VerticalClass & VERTICAL_CLASS_LINKED_BELOW) != 0;
+		const bool IsTopFloor = (VerticalClass & VERTICAL_CLASS_TOP_FLOOR) != 0;
+		uint64_t* VerticalClassMask = &VerticalClassMasks[VerticalClass * MaskWordCount];
+
+		// A tile leads down exactly where the tile below it leads up, and never leads up from the top floor:
+		for (int Tile = 0; Tile < TileCount; Tile++)
+		{
+			if (TileSet[Tile].LinksDown() == IsLinkedBelow && !(IsTopFloor && TileSet[Tile].LinksUp()))
+			{
+				FWangTileMask::AddTile(VerticalClassMask, Tile);
+			}
+		}
+
+		// (A cell is only linked below if some tile leads up):
+		if ((IsAnyTileLinkedUp || !IsLinkedBelow) && FWangTileMask::CountTiles(VerticalClassMask, MaskWordCount) == 0)
+		{
+			Stats.VerticalLinkFallbacks++;
+		}
+	}
+}
+
+void FWangTileSolver::PrepareCoefficientCandidates(const FWangTileSolverSettings& Settings)
+{
+	const int TileCount = GetTileCount();
+	const int PlacementCount = static_cast<int>(EWangTilePlacement::Count);
+
+	// The tiles that may follow each placed tile only depend on that tile and its placement,
+	// so they are found once per solve, instead of once per cell:
+	std::vector<uint64_t> ApplicableTileMasks(PlacementCount * TileCount * MaskWordCount, 0);
+	const float* InteriorDefensiveness = &DefensivenessCoefficients[
+		static_cast<int>(EWangTilePlacement::Interior) * TileCount];
+
+	// Only two masks follow from the threshold, so compare against it just twice:
+	std::vector<uint64_t> BelowThresholdMask(MaskWordCount);
+	std::vector<uint64_t> AboveThresholdMask(MaskWordCount);
+	FWangTileMask::Compare(InteriorDefensiveness, TileCount, EWangTileComparison::LessOrEqual,
+		Settings.DefensivenessThreshold, BelowThresholdMask.data());
+	FWangTileMask::Compare(InteriorDefensiveness, TileCount, EWangTileComparison::GreaterOrEqual,
+		Settings.DefensivenessThreshold, AboveThresholdMask.data());
+
+	for (int PlacementIndex = 0; PlacementIndex < PlacementCount; PlacementIndex++)
+	{
+		for (int PlacedTile = 0; PlacedTile < TileCount; PlacedTile++)
+		{
+			uint64_t* Applicable = &ApplicableTileMasks[(PlacementIndex * TileCount + PlacedTile) * MaskWordCount];
+			float PlacedDefensiveness = DefensivenessCoefficients[PlacementIndex * TileCount + PlacedTile];
+
+			// WangTile2 and WangTile10 use their pre-defined sets:
+			if (PlacedTile == Settings.WangTile2 || PlacedTile == Settings.WangTile10)
+			{
+				for (int Tile : PlacedTile == Settings.WangTile2 ? Settings.ApplicableTilesForWangTile2
+					: Settings.ApplicableTilesForWangTile10)
+				{
+					FWangTileMask::AddTile(Applicable, Tile);
+				}
+			}
+			else
+			{
+				// If the placed tile's Defensiveness is greater than or equal to the
+				// threshold, find a tile with a Defensiveness less than or equal to the
+				// threshold and vice versa:
+				bool IsGreaterThanThreshold = PlacedDefensiveness >= Settings.DefensivenessThreshold;
+				std::copy(IsGreaterThanThreshold ? BelowThresholdMask.begin() : AboveThresholdMask.begin(),
+					IsGreaterThanThreshold ? BelowThresholdMask.end() : AboveThresholdMask.end(), Applicable);
+			}
+
+			// Otherwise, choose a tile with a lower Dispersion Coefficient than the placed tile...
+			if (FWangTileMask::CountTiles(Applicable, MaskWordCount) == 0)
+			{
+				Stats.DispersionFallbacks++;
+				FWangTileMask::Compare(DispersionCoefficients.data(), TileCount, EWangTileComparison::Less,
+					DispersionCoefficients[PlacedTile], Applicable);
+			}
+
+			// ...and if there is none, any tile will do:
+			if (FWangTileMask::CountTiles(Applicable, MaskWordCount) == 0)
+			{
+				Stats.AnyTileFallbacks++;
+
+				for (int Tile = 0; Tile < TileCount; Tile++)
+				{
+					FWangTileMask::AddTile(Applicable, Tile);
+				}
+			}
+		}
+	}
+
+	EastNeighbourMasks = ApplicableTileMasks;
+	NorthNeighbourMasks = ApplicableTileMasks;
+
+	// Many placed tiles share a mask (every tile on the same side of the threshold does), so
+	// find the id of each distinct mask:
+	std::map<std::vector<uint64_t>, int> MaskIds;
+	std::vector<const uint64_t*> DistinctMasks;
+	std::vector<int> ApplicableMaskIds(PlacementCount * TileCount);
+
+	for (int PlacedTileIndex = 0; PlacedTileIndex < PlacementCount * TileCount; PlacedTileIndex++)
+	{
+		const uint64_t* Applicable = &ApplicableTileMasks[PlacedTileIndex * MaskWordCount];
+		auto FoundMask = MaskIds.emplace(std::vector<uint64_t>(Applicable, Applicable + MaskWordCount),
+			static_cast<int>(DistinctMasks.size()));
+
+		if (FoundMask.second)
+		{
+			DistinctMasks.push_back(Applicable);
+		}
+
+		ApplicableMaskIds[PlacedTileIndex] = FoundMask.first->second;
+	}
+
+	const int DistinctMaskCount = static_cast<int>(DistinctMasks.size());
+
+	WestCandidateRows.resize(PlacementCount * TileCount);
+	SouthCandidateColumns.resize(PlacementCount * TileCount);
+	for (int PlacedTileIndex = 0; PlacedTileIndex < PlacementCount * TileCount; PlacedTileIndex++)
+	{
+		WestCandidateRows[PlacedTileIndex] = ApplicableMaskIds[PlacedTileIndex] * DistinctMaskCount;
+		SouthCandidateColumns[PlacedTileIndex] = ApplicableMaskIds[PlacedTileIndex];
+	}
+
+	// Then the candidates for each pair of masks (many pairs share the same candidates, too):
+	std::map<std::vector<uint64_t>, int> CandidateSetIdsByMask[3];
+	std::vector<uint64_t> BothApplicable(MaskWordCount);
+
+	CandidatePairCount = DistinctMaskCount * DistinctMaskCount;
+	CandidateSetIds.assign(VERTICAL_CLASS_COUNT * CandidatePairCount, 0);
+
+	for (int WestMaskId = 0; WestMaskId < DistinctMaskCount; WestMaskId++)
+	{
+		for (int SouthMaskId = 0; SouthMaskId < DistinctMaskCount; SouthMaskId++)
+		{
+			// Prefer a tile that suits both neighbours, then one that suits the tile to the west:
+			const bool IsWestOnly = FWangTileMask::Intersect(DistinctMasks[WestMaskId], DistinctMasks[SouthMaskId],
+				MaskWordCount, BothApplicable.data()) == 0;
+			const uint64_t* Candidates = IsWestOnly ? DistinctMasks[WestMaskId] : BothApplicable.data();
+
+			AddVerticalCandidateSets(WestMaskId * DistinctMaskCount + SouthMaskId, Candidates, DistinctMasks[WestMaskId],
+				IsWestOnly, CandidateSetIdsByMask);
+		}
+	}
+}
+
+void FWangTileSolver::PrepareEdgeColourCandidates()
+{
+	const int TileCount = GetTileCount();
+	const int PlacementCount = static_cast<int>(EWangTilePlacement::Count);
+
+	int EdgeColourCount = 0;
+	for (const FWangTileDefinition& Tile : TileSet)
+	{
+		for (int EdgeColour : Tile.EdgeColours)
+		{
+			EdgeColourCount = std::max(EdgeColourCount, EdgeColour + 1);
+		}
+	}
+
+	// For the tiles with each colour on their west side, and on their south side:
+	std::vector<uint64_t> WestColourMasks(EdgeColourCount * MaskWordCount, 0);
+	std::vector<uint64_t> SouthColourMasks(EdgeColourCount * MaskWordCount, 0);
+	std::vector<uint64_t> AnyTileMask(MaskWordCount, 0);
+
+	for (int Tile = 0; Tile < TileCount; Tile++)
+	{
+		FWangTileMask::AddTile(&WestColourMasks[TileSet[Tile].GetEdgeColour(EWangTileSide::West) * MaskWordCount], Tile);
+		FWangTileMask::AddTile(&SouthColourMasks[TileSet[Tile].GetEdgeColour(EWangTileSide::South) * MaskWordCount], Tile);
+		FWangTileMask::AddTile(AnyTileMask.data(), Tile);
+	}
+
+	// A tile must match the east side of the tile to its west, and the north side of the tile to
+	// its south (whatever their placement):
+	WestCandidateRows.resize(PlacementCount * TileCount);
+	SouthCandidateColumns.resize(PlacementCount * TileCount);
+	EastNeighbourMasks.resize(PlacementCount * TileCount * MaskWordCount);
+	NorthNeighbourMasks.resize(PlacementCount * TileCount * MaskWordCount);
+
+	for (int PlacedTileIndex = 0; PlacedTileIndex < PlacementCount * TileCount; PlacedTileIndex++)
+	{
+		const FWangTileDefinition& PlacedTile = TileSet[PlacedTileIndex % TileCount];
+		WestCandidateRows[PlacedTileIndex] = PlacedTile.GetEdgeColour(EWangTileSide::East) * EdgeColourCount;
+		SouthCandidateColumns[PlacedTileIndex] = PlacedTile.GetEdgeColour(EWangTileSide::North);
+
+		const uint64_t* EastMatching = &WestColourMasks[PlacedTile.GetEdgeColour(EWangTileSide::East) * MaskWordCount];
+		const uint64_t* NorthMatching = &SouthColourMasks[PlacedTile.GetEdgeColour(EWangTileSide::North) * MaskWordCount];
+		std::copy(EastMatching, EastMatching + MaskWordCount, &EastNeighbourMasks[PlacedTileIndex * MaskWordCount]);
+		std::copy(NorthMatching, NorthMatching + MaskWordCount, &NorthNeighbourMasks[PlacedTileIndex * MaskWordCount]);
+	}
+
+	std::map<std::vector<uint64_t>, int> CandidateSetIdsByMask[3];
+	std::vector<uint64_t> BothMatching(MaskWordCount);
+
+	CandidatePairCount = EdgeColourCount * EdgeColourCount;
+	CandidateSetIds.assign(VERTICAL_CLASS_COUNT * CandidatePairCount, 0);
+
+	for (int WestColour = 0; WestColour < EdgeColourCount; WestColour++)
+	{
+		const uint64_t* WestMatching = &WestColourMasks[WestColour * MaskWordCount];
+
+		for (int SouthColour = 0; SouthColour < EdgeColourCount; SouthColour++)
+		{
+			// Prefer a tile that matches both neighbours, then one that matches the tile to the west...
+			const bool IsWestOnly = FWangTileMask::Intersect(WestMatching, &SouthColourMasks[SouthColour * MaskWordCount],
+				MaskWordCount, BothMatching.data()) == 0;
+			const uint64_t* Candidates = IsWestOnly ? WestMatching : BothMatching.data();
+
+			// ...and if there is none, any tile will do:
+			if (IsWestOnly && FWangTileMask::CountTiles(Candidates, MaskWordCount) == 0)
+			{
+				Stats.AnyTileFallbacks++;
+				Candidates = AnyTileMask.data();
+			}
+
+			AddVerticalCandidateSets(WestColour * EdgeColourCount + SouthColour, Candidates, WestMatching, IsWestOnly,
+				CandidateSetIdsByMask);
+		}
+	}
+}
+
+void FWangTileSolver::AddVerticalCandidateSets(int PairIndex, const uint64_t* Candidates, const uint64_t* WestCandidates,
+	bool IsWestOnly, std::map<std::vector<uint64_t>, int>* CandidateSetIdsByMask)
+{
+	std::vector<uint64_t> VerticalCandidates(MaskWordCount);
+
+	for (int VerticalClass = 0; VerticalClass < VERTICAL_CLASS_COUNT; VerticalClass++)
+	{
+		const uint64_t* VerticalClassMask = &VerticalClassMasks[VerticalClass * MaskWordCount];
+		const uint64_t* ClassCandidates = Candidates;
+		bool IsClassWestOnly = IsWestOnly;
+		bool IsClassVerticalOnly = false;
+
+		// (With no stair or ramp tiles, every candidate suits every floor, so the candidates stay as they are):
+		if (FWangTileMask::Intersect(Candidates, VerticalClassMask, MaskWordCount, VerticalCandidates.data()) > 0)
+		{
+			ClassCandidates = VerticalCandidates.data();
+		}
+		else if (!IsWestOnly && FWangTileMask::Intersect(WestCandidates, VerticalClassMask, MaskWordCount,
+			VerticalCandidates.data()) > 0)
+		{
+			ClassCandidates = VerticalCandidates.data();
+			IsClassWestOnly = true;
+		}
+		else if (FWangTileMask::CountTiles(VerticalClassMask, MaskWordCount) > 0)
+		{
+			ClassCandidates = VerticalClassMask;
+			IsClassWestOnly = false;
+			IsClassVerticalOnly = true;
+		}
+
+		CandidateSetIds[VerticalClass * CandidatePairCount + PairIndex] = FindOrAddCandidateSet(ClassCandidates,
+			IsClassWestOnly, IsClassVerticalOnly, CandidateSetIdsByMask[IsClassVerticalOnly ? 2 : IsClassWestOnly]);
+	}
+}
+
+int FWangTileSolver::FindOrAddCandidateSet(const uint64_t* Candidates, bool IsWestOnly, bool IsVerticalOnly,
+	std::map<std::vector<uint64_t>, int>& CandidateSetIdsByMask)
+{
+	auto FoundCandidateSet = CandidateSetIdsByMask.emplace(std::vector<uint64_t>(Candidates,
+		Candidates + MaskWordCount), static_cast<int>(CandidateSets.size()));
+
+	if (FoundCandidateSet.second)
+	{
+		FWangTileCandidateSet CandidateSet;
+		CandidateSet.TileCount = FWangTileMask::CountTiles(Candidates, MaskWordCount);
+		CandidateSet.IsWestOnly = IsWestOnly;
+		CandidateSet.IsVerticalOnly = IsVerticalOnly;
+		CandidateSet.MaskStart = static_cast<int>(CandidateMasks.size());
+		CandidateSet.AliasTableStart = static_cast<int>(AliasEntries.size());
+
+		CandidateMasks.insert(CandidateMasks.end(), Candidates, Candidates + MaskWordCount);
+		FWangTileAliasTable::Build(Candidates, MaskWordCount, SelectionWeights.data(), AliasEntries);
+		CandidateSets.push_back(CandidateSet);
+	}
+
+	return FoundCandidateSet.first->second;
+}
+
+const FWangTileCandidateSet& FWangTileSolver::GetInteriorCandidates(const FWangTileCell& WestCell,
+	const FWangTileCell& SouthCell, int VerticalClass) const
+{
+	const int TileCount = GetTileCount();
+
+	// One lookup, whether the tiles are matched by their Coefficients or their edge colours:
+	return CandidateSets[CandidateSetIds[VerticalClass * CandidatePairCount +
+		WestCandidateRows[static_cast<int>(WestCell.Placement) * TileCount + WestCell.TileId] +
+		SouthCandidateColumns[static_cast<int>(SouthCell.Placement) * TileCount + SouthCell.TileId]]];
+}
+
+int FWangTileSolver::GetInteriorTile(const FWangTileCell& WestCell, const FWangTileCell& SouthCell, int VerticalClass,
+	FWangTileRandomStream& CellRandomStream, FWangTileSolverStats& WorkerStats) const
+{
+	const FWangTileCandidateSet& Candidates = GetInteriorCandidates(WestCell, SouthCell, VerticalClass);
+
+	WorkerStats.CandidatesConsidered += Candidates.TileCount;
+	if (Candidates.IsWestOnly)
+	{
+		WorkerStats.WestOnlyFallbacks++;
+	}
+	else if (Candidates.IsVerticalOnly)
+	{
+		WorkerStats.VerticalOnlyFallbacks++;
+	}
+
+	// Weighted by each tile's SelectionWeight (with equal weights, each column is just its own tile):
+	return FWangTileAliasTable::Pick(&AliasEntries[Candidates.AliasTableStart], Candidates.TileCount,
+		CellRandomStream);
+}
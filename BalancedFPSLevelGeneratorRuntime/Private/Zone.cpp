@@ -0,0 +1,284 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Zone.h"
+#include "Runtime/Engine/Classes/Kismet/GameplayStatics.h"
+#include "Runtime/Engine/Classes/Components/StaticMeshComponent.h"
+// For profiling the Zone Blueprints:
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/StaticMesh.h"
+#include "WangTileOccupancy.h"
+
+
+// Initialise:
+AZone::AZone()
+{
+	DefensivenessCoefficient = 0.0f;
+	FlankingCoefficient = 0.0f;
+	DispersionCoefficient = 0.0f;
+	SelectionWeight = 1.0f;
+	bLeadsUp = false;
+	bLeadsDown = false;
+
+	// One Edge for each side:
+	const FName ZoneEdgeNames[] = { "NorthEdge", "EastEdge", "SouthEdge", "WestEdge" };
+
+	for (int EdgeIndex = 0; EdgeIndex < DEFAULT_ZONE_EDGE_COUNT; EdgeIndex++)
+	{
+		UFPSLevelGeneratorEdge* ZoneEdge = CreateDefaultSubobject<UFPSLevelGeneratorEdge>(ZoneEdgeNames[EdgeIndex]);
+		ZoneEdge->Side = static_cast<EZoneEdgeSide>(EdgeIndex);
+		ZoneEdges.Add(ZoneEdge);
+	}
+}
+
+// Initialise what the constructor is not able to:
+void AZone::InitialiseZone()
+{
+	// For setting-up zone objects:
+	TArray<UActorComponent*> ZoneComponents = GetComponentsByClass(UStaticMeshComponent::StaticClass());
+
+	for (int Iterator = 0; Iterator < ZoneComponents.Num(); Iterator++)
+	{
+		ZoneObjects.Add(Cast<UStaticMeshComponent>(ZoneComponents[Iterator]));
+	}
+
+	// Now the instance has all the objects in the Zone,
+	// it is now possible to determine the proper colour
+	// of this Zone's Edges:
+	DetermineInitialZoneValues();
+
+	// (As its Blueprint's profile is measured, with each object relative to this Zone):
+	TArray<FZoneObjectTemplate> ZoneObjectTemplates;
+	for (const UStaticMeshComponent* ZoneObject : ZoneObjects)
+	{
+		FZoneObjectTemplate ZoneObjectTemplate;
+		ZoneObjectTemplate.Template = ZoneObject;
+		ZoneObjectTemplate.ZoneObjectTransform = ZoneObject->GetComponentTransform().GetRelativeTransform(GetActorTransform());
+		ZoneObjectTemplates.Add(ZoneObjectTemplate);
+	}
+
+	Footprint = MeasureZoneFootprint(ZoneObjectTemplates);
+}
+
+// Get functions:
+
+float AZone::GetDefensivenessCoefficient()
+{
+	return DefensivenessCoefficient;
+}
+
+float AZone::GetFlankingCoefficient()
+{
+	return FlankingCoefficient;
+}
+
+float AZone::GetDispersonCoefficient()
+{
+	return DispersionCoefficient;
+}
+
+int AZone::GetZoneObjectCount()
+{
+	return ZoneObjects.Num();
+}
+
+float AZone::GetTotalZoneObjectArea()
+{
+	float TotalZoneObjectArea = 0.0f;
+	for (UStaticMeshComponent* CurrentZoneObject : ZoneObjects)
+	{
+		TotalZoneObjectArea += GetZoneObjectArea(CurrentZoneObject);
+	}
+
+	return TotalZoneObjectArea;
+}
+
+int AZone::GetWangTileIndex()
+{
+	const FName WangTileTags[] = { WANG_TILE_ONE, WANG_TILE_TWO, WANG_TILE_THREE, WANG_TILE_FOUR,
+		WANG_TILE_FIVE, WANG_TILE_SIX, WANG_TILE_SEVEN, WANG_TILE_EIGHT, WANG_TILE_NINE, WANG_TILE_TEN,
+		WANG_TILE_ELEVEN, WANG_TILE_TWELVE, WANG_TILE_THIRTEEN, WANG_TILE_FOURTEEN, WANG_TILE_FIFTHTEEN,
+		WANG_TILE_SIXTEEN, WANG_TILE_SEVENTEEN, WANG_TILE_EIGHTTEEN, WANG_TILE_NINETEEN, WANG_TILE_TWENTY,
+		WANG_TILE_TWENTY_ONE, WANG_TILE_TWENTY_TWO };
+
+	for (int TagIndex = 0; TagIndex < ARRAY_COUNT(WangTileTags); TagIndex++)
+	{
+		if (Tags.Contains(WangTileTags[TagIndex]))
+		{
+			return TagIndex;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+// Check to see what Zone this is, then set this Zone's values accordingly:
+void AZone::DetermineInitialZoneValues()
+{
+	DispersionCoefficient = GetDispersionCoefficientForWangTileIndex(GetWangTileIndex());
+}
+
+FZoneProfile AZone::BuildZoneProfile(UClass* ZoneClass, int WangTileIndex)
+{
+	FZoneProfile ZoneProfile;
+	ZoneProfile.DispersionCoefficient = GetDispersionCoefficientForWangTileIndex(WangTileIndex);
+
+	// Sanity check:
+	if (!ZoneClass)
+	{
+		return ZoneProfile;
+	}
+
+	const AZone* DefaultZone = ZoneClass->GetDefaultObject<AZone>();
+	ZoneProfile.SelectionWeight = DefaultZone->SelectionWeight;
+	ZoneProfile.VerticalLinks = (DefaultZone->bLeadsUp ? FWangTileDefinition::VERTICAL_LINK_UP : 0) |
+		(DefaultZone->bLeadsDown ? FWangTileDefinition::VERTICAL_LINK_DOWN : 0);
+
+	for (const UFPSLevelGeneratorEdge* ZoneEdge : DefaultZone->ZoneEdges)
+	{
+		if (ZoneEdge)
+		{
+			ZoneProfile.EdgeColours[static_cast<int>(ZoneEdge->Side)] = ZoneEdge->EdgeColour;
+		}
+	}
+
+	TArray<FZoneObjectTemplate> ZoneObjectTemplates;
+	GetZoneObjectTemplates(ZoneClass, ZoneObjectTemplates);
+
+	for (const FZoneObjectTemplate& ZoneObjectTemplate : ZoneObjectTemplates)
+	{
+		ZoneProfile.ZoneObjectCount++;
+		ZoneProfile.TotalZoneObjectArea += GetZoneObjectArea(ZoneObjectTemplate.Template);
+	}
+
+	ZoneProfile.Footprint = MeasureZoneFootprint(ZoneObjectTemplates);
+
+	return ZoneProfile;
+}
+
+void AZone::GetZoneObjectTemplates(UClass* ZoneClass, TArray<FZoneObjectTemplate>& OutZoneObjectTemplates)
+{
+	OutZoneObjectTemplates.Reset();
+
+	// Sanity check:
+	if (!ZoneClass)
+	{
+		return;
+	}
+
+	// The native components (held by the class default object)...
+	const AZone* DefaultZone = ZoneClass->GetDefaultObject<AZone>();
+	TArray<UActorComponent*> NativeComponents = DefaultZone->GetComponentsByClass(UStaticMeshComponent::StaticClass());
+
+	for (UActorComponent* NativeComponent : NativeComponents)
+	{
+		FZoneObjectTemplate ZoneObjectTemplate;
+		ZoneObjectTemplate.Template = Cast<UStaticMeshComponent>(NativeComponent);
+
+		// (The root component is placed at the Zone's own transform):
+		if (NativeComponent != DefaultZone->GetRootComponent())
+		{
+			ZoneObjectTemplate.ZoneObjectTransform = ZoneObjectTemplate.Template->GetRelativeTransform();
+		}
+
+		OutZoneObjectTemplates.Add(ZoneObjectTemplate);
+	}
+
+	// ...and those added in the components panel, of this Blueprint and any it derives from:
+	for (UBlueprintGeneratedClass* BlueprintClass = Cast<UBlueprintGeneratedClass>(ZoneClass); BlueprintClass;
+		BlueprintClass = Cast<UBlueprintGeneratedClass>(BlueprintClass->GetSuperClass()))
+	{
+		const USimpleConstructionScript* ConstructionScript = BlueprintClass->SimpleConstructionScript;
+
+		if (!ConstructionScript)
+		{
+			continue;
+		}
+
+		for (USCS_Node* ComponentNode : ConstructionScript->GetAllNodes())
+		{
+			FZoneObjectTemplate ZoneObjectTemplate;
+			ZoneObjectTemplate.Template = Cast<UStaticMeshComponent>(ComponentNode->ComponentTemplate);
+
+			if (!ZoneObjectTemplate.Template)
+			{
+				continue;
+			}
+
+			// Up through the components it is attached to (each relative to the next), to the root:
+			for (USCS_Node* AttachedNode = ComponentNode; AttachedNode && !ConstructionScript->GetRootNodes().Contains(AttachedNode);
+				AttachedNode = ConstructionScript->FindParentNode(AttachedNode))
+			{
+				if (const USceneComponent* AttachedTemplate = Cast<USceneComponent>(AttachedNode->ComponentTemplate))
+				{
+					ZoneObjectTemplate.ZoneObjectTransform = ZoneObjectTemplate.ZoneObjectTransform *
+						AttachedTemplate->GetRelativeTransform();
+				}
+			}
+
+			OutZoneObjectTemplates.Add(ZoneObjectTemplate);
+		}
+	}
+}
+
+FWangTileFootprint AZone::MeasureZoneFootprint(const TArray<FZoneObjectTemplate>& ZoneObjectTemplates)
+{
+	FWangTileOccupancy ZoneOccupancy;
+	const float ZoneFootprintWidth = 2.0f * ZONE_FOOTPRINT_HALF_WIDTH;
+
+	for (const FZoneObjectTemplate& ZoneObjectTemplate : ZoneObjectTemplates)
+	{
+		const UStaticMesh* ZoneObjectMesh = ZoneObjectTemplate.Template->GetStaticMesh();
+
+		// Only what players collide with is in the way:
+		if (!ZoneObjectMesh || ZoneObjectTemplate.Template->GetCollisionEnabled() == ECollisionEnabled::NoCollision)
+		{
+			continue;
+		}
+
+		const FBox ZoneObjectBounds = ZoneObjectMesh->GetBoundingBox().TransformBy(ZoneObjectTemplate.ZoneObjectTransform);
+
+		// Into tile space, from the south-west corner (the Zone's -X, +Y corner):
+		ZoneOccupancy.AddBox((ZoneObjectBounds.Min.X + ZONE_FOOTPRINT_HALF_WIDTH) / ZoneFootprintWidth,
+			(ZONE_FOOTPRINT_HALF_WIDTH - ZoneObjectBounds.Max.Y) / ZoneFootprintWidth,
+			(ZoneObjectBounds.Max.X + ZONE_FOOTPRINT_HALF_WIDTH) / ZoneFootprintWidth,
+			(ZONE_FOOTPRINT_HALF_WIDTH - ZoneObjectBounds.Min.Y) / ZoneFootprintWidth);
+	}
+
+	return ZoneOccupancy.Measure();
+}
+
+float AZone::GetDispersionCoefficientForWangTileIndex(int WangTileIndex)
+{
+	// Dispersion Coefficient is precise to 2 decimal places (from WangTile1 to WangTile22):
+	const float WangTileDispersionCoefficients[] = { 0.230f, 0.50f, 0.250f, 0.250f, 0.250f, 0.250f,
+		1.0f, 0.140f, 0.130f, 0.50f, 0.150f, 1.0f, 0.140f, 0.240f, 0.240f, 0.240f, 0.170f, 0.150f,
+		1.0f, 1.0f, 1.0f, 1.0f };
+
+	if (WangTileIndex < 0 || WangTileIndex >= ARRAY_COUNT(WangTileDispersionCoefficients))
+	{
+		return 0.0f;
+	}
+
+	return WangTileDispersionCoefficients[WangTileIndex];
+}
+
+float AZone::GetZoneObjectArea(const UStaticMeshComponent* ZoneObject)
+{
+	const FVector ZoneObjectScale = ZoneObject->GetRelativeTransform().GetScale3D();
+	return ZoneObjectScale.X * ZoneObjectScale.Y;
+}
+
+// As per the equations detailed in the report (shared with the level generator's solver):
+void AZone::DetermineDefensivenessAndFlankingCoefficients(float SurroundingZones,
+	float AdjacentZones)
+{
+	FWangTileDefinition ZoneTile;
+	ZoneTile.ZoneObjectCount = GetZoneObjectCount();
+	ZoneTile.TotalZoneObjectArea = GetTotalZoneObjectArea();
+	ZoneTile.Footprint = Footprint;
+
+	FlankingCoefficient = FWangTileCoefficients::FindFlankingCoefficient(SurroundingZones, AdjacentZones);
+	DefensivenessCoefficient = FWangTileCoefficients::FindDefensivenessCoefficient(ZoneTile, AdjacentZones);
+}
@@ -0,0 +1,374 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ZoneArenaGenerator.h"
+#include "ZoneTileSet.h"
+#include "ZoneLayoutFile.h"
+#include "ZoneMeshMerge.h"
+#include "InstancedStaticMeshActor.h"
+#include "WangTileSolver.h"
+#include "Engine/World.h"
+#include "UObject/ConstructorHelpers.h"
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogZoneArenaGenerator, Log, All);
+
+// Initialise:
+AZoneArenaGenerator::AZoneArenaGenerator()
+{
+	// Only ticks while an arena is being spawned:
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	for (int WangTileIndex = 0; WangTileIndex < FZoneTileSet::ZONE_BLUEPRINT_COUNT; WangTileIndex++)
+	{
+		ConstructorHelpers::FClassFinder<AZone> ZoneClassFinder(*FZoneTileSet::GetZoneClassPath(WangTileIndex));
+		ZoneClasses.Add(ZoneClassFinder.Class);
+	}
+
+	ArenaSizeInTiles = FIntPoint(64, 64);
+	FloorCount = 1;
+	FloorHeight = 400.0f;
+	Seed = 0;
+	bPropagateConstraints = false;
+	bRequireConnectivity = false;
+	bGenerateOnBeginPlay = true;
+	bMergeZoneMeshes = true;
+	SpawnBudgetMilliseconds = 8.0f;
+	LatencyBudgetSeconds = 5.0f;
+
+	PendingCellIndex = 0;
+	GenerationStartTime = 0.0;
+	SpawnStartTime = 0.0;
+}
+
+void AZoneArenaGenerator::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bGenerateOnBeginPlay && HasAuthority())
+	{
+		GenerateArena(Seed);
+	}
+}
+
+bool AZoneArenaGenerator::GenerateArena(int32 NewSeed)
+{
+	// Only one arena can be generated at a time (and only where it is authoritative):
+	if (!HasAuthority() || IsGeneratingArena())
+	{
+		return false;
+	}
+
+	std::vector<FWangTileDefinition> ZoneTileSet;
+	if (!GatherZoneTileSet(ZoneTileSet))
+	{
+		return false;
+	}
+
+	Seed = NewSeed;
+	BeginGeneration();
+
+	FWangTileSolverSettings SolverSettings;
+	SolverSettings.GridWidth = ArenaSizeInTiles.X;
+	SolverSettings.GridHeight = ArenaSizeInTiles.Y;
+	SolverSettings.GridDepth = FMath::Max(1, FloorCount);
+	SolverSettings.Seed = static_cast<uint32>(Seed);
+	SolverSettings.PropagateConstraints = bPropagateConstraints;
+	SolverSettings.RequireConnectivity = bRequireConnectivity;
+	SolverSettings.CancellationFlag = PendingGenerationCancelled.Get();
+	FZoneTileSet::ApplyPlacementRules(SolverSettings);
+
+	// The solver only works on its own copies of the tile-set and settings, and the shared layout
+	// (the cancellation flag is captured so that it outlives the solve):
+	TSharedPtr<FWangTileGrid, ESPMode::ThreadSafe> ArenaLayout = PendingArenaLayout;
+	TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe> GenerationCancelled = PendingGenerationCancelled;
+
+	PendingArenaSolve = Async<bool>(EAsyncExecution::ThreadPool,
+		[ZoneTileSet, SolverSettings, ArenaLayout, GenerationCancelled]()
+		{
+			FWangTileSolver ArenaSolver(ZoneTileSet);
+			return ArenaSolver.Solve(SolverSettings, *ArenaLayout);
+		});
+
+	SetActorTickEnabled(true);
+	return true;
+}
+
+bool AZoneArenaGenerator::LoadArena(const FString& LayoutFilename)
+{
+	if (!HasAuthority() || IsGeneratingArena())
+	{
+		return false;
+	}
+
+	std::vector<FWangTileDefinition> ZoneTileSet;
+	FWangTileLayoutHeader LayoutHeader;
+	if (!GatherZoneTileSet(ZoneTileSet) || !FZoneLayoutFile::LoadLayoutHeader(LayoutFilename, LayoutHeader))
+	{
+		UE_LOG(LogZoneArenaGenerator, Error, TEXT("%s could not read the Zone layout in %s."), *GetName(), *LayoutFilename);
+		return false;
+	}
+
+	// A layout is only the indices of its Zones, so they must still be the same Zones:
+	if (LayoutHeader.TileSetHash != FWangTileLayoutFile::ComputeTileSetHash(ZoneTileSet))
+	{
+		UE_LOG(LogZoneArenaGenerator, Error, TEXT("%s was saved with different Zone Blueprints (its Seed, %u, can be generated instead)."),
+			*LayoutFilename, LayoutHeader.Seed);
+		return false;
+	}
+
+	Seed = static_cast<int32>(LayoutHeader.Seed);
+	ArenaSizeInTiles = FIntPoint(LayoutHeader.Width, LayoutHeader.Height);
+	FloorCount = LayoutHeader.Depth;
+	BeginGeneration();
+
+	// Read off the game thread (as a layout is solved), then spawned as usual:
+	TSharedPtr<FWangTileGrid, ESPMode::ThreadSafe> ArenaLayout = PendingArenaLayout;
+	const int ZoneClassCount = ZoneClasses.Num();
+
+	PendingArenaSolve = Async<bool>(EAsyncExecution::ThreadPool,
+		[LayoutFilename, ArenaLayout, ZoneClassCount]()
+		{
+			// (A file can hold cells with no Zone, or, if it was written elsewhere, Zones that don't exist):
+			FWangTileLayoutHeader LoadedHeader;
+			if (!FZoneLayoutFile::LoadLayout(LayoutFilename, ZoneClassCount, LoadedHeader, *ArenaLayout))
+			{
+				UE_LOG(LogZoneArenaGenerator, Error, TEXT("%s is cut short, does not match its checksum, or has a cell without a Zone."),
+					*LayoutFilename);
+				return false;
+			}
+
+			return true;
+		});
+
+	SetActorTickEnabled(true);
+	return true;
+}
+
+bool AZoneArenaGenerator::IsGeneratingArena() const
+{
+	return PendingArenaLayout.IsValid();
+}
+
+void AZoneArenaGenerator::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	// Sanity check:
+	if (!IsGeneratingArena())
+	{
+		SetActorTickEnabled(false);
+		return;
+	}
+
+	// Still placing the Zones (off the game thread):
+	if (PendingArenaSolve.IsValid())
+	{
+		if (!PendingArenaSolve.IsReady())
+		{
+			return;
+		}
+
+		bool ArenaLayoutSolved = PendingArenaSolve.Get();
+		PendingArenaSolve = TFuture<bool>();
+
+		if (!ArenaLayoutSolved)
+		{
+			EndGeneration(false);
+			return;
+		}
+
+		ArenaZones.Reserve(PendingArenaLayout->GetCellCount());
+		SpawnStartTime = FPlatformTime::Seconds();
+	}
+
+	const double TickStartTime = FPlatformTime::Seconds();
+	double SpawnDeadline = TickStartTime + SpawnBudgetMilliseconds / 1000.0;
+
+	// If spawning (at the rate it has gone so far) would finish after the latency budget, the rest
+	// is spawned in this tick (a long tick behind the loading screen is better than a late arena):
+	if (PendingCellIndex > 0)
+	{
+		const double SecondsPerZone = (TickStartTime - SpawnStartTime) / PendingCellIndex;
+		const int RemainingZoneCount = PendingArenaLayout->GetCellCount() - PendingCellIndex;
+
+		if (TickStartTime + RemainingZoneCount * SecondsPerZone > GenerationStartTime + LatencyBudgetSeconds)
+		{
+			SpawnDeadline = TNumericLimits<double>::Max();
+		}
+	}
+
+	if (SpawnPendingZones(SpawnDeadline))
+	{
+		if (bMergeZoneMeshes)
+		{
+			FZoneMeshMerge::MergeZoneMeshes(GetLevel(), ArenaZones, MergedMeshActors);
+		}
+
+		EndGeneration(true);
+	}
+}
+
+void AZoneArenaGenerator::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// The solve (if it is still running) holds its own references to what it uses:
+	if (PendingGenerationCancelled.IsValid())
+	{
+		PendingGenerationCancelled->store(true);
+	}
+
+	PendingArenaSolve = TFuture<bool>();
+	PendingArenaLayout.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AZoneArenaGenerator::ReleaseArenaZones()
+{
+	// A pooled Zone is shown with its own meshes when it is used again:
+	FZoneMeshMerge::UnmergeZoneMeshes(ArenaZones, MergedMeshActors);
+	MergedMeshActors.Empty();
+
+	for (AZone* ArenaZone : ArenaZones)
+	{
+		const int WangTileIndex = ArenaZone ? ZoneClasses.IndexOfByKey(ArenaZone->GetClass()) : INDEX_NONE;
+
+		if (!ArenaZone || ArenaZone->IsPendingKill() || !ZonePools.IsValidIndex(WangTileIndex))
+		{
+			continue;
+		}
+
+		ArenaZone->SetActorHiddenInGame(true);
+		ArenaZone->SetActorEnableCollision(false);
+		ZonePools[WangTileIndex].Zones.Add(ArenaZone);
+	}
+
+	ArenaZones.Empty();
+}
+
+AZone* AZoneArenaGenerator::AcquireZone(int WangTileIndex, const FTransform& ZoneTransform)
+{
+	FZonePool& ZonePool = ZonePools[WangTileIndex];
+
+	while (ZonePool.Zones.Num() > 0)
+	{
+		AZone* PooledZone = ZonePool.Zones.Pop(false);
+
+		if (PooledZone && !PooledZone->IsPendingKill())
+		{
+			PooledZone->SetActorTransform(ZoneTransform, false, nullptr, ETeleportType::TeleportPhysics);
+			PooledZone->SetActorHiddenInGame(false);
+			PooledZone->SetActorEnableCollision(true);
+			return PooledZone;
+		}
+	}
+
+	FActorSpawnParameters ZoneSpawnParameters;
+	ZoneSpawnParameters.Owner = this;
+	ZoneSpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	return GetWorld()->SpawnActor<AZone>(ZoneClasses[WangTileIndex], ZoneTransform, ZoneSpawnParameters);
+}
+
+bool AZoneArenaGenerator::SpawnPendingZones(double SpawnDeadline)
+{
+	const FWangTileGrid& ArenaLayout = *PendingArenaLayout;
+
+	while (PendingCellIndex < ArenaLayout.GetCellCount())
+	{
+		if (FPlatformTime::Seconds() > SpawnDeadline)
+		{
+			return false;
+		}
+
+		const int GridX = ArenaLayout.GetX(PendingCellIndex);
+		const int GridY = ArenaLayout.GetY(PendingCellIndex);
+		const int GridZ = ArenaLayout.GetZ(PendingCellIndex);
+		const int WangTileIndex = ArenaLayout[PendingCellIndex].TileId;
+
+		PendingCellIndex++;
+
+		// Sanity check (a layout is checked as it is loaded, so every cell should have a Zone):
+		if (!ZonePools.IsValidIndex(WangTileIndex))
+		{
+			continue;
+		}
+
+		AZone* ArenaZone = AcquireZone(WangTileIndex, GetZoneTransform(GridX, GridY, GridZ, ArenaLayout.GetHeight()));
+
+		// Sanity check:
+		if (ArenaZone)
+		{
+			ArenaZones.Add(ArenaZone);
+		}
+	}
+
+	return true;
+}
+
+void AZoneArenaGenerator::EndGeneration(bool bSucceeded)
+{
+	const float GenerationSeconds = static_cast<float>(FPlatformTime::Seconds() - GenerationStartTime);
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogZoneArenaGenerator, Error, TEXT("%s could not make (or load) a Zone layout for Seed %d."), *GetName(), Seed);
+	}
+	else if (GenerationSeconds > LatencyBudgetSeconds)
+	{
+		UE_LOG(LogZoneArenaGenerator, Warning, TEXT("%s took %.3f seconds to generate its arena (over its budget of %.3f)."),
+			*GetName(), GenerationSeconds, LatencyBudgetSeconds);
+	}
+
+	PendingArenaLayout.Reset();
+	PendingGenerationCancelled.Reset();
+	SetActorTickEnabled(false);
+
+	OnArenaGenerated.Broadcast(bSucceeded, GenerationSeconds);
+}
+
+bool AZoneArenaGenerator::GatherZoneTileSet(std::vector<FWangTileDefinition>& OutTileSet) const
+{
+	// Profiled from the classes, as the editor tool does (see AZone::BuildZoneProfile()):
+	OutTileSet.clear();
+	OutTileSet.reserve(FZoneTileSet::ZONE_BLUEPRINT_COUNT);
+
+	for (int WangTileIndex = 0; WangTileIndex < FZoneTileSet::ZONE_BLUEPRINT_COUNT; WangTileIndex++)
+	{
+		UClass* ZoneClass = ZoneClasses.IsValidIndex(WangTileIndex) ? *ZoneClasses[WangTileIndex] : nullptr;
+
+		// Sanity check:
+		if (!ZoneClass)
+		{
+			UE_LOG(LogZoneArenaGenerator, Error, TEXT("%s has no Zone class for WangTile%d."), *GetName(),
+				WangTileIndex + 1);
+			return false;
+		}
+
+		OutTileSet.push_back(FZoneTileSet::MakeTileDefinition(AZone::BuildZoneProfile(ZoneClass, WangTileIndex)));
+	}
+
+	return true;
+}
+
+void AZoneArenaGenerator::BeginGeneration()
+{
+	ReleaseArenaZones();
+	ZonePools.SetNum(ZoneClasses.Num());
+
+	PendingGenerationCancelled = MakeShareable(new std::atomic<bool>(false));
+	PendingArenaLayout = MakeShareable(new FWangTileGrid());
+	PendingCellIndex = 0;
+	GenerationStartTime = FPlatformTime::Seconds();
+}
+
+FTransform AZoneArenaGenerator::GetZoneTransform(int GridX, int GridY, int GridZ, int GridHeight) const
+{
+	// Work backwards from the last row, from the corner at this actor (each Zone is positioned by its centre),
+	// a floor at a time upwards:
+	const FVector ZoneLocation = FVector((GridX + 0.5f) * ZONE_WIDTH, (GridHeight - GridY - 0.5f) * ZONE_HEIGHT,
+		ZONE_Z_POSITION + GridZ * FloorHeight);
+
+	return FTransform(ZoneLocation) * GetActorTransform();
+}
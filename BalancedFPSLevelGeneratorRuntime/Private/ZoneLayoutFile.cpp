@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ZoneLayoutFile.h"
+#include "HAL/PlatformFilemanager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Templates/UniquePtr.h"
+#include "Misc/Paths.h"
+
+const TCHAR* FZoneLayoutFile::LAYOUT_FILE_EXTENSION = TEXT("wtl");
+
+bool FZoneLayoutFile::SaveLayout(const FString& Filename, const FWangTileGrid& ZoneLayout, const FWangTileLayoutHeader& Header)
+{
+	const std::vector<uint8_t> LayoutData = FWangTileLayoutFile::Encode(ZoneLayout, Header);
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Filename));
+
+	TUniquePtr<IFileHandle> LayoutFile(PlatformFile.OpenWrite(*Filename));
+
+	// Sanity check:
+	if (!LayoutFile)
+	{
+		return false;
+	}
+
+	return LayoutFile->Write(LayoutData.data(), static_cast<int64>(LayoutData.size()));
+}
+
+bool FZoneLayoutFile::LoadLayoutHeader(const FString& Filename, FWangTileLayoutHeader& OutHeader)
+{
+	TUniquePtr<IFileHandle> LayoutFile(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Filename));
+	uint8 HeaderData[FWangTileLayoutFile::HEADER_SIZE];
+
+	return LayoutFile && LayoutFile->Read(HeaderData, FWangTileLayoutFile::HEADER_SIZE)
+		&& FWangTileLayoutFile::DecodeHeader(HeaderData, FWangTileLayoutFile::HEADER_SIZE, OutHeader);
+}
+
+bool FZoneLayoutFile::LoadLayout(const FString& Filename, int32 ZoneCount, FWangTileLayoutHeader& OutHeader, FWangTileGrid& OutLayout)
+{
+	TUniquePtr<IFileHandle> LayoutFile(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Filename));
+	uint8 HeaderData[FWangTileLayoutFile::HEADER_SIZE];
+
+	if (!LayoutFile || !LayoutFile->Read(HeaderData, FWangTileLayoutFile::HEADER_SIZE)
+		|| !FWangTileLayoutFile::DecodeHeader(HeaderData, FWangTileLayoutFile::HEADER_SIZE, OutHeader)
+		|| LayoutFile->Size() < static_cast<int64>(FWangTileLayoutFile::GetFileSize(OutHeader)))
+	{
+		return false;
+	}
+
+	OutLayout.Reset(OutHeader.Width, OutHeader.Height, OutHeader.Depth);
+
+	// The rows (of each floor in turn) follow the header in order, so each is read straight after the last:
+	TArray<uint8> RowData;
+	RowData.SetNumUninitialized(static_cast<int32>(FWangTileLayoutFile::GetRowSize(OutHeader)));
+
+	for (int Row = 0; Row < FWangTileLayoutFile::GetRowCount(OutHeader); Row++)
+	{
+		if (!LayoutFile->Read(RowData.GetData(), RowData.Num()))
+		{
+			return false;
+		}
+
+		FWangTileLayoutFile::DecodeRow(OutHeader, RowData.GetData(), Row, OutLayout);
+	}
+
+	return OutLayout.ComputeLayoutChecksum() == OutHeader.LayoutChecksum
+		&& FWangTileLayoutFile::HasOnlyTiles(OutLayout, ZoneCount);
+}
+
+FString FZoneLayoutFile::GetDefaultLayoutFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ZoneLayouts") / FString(TEXT("ZoneLayout.")) + LAYOUT_FILE_EXTENSION;
+}
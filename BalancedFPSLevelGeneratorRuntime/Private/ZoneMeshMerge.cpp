@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ZoneMeshMerge.h"
+#include "Zone.h"
+#include "InstancedStaticMeshActor.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "Components/StaticMeshComponent.h"
+
+const FName FZoneMeshMerge::MERGED_ZONE_OBJECT_TAG = "MergedZoneObject";
+
+FZoneMeshMergeKey::FZoneMeshMergeKey(const UStaticMeshComponent* ZoneObject, bool bWithCollision)
+{
+	Mesh = ZoneObject->GetStaticMesh();
+
+	for (int MaterialIndex = 0; MaterialIndex < ZoneObject->GetNumMaterials(); MaterialIndex++)
+	{
+		Materials.Add(ZoneObject->GetMaterial(MaterialIndex));
+	}
+
+	// (An object whose collision is turned off collides as nothing, whatever its profile):
+	CollisionProfileName = bWithCollision && ZoneObject->GetCollisionEnabled() != ECollisionEnabled::NoCollision ?
+		ZoneObject->GetCollisionProfileName() : NAME_None;
+}
+
+void FZoneMeshMergeKey::ApplyTo(UInstancedStaticMeshComponent* InstancedComponent) const
+{
+	InstancedComponent->SetStaticMesh(Mesh);
+
+	for (int MaterialIndex = 0; MaterialIndex < Materials.Num(); MaterialIndex++)
+	{
+		InstancedComponent->SetMaterial(MaterialIndex, Materials[MaterialIndex]);
+	}
+
+	if (CollisionProfileName.IsNone())
+	{
+		InstancedComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+	else
+	{
+		InstancedComponent->SetCollisionProfileName(CollisionProfileName);
+	}
+}
+
+void FZoneMeshMerge::MergeZoneMeshes(ULevel* Level, const TArray<AZone*>& Zones,
+	TArray<AInstancedStaticMeshActor*>& OutMergedActors)
+{
+	// Sanity check:
+	if (!Level || !Level->OwningWorld)
+	{
+		return;
+	}
+
+	// Group the (world-space) transforms of every visible Zone object by what it draws, and collides as:
+	TMap<FZoneMeshMergeKey, TArray<FTransform>> MergeGroups;
+	TArray<UStaticMeshComponent*> ZoneObjects;
+
+	for (AZone* Zone : Zones)
+	{
+		if (!Zone || Zone->IsPendingKill())
+		{
+			continue;
+		}
+
+		Zone->GetComponents<UStaticMeshComponent>(ZoneObjects);
+
+		for (UStaticMeshComponent* ZoneObject : ZoneObjects)
+		{
+			// Only what is drawn (and not already instanced, or merged):
+			if (!ZoneObject->GetStaticMesh() || !ZoneObject->IsVisible() || !ZoneObject->IsRegistered() ||
+				ZoneObject->IsA<UInstancedStaticMeshComponent>())
+			{
+				continue;
+			}
+
+			MergeGroups.FindOrAdd(FZoneMeshMergeKey(ZoneObject, true)).Add(ZoneObject->GetComponentTransform());
+
+			// The object is kept (so that it is still counted), but has no render or physics state until it is unmerged:
+			ZoneObject->ComponentTags.AddUnique(MERGED_ZONE_OBJECT_TAG);
+			ZoneObject->bAutoRegister = false;
+			ZoneObject->UnregisterComponent();
+		}
+	}
+
+	// Then add one instanced actor for each group:
+	FActorSpawnParameters MergedSpawnParameters;
+	MergedSpawnParameters.OverrideLevel = Level;
+	MergedSpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	for (const TPair<FZoneMeshMergeKey, TArray<FTransform>>& MergeGroup : MergeGroups)
+	{
+		AInstancedStaticMeshActor* MergedActor = Level->OwningWorld->SpawnActor<AInstancedStaticMeshActor>(
+			AInstancedStaticMeshActor::StaticClass(), FTransform::Identity, MergedSpawnParameters);
+
+		if (!MergedActor)
+		{
+			continue;
+		}
+
+#if WITH_EDITOR
+		MergedActor->SetActorLabel(FString::Printf(TEXT("MergedZoneMeshes_%s"), *MergeGroup.Key.Mesh->GetName()));
+#endif
+
+		// The instances collide as the Zone objects did (so traces now hit the merged actor, rather than the Zone):
+		MergeGroup.Key.ApplyTo(MergedActor->GetInstancedStaticMeshComponent());
+		MergedActor->AddInstances(MergeGroup.Value);
+		OutMergedActors.Add(MergedActor);
+	}
+}
+
+void FZoneMeshMerge::UnmergeZoneMeshes(const TArray<AZone*>& Zones, const TArray<AInstancedStaticMeshActor*>& MergedActors)
+{
+	for (AInstancedStaticMeshActor* MergedActor : MergedActors)
+	{
+		if (MergedActor && !MergedActor->IsPendingKill())
+		{
+			MergedActor->Destroy();
+		}
+	}
+
+	TArray<UStaticMeshComponent*> ZoneObjects;
+
+	for (AZone* Zone : Zones)
+	{
+		if (!Zone || Zone->IsPendingKill())
+		{
+			continue;
+		}
+
+		Zone->GetComponents<UStaticMeshComponent>(ZoneObjects);
+
+		for (UStaticMeshComponent* ZoneObject : ZoneObjects)
+		{
+			if (ZoneObject->ComponentTags.Remove(MERGED_ZONE_OBJECT_TAG) > 0)
+			{
+				ZoneObject->bAutoRegister = true;
+				ZoneObject->RegisterComponent();
+			}
+		}
+	}
+}
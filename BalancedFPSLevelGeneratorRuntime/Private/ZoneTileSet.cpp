@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ZoneTileSet.h"
+
+// For the indices of the Zones (WangTile1 is 0):
+static const int ZONE_TWO_INDEX = 1;
+static const int ZONE_THREE_INDEX = 2;
+static const int ZONE_FOUR_INDEX = 3;
+static const int ZONE_FIVE_INDEX = 4;
+static const int ZONE_SIX_INDEX = 5;
+static const int ZONE_TEN_INDEX = 9;
+static const int ZONE_NINETEEN_INDEX = 18;
+static const int ZONE_TWENTY_INDEX = 19;
+static const int ZONE_TWENTY_ONE_INDEX = 20;
+static const int ZONE_TWENTY_TWO_INDEX = 21;
+
+/** For comparing Zone Defensiveness Coefficient Values. */
+static const float ZONE_DEFENSIVENESS_COEFFICIENT_THRESHOLD = 0.80f;
+
+FWangTileDefinition FZoneTileSet::MakeTileDefinition(const FZoneProfile& ZoneProfile)
+{
+	FWangTileDefinition ZoneTile;
+	ZoneTile.DispersionCoefficient = ZoneProfile.DispersionCoefficient;
+	ZoneTile.ZoneObjectCount = ZoneProfile.ZoneObjectCount;
+	ZoneTile.TotalZoneObjectArea = ZoneProfile.TotalZoneObjectArea;
+	ZoneTile.SelectionWeight = ZoneProfile.SelectionWeight;
+	ZoneTile.Footprint = ZoneProfile.Footprint;
+	ZoneTile.VerticalLinks = ZoneProfile.VerticalLinks;
+
+	for (int EdgeIndex = 0; EdgeIndex < ARRAY_COUNT(ZoneProfile.EdgeColours); EdgeIndex++)
+	{
+		ZoneTile.EdgeColours[EdgeIndex] = ZoneProfile.EdgeColours[EdgeIndex];
+	}
+
+	return ZoneTile;
+}
+
+void FZoneTileSet::ApplyPlacementRules(FWangTileSolverSettings& Settings)
+{
+	// The solver's first row (Y = 0) is the last row of the level-generation area:
+	Settings.SouthWestCornerTile = ZONE_SIX_INDEX;
+	Settings.SouthEastCornerTile = ZONE_FIVE_INDEX;
+	Settings.NorthEastCornerTile = ZONE_FOUR_INDEX;
+	Settings.NorthWestCornerTile = ZONE_THREE_INDEX;
+
+	Settings.NorthEdgeTile = ZONE_NINETEEN_INDEX;
+	Settings.EastEdgeTile = ZONE_TWENTY_INDEX;
+	Settings.SouthEdgeTile = ZONE_TWENTY_ONE_INDEX;
+	Settings.WestEdgeTile = ZONE_TWENTY_TWO_INDEX;
+
+	// For determining which Zone to choose from, based on Coefficient comparison between a
+	// given Zone and either WangTile2 or WangTile10:
+	Settings.WangTile2 = ZONE_TWO_INDEX;
+	Settings.WangTile10 = ZONE_TEN_INDEX;
+	Settings.ApplicableTilesForWangTile2 = { 3, 4, 6, 7, 9, 10, 11, 14 };
+	Settings.ApplicableTilesForWangTile10 = { 4, 5, 6, 11, 12, 15, 16, 18 };
+
+	Settings.DefensivenessThreshold = ZONE_DEFENSIVENESS_COEFFICIENT_THRESHOLD;
+}
+
+FString FZoneTileSet::GetZoneClassPath(int WangTileIndex)
+{
+	return FString::Printf(TEXT("/Game/BalancedFPSLevelGeneratorAssets/Blueprints/WangTiles/WangTile%d"),
+		WangTileIndex + 1);
+}
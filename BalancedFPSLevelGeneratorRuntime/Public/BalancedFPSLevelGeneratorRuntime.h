@@ -0,0 +1,30 @@
+// Copyright 1998-2017 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModuleManager.h"
+
+/**
+* The runtime half of the level generator (the solver, the Zone classes and AZoneArenaGenerator),
+* so that a level can be generated without the editor, such as on a dedicated server at the
+* start of a match. The editor module (and its tool) is a client of this one.
+*/
+class FBalancedFPSLevelGeneratorRuntimeModule : public IModuleInterface
+{
+public:
+
+	// Functions/Methods:
+
+	/** IModuleInterface implementation. */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+private:
+
+	/** 
+	* The Zone classes used to be in the editor module, so the Zone Blueprints (and any level
+	* generated before then) refer to them there. This points those references at this module.
+	*/
+	static void AddClassRedirects();
+};
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "FPSLevelGeneratorEdge.generated.h"
+
+/** The sides of a Zone (in the order of its Edges). */
+UENUM()
+enum class EZoneEdgeSide : uint8
+{
+	North,
+	East,
+	South,
+	West
+};
+
+/**
+ * One side of a Zone. Zones fit together (as Wang Tiles) where the Edges that touch
+ * have the same colour: the west Edge of a Zone must match the east Edge of the Zone
+ * to its west, and its south Edge the north Edge of the Zone to its south.
+ */
+UCLASS(DefaultToInstanced, EditInlineNew)
+class BALANCEDFPSLEVELGENERATORRUNTIME_API UFPSLevelGeneratorEdge : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	// Functions/Methods:
+
+	/** Standard constructor. */
+	UFPSLevelGeneratorEdge();
+
+	// Properties:
+
+	/** Which side of its Zone this Edge is on. */
+	UPROPERTY(VisibleDefaultsOnly, Category = "Level Generation")
+	EZoneEdgeSide Side;
+
+	/**
+	* Until every Edge of every Zone Blueprint has a colour (0 or above), the Zones are
+	* matched by their Coefficients instead (see FWangTileSolver::UsesEdgeColours()).
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "Level Generation", meta = (ClampMin = "-1", ClampMax = "63"))
+	int32 EdgeColour;
+
+	// Constant Values:
+
+	/** For an Edge that has not been given a colour. */
+	static const int32 NO_EDGE_COLOUR = -1;
+};
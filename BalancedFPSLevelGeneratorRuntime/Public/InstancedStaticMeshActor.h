@@ -0,0 +1,39 @@
+// Copyright 1998-2013 Epic Games, Inc. All Rights Reserved.
+// Taken from:
+// https://answers.unrealengine.com/questions/23673/how-do-i-use-instancedstaticmeshes.html
+// Answer by Rama.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "InstancedStaticMeshActor.generated.h"
+
+/**
+* 'An instance of a StaticMesh in a level
+* Note that PostInitializeComponents() is not called for StaticMeshActors'
+*
+* The static-mesh component is replaced with a hierarchical instanced one, so that
+* one of these actors can hold every panel of a face of the level-generation area.
+*/
+UCLASS(Blueprintable)
+class BALANCEDFPSLEVELGENERATORRUNTIME_API AInstancedStaticMeshActor : public AStaticMeshActor
+{
+	GENERATED_BODY()
+	
+public:
+
+	// Functions/Methods:
+
+	/** Swaps the default static-mesh component for a hierarchical instanced one. */
+	AInstancedStaticMeshActor(const FObjectInitializer& ObjectInitializer);
+
+	/** 
+	* Add all of these (world-space) instances in one batch, so that the
+	* instance tree is only built once.
+	*/
+	void AddInstances(const TArray<FTransform>& InstanceTransforms);
+
+	UHierarchicalInstancedStaticMeshComponent* GetInstancedStaticMeshComponent() const;
+};
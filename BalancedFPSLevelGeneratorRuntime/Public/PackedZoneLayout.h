@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+
+// Bespoke header files:
+#include "Zone.h"
+
+#include "PackedZoneLayout.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+
+/**
+* The Zones of a region of a layout, packed into one actor: each Zone is only a byte (the index of
+* its Zone Blueprint), and only the Zones' meshes are realised, with one hierarchical instanced
+* component (with collision) for each mesh, set of materials and collision profile. This is in
+* place of a Zone actor for each tile, which a big level has many thousands of.
+*
+* Cells are counted across the whole layout (not just this region), from the solver's first row.
+*/
+UCLASS()
+class BALANCEDFPSLEVELGENERATORRUNTIME_API APackedZoneLayout : public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	// Functions/Methods:
+
+	/** Standard constructor. */
+	APackedZoneLayout();
+
+	/**
+	* Start an empty region (of the given cells) for the given Zone Blueprints. The centre of the
+	* Zone at cell (0, 0) is at FirstZoneLocation (relative to this actor), and each cell is
+	* CellStep further along X and Y.
+	*/
+	void InitialiseRegion(const FIntRect& ZoneRegion, const TArray<TSubclassOf<AZone>>& InZoneClasses,
+		const FVector& InFirstZoneLocation, const FVector2D& InCellStep, const FVector& InZoneScale);
+
+	/** Record the Zone at a cell of the region (its meshes are not realised until RealiseZoneMeshes()). */
+	void SetWangTileIndex(int GridX, int GridY, int WangTileIndex);
+
+	/** For the index of the Zone Blueprint at a cell, or INDEX_NONE if the cell is not in the region. */
+	UFUNCTION(BlueprintPure, Category = "Level Generation")
+	int32 GetWangTileIndex(int32 GridX, int32 GridY) const;
+
+	/** For the class of the Zone at a cell (nullptr if there is none). */
+	UFUNCTION(BlueprintPure, Category = "Level Generation")
+	TSubclassOf<AZone> GetZoneClass(int32 GridX, int32 GridY) const;
+
+	/** For the cell that contains a world-space location (which may not be in the region). */
+	UFUNCTION(BlueprintPure, Category = "Level Generation")
+	FIntPoint GetCellAtLocation(const FVector& WorldLocation) const;
+
+	/** For the (world-space) transform a Zone actor at the cell would have. */
+	FTransform GetZoneTransform(int GridX, int GridY) const;
+
+	/** Replace the instanced components with ones for the recorded Zones (in one batch each). */
+	void RealiseZoneMeshes();
+
+	// Properties:
+
+	// The cells this actor holds the Zones of:
+
+	UPROPERTY(VisibleAnywhere, Category = "Level Generation")
+	FIntPoint RegionMin;
+
+	UPROPERTY(VisibleAnywhere, Category = "Level Generation")
+	FIntPoint RegionSize;
+
+	/** Indexed as WangTileIndices. */
+	UPROPERTY(VisibleAnywhere, Category = "Level Generation")
+	TArray<TSubclassOf<AZone>> ZoneClasses;
+
+private:
+
+	// Functions/Methods:
+
+	/** As GetZoneTransform(), relative to this actor (as the instances are). */
+	FTransform GetZoneRelativeTransform(int GridX, int GridY) const;
+
+	// Properties:
+
+	/** For each cell of the region (row by row), the index of its Zone Blueprint (NO_ZONE for none). */
+	UPROPERTY()
+	TArray<uint8> WangTileIndices;
+
+	UPROPERTY()
+	FVector FirstZoneLocation;
+
+	UPROPERTY()
+	FVector2D CellStep;
+
+	UPROPERTY()
+	FVector ZoneScale;
+
+	UPROPERTY()
+	TArray<UHierarchicalInstancedStaticMeshComponent*> ZoneMeshComponents;
+
+	// Constant Values:
+
+	/** For a cell without a Zone. */
+	static const uint8 NO_ZONE = 0xFF;
+};
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "WangTileTypes.h"
+#include <vector>
+#include "WangTileRandomStream.h"
+
+/** One column of a Walker alias table. */
+struct FWangTileAliasEntry
+{
+	/** For a column that always picks its own tile (so no second draw is needed). */
+	static const uint32_t ALWAYS_KEEP = 0xFFFFFFFF;
+
+	/** A draw below this picks Tile, otherwise AliasTile is picked. */
+	uint32_t Threshold = ALWAYS_KEEP;
+	uint16_t Tile = 0;
+	uint16_t AliasTile = 0;
+};
+
+/**
+* Walker alias tables (built with Vose's method), for picking a tile from a candidate set
+* in proportion to the tiles' weights, in constant time. Every table is one column per
+* candidate tile, so when the weights are equal, a pick is just a uniform choice of column.
+*/
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileAliasTable
+{
+	/**
+	* Append the table for the tiles in Mask (see FWangTileMask) to OutEntries, as one entry per
+	* tile. Weights is indexed by tile; if the tiles' weights sum to 0, they are treated as equal.
+	*/
+	static void Build(const uint64_t* Mask, int WordCount, const float* Weights,
+		std::vector<FWangTileAliasEntry>& OutEntries);
+
+	static int Pick(const FWangTileAliasEntry* Entries, int EntryCount, FWangTileRandomStream& RandomStream)
+	{
+		const FWangTileAliasEntry& Entry = Entries[RandomStream.GetBoundedUInt32(static_cast<uint32_t>(EntryCount))];
+
+		if (Entry.Threshold == FWangTileAliasEntry::ALWAYS_KEEP || RandomStream.GetNextUInt32() < Entry.Threshold)
+		{
+			return Entry.Tile;
+		}
+
+		return Entry.AliasTile;
+	}
+};
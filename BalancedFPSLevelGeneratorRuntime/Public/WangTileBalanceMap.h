@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "WangTileTypes.h"
+#include <vector>
+#include "WangTileSolver.h"
+
+/** The Coefficients kept for each cell (see FWangTileBalanceMap). */
+enum class EWangTileCoefficient : uint8_t
+{
+	Defensiveness,
+	Flanking,
+	Dispersion,
+	Count
+};
+
+/** The Coefficients of the cells in a rectangle of a layout. */
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileRegionBalance
+{
+	int CellCount = 0;
+
+	/** Indexed by EWangTileCoefficient. */
+	double Sums[static_cast<int>(EWangTileCoefficient::Count)] = { 0.0, 0.0, 0.0 };
+
+	/** 0 for an empty region. */
+	float GetMean(EWangTileCoefficient Coefficient) const
+	{
+		return CellCount > 0 ? static_cast<float>(Sums[static_cast<int>(Coefficient)] / CellCount) : 0.0f;
+	}
+};
+
+/** The spread of each Coefficient across a whole layout, and how it is split between the two halves. */
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileBalanceReport
+{
+	FWangTileRegionBalance Level;
+
+	// Indexed by EWangTileCoefficient:
+	float Minimums[static_cast<int>(EWangTileCoefficient::Count)] = { 0.0f, 0.0f, 0.0f };
+	float Maximums[static_cast<int>(EWangTileCoefficient::Count)] = { 0.0f, 0.0f, 0.0f };
+	float StandardDeviations[static_cast<int>(EWangTileCoefficient::Count)] = { 0.0f, 0.0f, 0.0f };
+
+	/** Where the teams start (the middle row, of an odd number of rows, belongs to neither). */
+	FWangTileRegionBalance SouthHalf;
+	FWangTileRegionBalance NorthHalf;
+
+	/** As FWangTileSolver::ScoreLayout() would score the layout (though summed more precisely). */
+	FWangTileLayoutScore Score;
+};
+
+/**
+* The Coefficients of every cell of a layout, with a summed-area table over each, so that the sum
+* (or mean) of a Coefficient over any rectangle of cells is found from four entries of its table,
+* however large the rectangle. The tables are built, and whole-layout reports reduced, across
+* Settings.ThreadCount threads (as the solver runs). A layout of several floors is mapped on its
+* floor plan, each cell holding the mean of the tiles above one another there.
+*/
+class BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileBalanceMap
+{
+public:
+
+	// Functions/Methods:
+
+	/** For a layout of tiles from TileSet (Settings gives only the threads to use). */
+	void Build(const std::vector<FWangTileDefinition>& TileSet, const FWangTileGrid& Grid,
+		const FWangTileSolverSettings& Settings);
+
+	int GetWidth() const { return Width; }
+	int GetHeight() const { return Height; }
+	bool IsEmpty() const { return Width == 0 || Height == 0; }
+
+	/** The Coefficient of the tile at (X, Y), as placed there (the mean of its floors). */
+	float GetCoefficient(EWangTileCoefficient Coefficient, int X, int Y) const
+	{
+		return Coefficients[static_cast<int>(Coefficient)][Y * Width + X];
+	}
+
+	/** For the cells in Rect (clipped to the layout), in constant time. */
+	FWangTileRegionBalance GetRegionBalance(const FWangTileRect& Rect) const;
+
+	/** Reduce every cell of the layout in parallel (Settings gives only the threads to use). */
+	FWangTileBalanceReport ComputeReport(const FWangTileSolverSettings& Settings) const;
+
+private:
+
+	// Functions/Methods:
+
+	/** The sum of a Coefficient over the cells below and to the west of (X, Y), exclusive. */
+	double GetSummedArea(int CoefficientIndex, int X, int Y) const
+	{
+		return SummedAreas[CoefficientIndex][static_cast<std::size_t>(Y) * (Width + 1) + X];
+	}
+
+	// Properties:
+
+	int Width = 0;
+	int Height = 0;
+
+	/** Indexed by EWangTileCoefficient, then by cell. */
+	std::vector<float> Coefficients[static_cast<int>(EWangTileCoefficient::Count)];
+
+	/**
+	* Indexed by EWangTileCoefficient, then (Width + 1) by (Height + 1), with a row and column of 0s
+	* first. Doubles, so that a sum over millions of cells loses no precision.
+	*/
+	std::vector<double> SummedAreas[static_cast<int>(EWangTileCoefficient::Count)];
+};
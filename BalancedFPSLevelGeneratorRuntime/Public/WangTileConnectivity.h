@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "WangTileTypes.h"
+#include <vector>
+#include "WangTileSolver.h"
+
+/** What FWangTileConnectivity::Check() found. */
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileConnectivityReport
+{
+	/** The walkable regions of the layout (each a set of tiles that can all be reached from each other). */
+	int ComponentCount = 0;
+
+	/** The tiles in the largest region (the one the other regions are cut off from). */
+	int MainComponentCellCount = 0;
+
+	/** The index of each tile with a walkable side that the largest region cannot reach. */
+	std::vector<int> CutOffCells;
+
+	/** The bounds of each region cut off from the largest region (on the floor plan), smallest region first. */
+	std::vector<FWangTileRect> CutOffBounds;
+
+	bool IsConnected() const { return ComponentCount <= 1; }
+};
+
+/**
+* Checks that every walkable part of a layout can be reached from every other part. Each side of
+* each tile is a node of a walkability graph, joined to the other sides its tile's footprint leads
+* to (see FWangTileFootprint::SideLinks), and to the facing side of its neighbour, if both sides are
+* open. A stair or ramp tile that leads up is joined to the tile above it, if that tile leads down
+* (see FWangTileDefinition::VerticalLinks). The nodes are joined with a union-find, so a check is
+* close to linear in the number of tiles, and the checker keeps its buffers from one check to the
+* next (so that every candidate of a best-of-N solve can be checked).
+*
+* A tile without a measured footprint is open on every side.
+*/
+class BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileConnectivity
+{
+public:
+
+	// Functions/Methods:
+
+	explicit FWangTileConnectivity(const std::vector<FWangTileDefinition>& TileSet);
+
+	/** Check a layout (the report is kept until the next check). */
+	const FWangTileConnectivityReport& Check(const FWangTileGrid& Grid);
+
+	const FWangTileConnectivityReport& GetReport() const { return Report; }
+
+private:
+
+	// Functions/Methods:
+
+	/** For the root of a node's set (halving the path to it on the way). */
+	int FindRoot(int Node);
+
+	/** Join the sets of two nodes (the smaller set under the larger). */
+	void JoinNodes(int NodeA, int NodeB);
+
+	// Properties:
+
+	/** For each tile, its open sides (a bit, 1 << EWangTileSide, for each). */
+	std::vector<uint8_t> OpenSides;
+
+	/** For each tile, the floors it leads to (see FWangTileDefinition::VerticalLinks). */
+	std::vector<uint8_t> VerticalLinks;
+
+	/** Indexed by [Tile * 4 + Side], the other sides that side leads to (see FWangTileFootprint::SideLinks). */
+	std::vector<uint8_t> SideLinks;
+
+	/** Indexed by [Tile * 4 + Side], the side each open side is joined under within its tile (or -1 if it is not open). */
+	std::vector<int8_t> SideRoots;
+
+	/** For each node (at [Cell * 4 + Side]), its parent, or (for a root) minus the size of its set. */
+	std::vector<int> Parents;
+
+	/** For each root node, the index of its region (or -1). */
+	std::vector<int> ComponentIndices;
+
+	// For each region, its tiles, and their bounds:
+	std::vector<int> ComponentCellCounts;
+	std::vector<FWangTileRect> ComponentBounds;
+
+	FWangTileConnectivityReport Report;
+};
@@ -0,0 +1,169 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "WangTileTypes.h"
+#include <vector>
+#include "WangTileGrid.h"
+#include "WangTileRandomStream.h"
+
+struct FWangTileSolverSettings;
+struct FWangTileSolverStats;
+enum class EWangTileSide : uint8_t;
+
+/**
+* The solver's FWangTileSolverSettings::PropagateConstraints mode. Each interior cell keeps a
+* domain (a mask of the tiles it could still hold, see FWangTileMask). A tile may only be placed
+* to the east of a tile (or to its north) if it is in that tile's neighbour mask. Placing a tile
+* removes the tiles it rules out from the other cells' domains, through a worklist (as in AC-3),
+* so the other cells do not have to be revisited first. On a grid of several floors, a tile
+* leads down exactly where the tile below it leads up (see FWangTileDefinition::VerticalLinks),
+* so the cells above and below a cell are revised as well.
+*
+* Cells are placed in the same order as the scanline solver (a floor at a time). If a placement leaves a cell
+* with an empty domain, it is undone and the next tile is tried (going back further if need
+* be). This happens at most Settings.MaxBacktracks times, and never more than
+* Settings.MaxBacktrackDepth placements back. Beyond that, a cell with an empty domain is given
+* a tile the same way the scanline solver would choose it. So it never fails to fill the grid.
+*/
+class FWangTileConstraintPropagator
+{
+public:
+
+	// Functions/Methods:
+
+	/**
+	* The neighbour masks are indexed by [(Placement * TileCount + Tile) * MaskWordCount], for
+	* the tiles that may be placed to the east of, and to the north of, that tile. The vertical
+	* links are indexed by tile.
+	*/
+	FWangTileConstraintPropagator(int InTileCount, int InMaskWordCount, const std::vector<uint64_t>& InEastNeighbourMasks,
+		const std::vector<uint64_t>& InNorthNeighbourMasks, const std::vector<uint8_t>& InTileVerticalLinks,
+		const std::vector<float>& InSelectionWeights);
+
+	/**
+	* Fill the interior of Grid (whose boundary tiles must already be placed).
+	* Returns false (leaving the grid part-filled) only if the solve was cancelled.
+	*/
+	bool Solve(const FWangTileSolverSettings& Settings, FWangTileGrid& Grid, FWangTileSolverStats& OutStats);
+
+private:
+
+	/** A tile placed by the search, that may be undone. */
+	struct FPlacement
+	{
+		int CellIndex;
+		int Tile;
+
+		/** The length of the trail before the tile was placed. */
+		std::size_t TrailStart;
+	};
+
+	// Functions/Methods:
+
+	uint64_t* GetDomain(int CellIndex) { return &Domains[static_cast<std::size_t>(CellIndex) * MaskWordCount]; }
+
+	/** Empty the domain of a cell to Tile, then propagate. Returns false if a domain was emptied. */
+	bool PlaceTile(int CellIndex, int Tile, bool IsStrict);
+
+	/** Remove Tile from the domain of a cell, then propagate. Returns false if a domain was emptied. */
+	bool ExcludeTile(int CellIndex, int Tile);
+
+	/**
+	* Remove the tiles from the cells next to the cells in the worklist that they no longer have
+	* any support for. If IsStrict, stop (returning false) as soon as a domain is emptied.
+	*/
+	bool Propagate(bool IsStrict);
+
+	/** Set the domain of a cell to its mask AND Support. Returns false if it was emptied. */
+	bool Revise(int CellIndex, const uint64_t* Support, bool IsStrict);
+
+	/**
+	* For the tiles allowed by any tile in the domain of a cell, in one direction (see Propagate()),
+	* where the neighbour masks are for the placement of whichever of the two is to the west or south.
+	* Valid until the next call.
+	*/
+	const uint64_t* GatherSupport(int CellIndex, EWangTileSide Direction, int NeighbourPlacement);
+
+	/**
+	* For the tiles allowed by any tile in the domain of a cell, in the cell above it (or below it,
+	* if not IsUpwards). Valid until the next call.
+	*/
+	const uint64_t* GatherVerticalSupport(int CellIndex, bool IsUpwards);
+
+	/** Set Mask to the tiles that may be on floor Z at all (nothing leads down from the first floor, or up from the top one). */
+	void GetFloorTiles(int Z, uint64_t* Mask) const;
+
+	/** Restore the domains that were changed after the trail was TrailLength long. */
+	void UndoTrail(std::size_t TrailLength);
+
+	/** Forget the oldest placements, so that the trail only covers the last MaxBacktrackDepth of them. */
+	void TrimTrail(int MaxBacktrackDepth);
+
+	/** For a tile from the mask (in proportion to the tiles' weights). */
+	int PickTile(const uint64_t* Mask, FWangTileRandomStream& RandomStream) const;
+
+	/**
+	* For a tile that suits the tiles to the west and south (or the tile to the west alone, or any tile),
+	* preferring those that suit the tile below.
+	*/
+	int PickScanlineTile(int CellIndex, FWangTileRandomStream& RandomStream) const;
+
+	bool IsInteriorCell(int X, int Y) const { return X > 0 && Y > 0 && X < Width - 1 && Y < Height - 1; }
+
+	// Properties:
+
+	int TileCount;
+	int MaskWordCount;
+	const std::vector<uint64_t>& EastNeighbourMasks;
+	const std::vector<uint64_t>& NorthNeighbourMasks;
+	const std::vector<float>& SelectionWeights;
+
+	/** The transposes of the neighbour masks (the tiles that may be to the west of, or south of, a tile). */
+	std::vector<uint64_t> WestNeighbourMasks;
+	std::vector<uint64_t> SouthNeighbourMasks;
+
+	/** The tiles that lead up, and those that lead down (and every tile, to find those that don't). */
+	std::vector<uint64_t> UpLinkedTiles;
+	std::vector<uint64_t> DownLinkedTiles;
+	std::vector<uint64_t> AllTiles;
+
+	/** Whether any tile (in any direction) is allowed by at least one tile. */
+	bool IsEveryTileSupported;
+
+	// For the grid being solved:
+
+	FWangTileGrid* Grid;
+	int Width;
+	int Height;
+	int Depth;
+
+	/** Indexed by [CellIndex * MaskWordCount]. */
+	std::vector<uint64_t> Domains;
+
+	/** The cells whose domains have changed, but have not yet been propagated. */
+	std::vector<int> Worklist;
+	std::vector<uint8_t> IsInWorklist;
+
+	/** The cells whose domains have changed since the oldest placement that may be undone, with their previous domains. */
+	std::vector<int> TrailCells;
+	std::vector<uint64_t> TrailDomains;
+
+	std::vector<FPlacement> Placements;
+
+	/**
+	* Most domains are one of only a few masks (such as every tile, or every tile on one side of
+	* the Defensiveness threshold), so their support is cached, by the domain, direction and
+	* placement. Each entry has a tag (0 if it is empty) and its domain, then its support.
+	*/
+	std::vector<uint64_t> SupportCacheKeys;
+	std::vector<uint64_t> SupportCacheValues;
+
+	/** For GatherVerticalSupport() (which needs no cache, as it only depends on which links the domain has). */
+	std::vector<uint64_t> VerticalSupport;
+
+	// Constant Values:
+
+	/** For 4096 entries in the support cache. */
+	static const int SUPPORT_CACHE_BITS = 12;
+};
@@ -0,0 +1,148 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "WangTileTypes.h"
+#include <vector>
+
+/** Where a cell sits, relative to the bounds of the level-generation area. */
+enum class EWangTilePlacement : uint8_t
+{
+	Corner,
+	Edge,
+	Interior,
+	Count
+};
+
+/** One cell of the grid, packed into 4 bytes. */
+struct FWangTileCell
+{
+	/** For a cell that has no tile placed in it yet. */
+	static const uint16_t NO_TILE = 0xFFFF;
+
+	// For the Flags:
+
+	/** The tile was chosen by the user, so it is kept when the cells around it are solved again. */
+	static const uint8_t PINNED_FLAG = 1 << 0;
+
+	uint16_t TileId = NO_TILE;
+	EWangTilePlacement Placement = EWangTilePlacement::Interior;
+	uint8_t Flags = 0;
+
+	bool HasTile() const { return TileId != NO_TILE; }
+
+	bool IsPinned() const { return (Flags & PINNED_FLAG) != 0; }
+	void SetPinned(bool bPinned) { Flags = bPinned ? (Flags | PINNED_FLAG) : (Flags & ~PINNED_FLAG); }
+};
+
+/** A rectangle of cells, from Min (inclusive) to Max (exclusive), on every floor. */
+struct FWangTileRect
+{
+	int MinX = 0;
+	int MinY = 0;
+	int MaxX = 0;
+	int MaxY = 0;
+
+	FWangTileRect() = default;
+	FWangTileRect(int InMinX, int InMinY, int InMaxX, int InMaxY)
+		: MinX(InMinX), MinY(InMinY), MaxX(InMaxX), MaxY(InMaxY)
+	{
+	}
+
+	bool IsEmpty() const { return MinX >= MaxX || MinY >= MaxY; }
+	bool Contains(int X, int Y) const { return X >= MinX && Y >= MinY && X < MaxX && Y < MaxY; }
+};
+
+/**
+* A dense, row-major grid of tiles, addressed by integer (X, Y, Z) coordinates.
+* X increases eastwards and Y northwards, from the south-west corner at (0, 0), and
+* Z upwards, a floor at a time (each floor is Width * Height cells, after the floor
+* below it), so the neighbours of a cell are a fixed offset away from its index.
+* A grid of one floor is addressed by (X, Y) alone.
+*/
+class BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileGrid
+{
+public:
+
+	// Functions/Methods:
+
+	FWangTileGrid() = default;
+	FWangTileGrid(int InWidth, int InHeight, int InDepth = 1) { Reset(InWidth, InHeight, InDepth); }
+
+	/**
+	* Resize the grid, clearing every cell and classifying it as a corner, edge or interior cell
+	* (of its floor, so every floor is classified the same).
+	*/
+	void Reset(int InWidth, int InHeight, int InDepth = 1);
+
+	/**
+	* Resize each floor of the grid, moving each cell by (OffsetX, OffsetY). A cell keeps its tile
+	* (and flags) if it is still within the grid and its placement has not changed, otherwise it is
+	* cleared. OutClearedRects covers every cleared cell (as one span per row, the same on every
+	* floor), for the solver to fill.
+	*/
+	void Resize(int NewWidth, int NewHeight, int OffsetX, int OffsetY, std::vector<FWangTileRect>& OutClearedRects);
+
+	int GetWidth() const { return Width; }
+	int GetHeight() const { return Height; }
+	int GetDepth() const { return Depth; }
+	int GetCellCount() const { return static_cast<int>(Cells.size()); }
+	int GetFloorCellCount() const { return Width * Height; }
+
+	bool IsValid(int X, int Y) const { return X >= 0 && Y >= 0 && X < Width && Y < Height; }
+	bool IsValid(int X, int Y, int Z) const { return IsValid(X, Y) && Z >= 0 && Z < Depth; }
+
+	int GetIndex(int X, int Y) const { return Y * Width + X; }
+	int GetIndex(int X, int Y, int Z) const { return (Z * Height + Y) * Width + X; }
+	int GetX(int Index) const { return Index % Width; }
+	int GetY(int Index) const { return (Index / Width) % Height; }
+	int GetZ(int Index) const { return Index / GetFloorCellCount(); }
+
+	// Neighbours (the caller checks that these are within the grid):
+
+	int GetWestIndex(int Index) const { return Index - 1; }
+	int GetEastIndex(int Index) const { return Index + 1; }
+	int GetSouthIndex(int Index) const { return Index - Width; }
+	int GetNorthIndex(int Index) const { return Index + Width; }
+	int GetBelowIndex(int Index) const { return Index - GetFloorCellCount(); }
+	int GetAboveIndex(int Index) const { return Index + GetFloorCellCount(); }
+
+	FWangTileCell& operator[](int Index) { return Cells[Index]; }
+	const FWangTileCell& operator[](int Index) const { return Cells[Index]; }
+
+	FWangTileCell& At(int X, int Y) { return Cells[GetIndex(X, Y)]; }
+	const FWangTileCell& At(int X, int Y) const { return Cells[GetIndex(X, Y)]; }
+
+	FWangTileCell& At(int X, int Y, int Z) { return Cells[GetIndex(X, Y, Z)]; }
+	const FWangTileCell& At(int X, int Y, int Z) const { return Cells[GetIndex(X, Y, Z)]; }
+
+	int GetTileId(int X, int Y) const { return At(X, Y).TileId; }
+	int GetTileId(int X, int Y, int Z) const { return At(X, Y, Z).TileId; }
+
+	bool IsCorner(int Index) const { return Cells[Index].Placement == EWangTilePlacement::Corner; }
+	bool IsEdge(int Index) const { return Cells[Index].Placement == EWangTilePlacement::Edge; }
+	bool IsInterior(int Index) const { return Cells[Index].Placement == EWangTilePlacement::Interior; }
+
+	const std::vector<FWangTileCell>& GetCells() const { return Cells; }
+
+	/**
+	* A 64-bit FNV-1a hash of the size of the grid and every tile in it (in a fixed byte
+	* order), so that layouts generated on different machines can be compared. The number of
+	* floors is only hashed if there is more than one (so a layout of one floor hashes as it did
+	* before there were floors).
+	*/
+	uint64_t ComputeLayoutChecksum() const;
+
+	/** Where the cell at (X, Y) is, in a grid of the given size. */
+	static EWangTilePlacement GetPlacement(int X, int Y, int GridWidth, int GridHeight);
+
+private:
+
+	// Properties:
+
+	int Width = 0;
+	int Height = 0;
+	int Depth = 0;
+
+	std::vector<FWangTileCell> Cells;
+};
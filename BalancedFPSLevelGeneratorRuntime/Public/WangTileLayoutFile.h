@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "WangTileTypes.h"
+#include <vector>
+#include "WangTileGrid.h"
+
+struct FWangTileDefinition;
+
+/** What a layout file records about its layout (see FWangTileLayoutFile). */
+struct FWangTileLayoutHeader
+{
+	/** The Seed the layout was solved with (as wide as FWangTileSolverSettings::Seed). */
+	uint32_t Seed = 0;
+
+	// The size of the layout, in tiles (and floors):
+	int Width = 0;
+	int Height = 0;
+	int Depth = 1;
+
+	// The size of the level-generation area it was solved for (in world units):
+	float ExtentX = 0.0f;
+	float ExtentY = 0.0f;
+
+	/** See FWangTileLayoutFile::ComputeTileSetHash(). */
+	uint64_t TileSetHash = 0;
+
+	/** See FWangTileGrid::ComputeLayoutChecksum(). */
+	uint64_t LayoutChecksum = 0;
+
+	/** How many bits each tile id is packed into. */
+	int BitsPerTile = 0;
+};
+
+/**
+* A compact file for a solved layout: a fixed-size header, then every tile id, packed into
+* BitsPerTile bits (5 for the 22 Zones, so a 1000x1000 layout takes about 625 KB). Each row
+* starts on a byte boundary, so a row can be read on its own (from GetRowOffset()), or decoded
+* straight from a memory-mapped file. Everything is little-endian, whatever the platform.
+*
+* The rows of a layout of several floors follow one another a floor at a time, from the lowest.
+* Such a layout is written as version 2 (with its floors beside its bits per tile, as two 16-bit
+* values), and a layout of one floor as version 1, as it always was.
+*/
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileLayoutFile
+{
+	/** For the whole file. Header's size, bits per tile and checksum are taken from the grid. */
+	static std::vector<uint8_t> Encode(const FWangTileGrid& Grid, FWangTileLayoutHeader Header);
+
+	/** Returns false if the data does not start with a header of version 1 or 2. */
+	static bool DecodeHeader(const uint8_t* Data, std::size_t Size, FWangTileLayoutHeader& OutHeader);
+
+	/**
+	* Decode a whole file into OutGrid. Returns false if it is not a layout file, it is cut
+	* short, its tiles do not match its checksum, or any cell is not one of TileCount tiles.
+	*/
+	static bool Decode(const uint8_t* Data, std::size_t Size, int TileCount, FWangTileLayoutHeader& OutHeader,
+		FWangTileGrid& OutGrid);
+
+	/**
+	* Set the tiles of a row of Grid (which must already be the header's size), from that row's bytes.
+	* Row is Y on the lowest floor, Height + Y on the floor above, and so on.
+	*/
+	static void DecodeRow(const FWangTileLayoutHeader& Header, const uint8_t* RowData, int Row, FWangTileGrid& Grid);
+
+	/**
+	* True if every cell of Grid has a tile, below TileCount. A file can hold cells with no tile
+	* (or tile ids up to its bits per tile), which cannot be looked up in the tile-set.
+	*/
+	static bool HasOnlyTiles(const FWangTileGrid& Grid, int TileCount);
+
+	/** Every row of every floor. */
+	static int GetRowCount(const FWangTileLayoutHeader& Header) { return Header.Height * Header.Depth; }
+
+	static std::size_t GetRowSize(const FWangTileLayoutHeader& Header);
+	static std::size_t GetRowOffset(const FWangTileLayoutHeader& Header, int Row);
+	static std::size_t GetFileSize(const FWangTileLayoutHeader& Header);
+
+	/**
+	* A 64-bit FNV-1a hash of everything the solver knows about each tile, so that a layout can be
+	* checked against the tile-set it is loaded with.
+	*/
+	static uint64_t ComputeTileSetHash(const std::vector<FWangTileDefinition>& TileSet);
+
+	// Constant Values:
+
+	/** "WTLF", as the first four bytes. */
+	static const uint32_t FILE_MAGIC = 0x464C5457;
+	static const uint32_t FILE_VERSION = 2;
+	static const uint32_t FLAT_FILE_VERSION = 1;
+	static const int HEADER_SIZE = 48;
+};
@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "WangTileTypes.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h> // For _BitScanForward64().
+#endif
+
+/** How a Coefficient is compared against a bound, by FWangTileMask::Compare(). */
+enum class EWangTileComparison : uint8_t
+{
+	LessOrEqual,
+	GreaterOrEqual,
+	Less
+};
+
+/**
+* A set of tiles, as one bit per tile (tile N is bit N % 64 of word N / 64), and the
+* kernels that build and read them. The Compare() kernel works through contiguous
+* Coefficient arrays four tiles at a time (with SSE, where it is available), so finding
+* the candidates of a tile stays cheap as the tile-set grows.
+*/
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileMask
+{
+	/** For the number of 64-bit words a mask of TileCount tiles needs. */
+	static int GetWordCount(int TileCount) { return (TileCount + 63) / 64; }
+
+	static bool ContainsTile(const uint64_t* Mask, int Tile)
+	{
+		return (Mask[Tile >> 6] >> (Tile & 63)) & 1;
+	}
+
+	static void AddTile(uint64_t* Mask, int Tile)
+	{
+		Mask[Tile >> 6] |= uint64_t(1) << (Tile & 63);
+	}
+
+	/** Set OutMask to the tiles whose value (in Values, indexed by tile) compares to Bound. */
+	static void Compare(const float* Values, int TileCount, EWangTileComparison Comparison, float Bound,
+		uint64_t* OutMask);
+
+	/** Set OutMask to the tiles in both A and B, and return how many there are. */
+	static int Intersect(const uint64_t* A, const uint64_t* B, int WordCount, uint64_t* OutMask);
+
+	static int CountTiles(const uint64_t* Mask, int WordCount);
+
+	/** Call Function(Tile) for each tile in the mask, in ascending order. */
+	template<typename FunctionType>
+	static void ForEachTile(const uint64_t* Mask, int WordCount, FunctionType Function)
+	{
+		for (int WordIndex = 0; WordIndex < WordCount; WordIndex++)
+		{
+			for (uint64_t Word = Mask[WordIndex]; Word != 0; Word &= Word - 1)
+			{
+				Function(WordIndex * 64 + GetLowestBit(Word));
+			}
+		}
+	}
+
+	/** For the index of the lowest set bit of a (non-zero) word. */
+	static int GetLowestBit(uint64_t Word)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctzll(Word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long BitIndex;
+		_BitScanForward64(&BitIndex, Word);
+		return static_cast<int>(BitIndex);
+#else
+		int BitIndex = 0;
+		for (; !(Word & 1); Word >>= 1)
+		{
+			BitIndex++;
+		}
+		return BitIndex;
+#endif
+	}
+};
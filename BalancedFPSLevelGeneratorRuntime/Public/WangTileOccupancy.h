@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "WangTileTypes.h"
+#include <array>
+#include "WangTileSolver.h"
+
+/**
+* Which parts of a tile its objects cover, as a RESOLUTION by RESOLUTION bitmap (one 64-bit word per
+* row of cells, from the south; bit X of a row is the cell X cells from the west side). The footprint
+* is measured a whole row at a time: open area by counting bits, and paths by flood fills and
+* erosions made of shifts and masks.
+*
+* Built once for each tile (from the bounds of its objects), as the tile's profile is.
+*/
+class BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileOccupancy
+{
+public:
+
+	// Functions/Methods:
+
+	/**
+	* Mark the cells a box covers, in tile space: from (0, 0) at the south-west corner of the tile
+	* to (1, 1) at the north-east corner. The box is clipped to the tile.
+	*/
+	void AddBox(float MinX, float MinY, float MaxX, float MaxY);
+
+	bool IsOccupied(int X, int Y) const { return (Rows[Y] >> X) & 1; }
+
+	int GetOccupiedCellCount() const;
+
+	/** Measure what the objects leave open (see FWangTileFootprint). */
+	FWangTileFootprint Measure() const;
+
+	// Constant Values:
+
+	/** The cells along each side (one row of cells is one 64-bit word). */
+	static const int RESOLUTION = 64;
+
+private:
+
+	typedef std::array<uint64_t, RESOLUTION> FOccupancyBitmap;
+
+	// Functions/Methods:
+
+	/** For every open cell that can be reached (north, east, south or west) from the seed cells. */
+	static FOccupancyBitmap FloodFill(const FOccupancyBitmap& Open, const FOccupancyBitmap& Seeds);
+
+	/** For the open cells whose 8 neighbours are open too (each erosion narrows every path by a cell on each side). */
+	static FOccupancyBitmap Erode(const FOccupancyBitmap& Open);
+
+	/**
+	* For the cells along one side, Inset cells in from it (not including the corners, which belong
+	* to two sides).
+	*/
+	static FOccupancyBitmap GetSideCells(EWangTileSide Side, int Inset);
+
+	/** Whether any open cell along one side (Inset cells in) can be reached from one along another. */
+	static bool HasPathBetweenSides(const FOccupancyBitmap& Open, int Inset);
+
+	static int CountCells(const FOccupancyBitmap& Bitmap);
+
+	// Properties:
+
+	/** Bit X of Rows[Y] is set if cell (X, Y) is covered. */
+	FOccupancyBitmap Rows = {};
+};
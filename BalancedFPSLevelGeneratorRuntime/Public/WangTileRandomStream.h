@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "WangTileTypes.h"
+
+/**
+* A PCG32 (XSH-RR) pseudo-random number stream, see http://www.pcg-random.org.
+* Unlike the standard library's engines and distributions, its output is specified
+* exactly, so the same seed gives the same level on every platform and compiler.
+*/
+class FWangTileRandomStream
+{
+public:
+
+	// Functions/Methods:
+
+	FWangTileRandomStream() { Initialise(0, 0); }
+	explicit FWangTileRandomStream(uint64_t Seed, uint64_t Stream = 0) { Initialise(Seed, Stream); }
+
+	/** Restart the sequence (a different Stream gives an independent sequence for the same Seed). */
+	void Initialise(uint64_t Seed, uint64_t Stream = 0)
+	{
+		State = 0;
+		Increment = (Stream << 1) | 1;
+		GetNextUInt32();
+		State += Seed;
+		GetNextUInt32();
+	}
+
+	/**
+	* Mix a key (such as a cell index) into a seed with the SplitMix64 finaliser, so that
+	* nearby keys still give unrelated streams.
+	*/
+	static uint64_t DeriveSeed(uint64_t Seed, uint64_t Key)
+	{
+		uint64_t Mixed = Seed + (Key + 1) * 0x9E3779B97F4A7C15ULL;
+		Mixed = (Mixed ^ (Mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		Mixed = (Mixed ^ (Mixed >> 27)) * 0x94D049BB133111EBULL;
+		return Mixed ^ (Mixed >> 31);
+	}
+
+	uint32_t GetNextUInt32()
+	{
+		uint64_t PreviousState = State;
+		State = PreviousState * MULTIPLIER + Increment;
+
+		uint32_t XorShifted = static_cast<uint32_t>(((PreviousState >> 18) ^ PreviousState) >> 27);
+		uint32_t Rotation = static_cast<uint32_t>(PreviousState >> 59);
+		return (XorShifted >> Rotation) | (XorShifted << ((32 - Rotation) & 31));
+	}
+
+	/** For an unbiased value in [0, Bound), using Lemire's multiply-and-reject method. */
+	uint32_t GetBoundedUInt32(uint32_t Bound)
+	{
+		uint64_t Product = static_cast<uint64_t>(GetNextUInt32()) * Bound;
+		uint32_t LowBits = static_cast<uint32_t>(Product);
+
+		if (LowBits < Bound)
+		{
+			uint32_t Threshold = (0u - Bound) % Bound;
+			while (LowBits < Threshold)
+			{
+				Product = static_cast<uint64_t>(GetNextUInt32()) * Bound;
+				LowBits = static_cast<uint32_t>(Product);
+			}
+		}
+
+		return static_cast<uint32_t>(Product >> 32);
+	}
+
+private:
+
+	// Properties:
+
+	uint64_t State;
+	uint64_t Increment;
+
+	// Constant Values:
+
+	static const uint64_t MULTIPLIER = 6364136223846793005ULL;
+};
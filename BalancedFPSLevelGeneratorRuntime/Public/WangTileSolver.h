@@ -0,0 +1,533 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "WangTileTypes.h"
+#include <atomic>
+#include <functional>
+#include <map>
+#include <vector>
+#include "WangTileGrid.h"
+#include "WangTileAliasTable.h"
+#include "WangTileMask.h"
+#include "WangTileRandomStream.h"
+
+/** The sides of a tile (in the order of a Zone's Edges, see EZoneEdgeSide). */
+enum class EWangTileSide : uint8_t
+{
+	North,
+	East,
+	South,
+	West,
+	Count
+};
+
+/**
+* What a tile's objects leave open, measured from its occupancy (see FWangTileOccupancy). Each
+* value is a share of the tile (or of its width), from 0 to 1.
+*/
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileFootprint
+{
+	/** The share of the tile that no object covers (negative if the footprint was not measured). */
+	float OpenArea = -1.0f;
+
+	/** The width of the widest path that still leads from one side of the tile to another. */
+	float ChokepointWidth = 0.0f;
+
+	/** The share of each side (indexed by EWangTileSide) that opens onto a path to another side. */
+	float SideOpenings[static_cast<int>(EWangTileSide::Count)] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+	/** For each side, the other sides its openings lead to (a bit, 1 << EWangTileSide, for each). */
+	uint8_t SideLinks[static_cast<int>(EWangTileSide::Count)] = { 0, 0, 0, 0 };
+
+	bool IsMeasured() const { return OpenArea >= 0.0f; }
+
+	float GetMeanSideOpening() const
+	{
+		return (SideOpenings[0] + SideOpenings[1] + SideOpenings[2] + SideOpenings[3]) /
+			static_cast<int>(EWangTileSide::Count);
+	}
+};
+
+/**
+* The static values of one Zone (Wang Tile), as the solver sees them.
+* These are gathered from the Zone Blueprints by the level generator tool.
+*/
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileDefinition
+{
+	/** Precise to 2 decimal places (see AZone::DetermineInitialZoneValues()). */
+	float DispersionCoefficient = 0.0f;
+
+	/** For the number of static-mesh components in this Zone. */
+	int ZoneObjectCount = 0;
+
+	/** The sum of the XY-scale of the objects in this Zone. */
+	float TotalZoneObjectArea = 0.0f;
+
+	/** How often this tile is picked, relative to the other candidates for the same cell. */
+	float SelectionWeight = 1.0f;
+
+	/** If measured, the path density is found from this, rather than estimated (see FWangTileCoefficients). */
+	FWangTileFootprint Footprint;
+
+	/**
+	* The colour of each side (indexed by EWangTileSide). Once every side of every tile has
+	* a colour, tiles are matched by their colours, rather than by their Coefficients.
+	*/
+	int EdgeColours[static_cast<int>(EWangTileSide::Count)] = { NO_EDGE_COLOUR, NO_EDGE_COLOUR,
+		NO_EDGE_COLOUR, NO_EDGE_COLOUR };
+
+	int GetEdgeColour(EWangTileSide Side) const { return EdgeColours[static_cast<int>(Side)]; }
+
+	/**
+	* For a stair or ramp tile, the floors it leads to (VERTICAL_LINK_UP and/or VERTICAL_LINK_DOWN).
+	* A tile that leads up must have a tile that leads down above it, and only such a tile.
+	*/
+	uint8_t VerticalLinks = 0;
+
+	bool LinksUp() const { return (VerticalLinks & VERTICAL_LINK_UP) != 0; }
+	bool LinksDown() const { return (VerticalLinks & VERTICAL_LINK_DOWN) != 0; }
+
+	// Constant Values:
+
+	static const int NO_EDGE_COLOUR = -1;
+
+	static const uint8_t VERTICAL_LINK_UP = 1;
+	static const uint8_t VERTICAL_LINK_DOWN = 2;
+
+	/** So that the table of candidates (one set per pair of colours) stays small. */
+	static const int MAX_EDGE_COLOUR_COUNT = 64;
+};
+
+/** The Defensiveness and Flanking Coefficient equations, as detailed in the report. */
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileCoefficients
+{
+	/** For calculating the Defensiveness and Flanking Coefficients of a Zone. */
+	static constexpr float HIGHEST_ZONE_OBJECT_COUNT = 5.0f;
+
+	static float FindFlankingCoefficient(float SurroundingZones, float AdjacentZones);
+
+	static float FindDefensivenessCoefficient(int ZoneObjectCount, float TotalZoneObjectArea,
+		float AdjacentZones);
+
+	/** As above, with the tile's measured path density, if its footprint was measured. */
+	static float FindDefensivenessCoefficient(const FWangTileDefinition& Tile, float AdjacentZones);
+
+	/**
+	* For the path density of a tile's footprint: how much of the sides facing the adjacent Zones
+	* open onto paths through it, narrowed by its chokepoint (a fully open tile has AdjacentZones).
+	*/
+	static float FindMeasuredPathDensity(const FWangTileFootprint& Footprint, float AdjacentZones);
+
+	/** The surrounding and adjacent Zone counts used for each placement. */
+	static float GetSurroundingZones(EWangTilePlacement Placement);
+	static float GetAdjacentZones(EWangTilePlacement Placement);
+
+private:
+
+	/**
+	* Perform the bulk of the calculations for finding the PathDensity.
+	* To in turn, determine the Defensiveness Coefficient (for a tile without a measured footprint).
+	*/
+	static float FindNonAbsolutePathDensity(float AdjacentZones);
+};
+
+/**
+* Runs Task(0) to Task(TaskCount - 1) concurrently, and returns once all of them have.
+* Lets the engine lend the solver its own task graph (see ParallelFor()).
+*/
+typedef std::function<void(int TaskCount, const std::function<void(int TaskIndex)>& Task)> FWangTileParallelFor;
+
+/** What the solver needs to know about the level-generation area. */
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileSolverSettings
+{
+	/** The size of the grid, in tiles (X is eastwards, Y is northwards). */
+	int GridWidth = 0;
+	int GridHeight = 0;
+
+	/**
+	* The floors of the grid (Z is upwards). Each floor has the same corners and edges, and a tile
+	* is also matched against the tile below it (see FWangTileDefinition::VerticalLinks).
+	*/
+	int GridDepth = 1;
+
+	/**
+	* For seeding the pseudo-random number streams (one per cell). The same Seed gives
+	* the same layout, however many threads are used. 32 bits, as with the Seed of the
+	* editor tool, AZoneArenaGenerator and a layout file.
+	*/
+	uint32_t Seed = 0;
+
+	/**
+	* How many rows may be solved at once (each row follows just behind the row to its south, and
+	* the same row on the floor below).
+	*/
+	int ThreadCount = 1;
+
+	/** If not set, std::thread is used when ThreadCount is more than 1. */
+	FWangTileParallelFor ParallelFor;
+
+	// The tiles placed in the corners and along the edges of the area:
+
+	int SouthWestCornerTile = -1;
+	int SouthEastCornerTile = -1;
+	int NorthEastCornerTile = -1;
+	int NorthWestCornerTile = -1;
+
+	int NorthEdgeTile = -1;
+	int EastEdgeTile = -1;
+	int SouthEdgeTile = -1;
+	int WestEdgeTile = -1;
+
+	/**
+	* WangTile2 and WangTile10 are only matched against these pre-defined
+	* sets of tiles, instead of against the Coefficients.
+	*/
+	int WangTile2 = -1;
+	int WangTile10 = -1;
+	std::vector<int> ApplicableTilesForWangTile2;
+	std::vector<int> ApplicableTilesForWangTile10;
+
+	/** For comparing Zone Defensiveness Coefficient Values. */
+	float DefensivenessThreshold = 0.80f;
+
+	/** If set (from another thread), the solve stops at the end of the current row and fails. */
+	const std::atomic<bool>* CancellationFlag = nullptr;
+
+	/**
+	* Keep the tiles each cell could still hold, and only place tiles that keep every cell
+	* fillable (see FWangTileConstraintPropagator). Slower, and on one thread per layout, but a
+	* tile then suits both of its neighbours (and the tile below it) far more often.
+	*/
+	bool PropagateConstraints = false;
+
+	/** How many placements may be undone (in total, for each layout) when propagating constraints. */
+	int MaxBacktracks = 100000;
+
+	/** How many placements back may be undone, from the latest one. */
+	int MaxBacktrackDepth = 64;
+
+	/**
+	* Check that every walkable tile can be reached from every other (see FWangTileConnectivity),
+	* and solve the tiles around a region that is cut off again (the smallest region first).
+	* SolveBestOf() then prefers the candidates that are connected.
+	*/
+	bool RequireConnectivity = false;
+
+	/** How many times (for each layout) a region may be solved again, before the layout is kept as it is. */
+	int MaxConnectivityRepairs = 64;
+};
+
+/** What the last solve did (for the level generator's stats). */
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileSolverStats
+{
+	/** Evaluating the Coefficients, and the tiles that may follow each tile. */
+	double PrepareSeconds = 0.0;
+
+	/** Placing the tiles (across every thread, for every candidate layout). */
+	double PlacementSeconds = 0.0;
+
+	/** The total size of the candidate sets that interior tiles were chosen from. */
+	uint64_t CandidatesConsidered = 0;
+
+	/** Interior tiles where no tile suited both neighbours, so only the tile to the west was used. */
+	uint64_t WestOnlyFallbacks = 0;
+
+	/** Interior tiles where no tile suited the tile to the west as well as the tile below, so only the tile below was used. */
+	uint64_t VerticalOnlyFallbacks = 0;
+
+	// When propagating constraints, the placements undone, and the cells that no tile could fill:
+	uint64_t Backtracks = 0;
+	uint64_t RelaxedCells = 0;
+
+	/** The cut-off regions solved again (see FWangTileSolverSettings::RequireConnectivity). */
+	uint64_t ConnectivityRepairs = 0;
+
+	/**
+	* Tiles with no tile across the Defensiveness threshold from them (see PrepareCoefficientCandidates()),
+	* or, with edge colours, pairs of colours that no tile matches, even to the west.
+	*/
+	int DispersionFallbacks = 0;
+	int AnyTileFallbacks = 0;
+
+	/** Classes of cell (see FWangTileSolver::GetVerticalClass()) that no tile suits, so the tile below is not matched. */
+	int VerticalLinkFallbacks = 0;
+
+	void AddPlacementCounts(const FWangTileSolverStats& Other)
+	{
+		CandidatesConsidered += Other.CandidatesConsidered;
+		WestOnlyFallbacks += Other.WestOnlyFallbacks;
+		VerticalOnlyFallbacks += Other.VerticalOnlyFallbacks;
+		Backtracks += Other.Backtracks;
+		RelaxedCells += Other.RelaxedCells;
+		ConnectivityRepairs += Other.ConnectivityRepairs;
+	}
+};
+
+/**
+* How balanced a layout is, between the southern and northern halves of the area
+* (where the two teams start, across every floor). Each value is the difference between
+* the mean Coefficient of the two halves, so lower is better, and 0 is perfectly balanced.
+* The Flanking Coefficient only depends on where a tile is placed, so it is always
+* the same for both halves, and is not scored.
+*/
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileLayoutScore
+{
+	float DefensivenessImbalance = 0.0f;
+	float DispersionImbalance = 0.0f;
+
+	float GetTotalImbalance() const { return DefensivenessImbalance + DispersionImbalance; }
+};
+
+/** The spread of scores across the candidate layouts of FWangTileSolver::SolveBestOf(). */
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileCandidateReport
+{
+	int CandidateCount = 0;
+
+	/** The most balanced candidate, and the Seed that Solve() would generate it from. */
+	int BestCandidate = -1;
+	uint32_t BestSeed = 0;
+	FWangTileLayoutScore BestScore;
+
+	// Of the total imbalance, across every candidate:
+	float MeanImbalance = 0.0f;
+	float WorstImbalance = 0.0f;
+	float ImbalanceStandardDeviation = 0.0f;
+
+	/** The candidates still cut off after being repaired (if connectivity is required). */
+	int DisconnectedCandidates = 0;
+};
+
+/** The tiles that may be placed between a pair of neighbouring tiles (to the west and south), and above the tile below. */
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileCandidateSet
+{
+	int TileCount = 0;
+
+	/** If no tile suited both neighbours, so only the tile to the west was considered. */
+	bool IsWestOnly = false;
+
+	/** If no tile suited the tile to the west either, so only the tile below was considered. */
+	bool IsVerticalOnly = false;
+
+	/** Where its mask (of the solver's MaskWordCount words) and alias table (of TileCount entries) start. */
+	int MaskStart = 0;
+	int AliasTableStart = 0;
+};
+
+class FWangTileConnectivity;
+
+/**
+* Places Zones (Wang Tiles) across a grid, one row at a time, and one floor at a time.
+* Each tile in the interior of the area is chosen by comparing the Coefficients of the
+* tiles already placed to the west and to the south of it, from those that suit the
+* tile below it.
+*
+* Rows can be pipelined across threads: a row only waits until the tiles to the
+* south of, and below, its next cell have been placed.
+*/
+class BALANCEDFPSLEVELGENERATORRUNTIME_API FWangTileSolver
+{
+public:
+
+	// Functions/Methods:
+
+	explicit FWangTileSolver(std::vector<FWangTileDefinition> InTileSet);
+
+	/**
+	* Returns false (leaving OutGrid empty) if the settings are not valid for this tile-set (such as if
+	* a corner or edge tile leads to another floor).
+	*/
+	bool Solve(const FWangTileSolverSettings& Settings, FWangTileGrid& OutGrid);
+
+	/**
+	* Solve CandidateCount layouts (from the Seeds Settings.Seed onwards, wrapping around after the
+	* largest Seed), spread across Settings.ThreadCount threads, and keep the most balanced of them
+	* in OutGrid (of those that are connected, if Settings.RequireConnectivity).
+	* The same Seed and CandidateCount always give the same layout.
+	*/
+	bool SolveBestOf(const FWangTileSolverSettings& Settings, int CandidateCount, FWangTileGrid& OutGrid,
+		FWangTileCandidateReport& OutReport);
+
+	/**
+	* Solve part of an existing layout again:
+	* - the unpinned tiles in RerollRect (on every floor) are chosen afresh (from streams seeded by RerollSeed),
+	* - the cells without a tile (in RefillRects, see FWangTileGrid::Resize()) are filled,
+	* - and a tile that depends on a changed tile (to its west or south, or below it) is only
+	*   changed if it no longer suits its neighbours.
+	* So the work done follows the size of the edit, rather than the size of the grid.
+	* OutChangedCells lists the index of every cell whose tile changed (once each), including
+	* those changed to reconnect the layout, if Settings.RequireConnectivity.
+	*/
+	bool Resolve(const FWangTileSolverSettings& Settings, FWangTileGrid& Grid, const FWangTileRect& RerollRect,
+		const std::vector<FWangTileRect>& RefillRects, uint64_t RerollSeed, std::vector<int>& OutChangedCells);
+
+	/** Score a layout (valid after a call to Solve() or SolveBestOf()). */
+	FWangTileLayoutScore ScoreLayout(const FWangTileGrid& Grid) const;
+
+	/** For what the last call to Solve() or SolveBestOf() did. */
+	const FWangTileSolverStats& GetStats() const { return Stats; }
+
+	int GetTileCount() const { return static_cast<int>(TileSet.size()); }
+
+	/** If every side of every tile has an edge colour (see FWangTileDefinition::EdgeColours). */
+	bool UsesEdgeColours() const;
+
+	/** The Coefficients of a placed tile (valid after a call to Solve()). */
+	float GetDefensivenessCoefficient(const FWangTileCell& Cell) const;
+	static float GetFlankingCoefficient(EWangTilePlacement Placement);
+
+	/** Run Task(0) to Task(WorkerCount - 1) concurrently, as the settings allow. */
+	static void RunWorkers(const FWangTileSolverSettings& Settings, int WorkerCount,
+		const std::function<void(int WorkerIndex)>& Task);
+
+private:
+
+	// Functions/Methods:
+
+	bool SettingsAreValid(const FWangTileSolverSettings& Settings) const;
+
+	/** Precompute the Coefficients, and the tiles that may follow each tile. */
+	void PrepareCandidates(const FWangTileSolverSettings& Settings);
+
+	/** For the tiles in the corners and along the edges (the same on every floor). */
+	int GetBoundaryTile(const FWangTileSolverSettings& Settings, int X, int Y) const;
+
+	/**
+	* For which of the VERTICAL_CLASS_COUNT sets of tiles an interior cell may hold, from the tile
+	* below it (which must be placed), and whether it is on the top floor.
+	*/
+	int GetVerticalClass(const FWangTileGrid& Grid, int CellIndex, int Z) const;
+
+	/** Solve() for settings that have been validated, and candidates that have been prepared. */
+	bool SolvePrepared(const FWangTileSolverSettings& Settings, FWangTileGrid& OutGrid,
+		FWangTileSolverStats& OutPlacementStats) const;
+
+	/** SolvePrepared(), for Settings.PropagateConstraints. */
+	bool SolvePropagating(const FWangTileSolverSettings& Settings, FWangTileGrid& OutGrid,
+		FWangTileSolverStats& OutPlacementStats) const;
+
+	/**
+	* Place every tile in row Row (Y of floor Z, counted from the south of the lowest floor), waiting
+	* on the row to the south, and the same row on the floor below, as required.
+	*/
+	void SolveRow(const FWangTileSolverSettings& Settings, int Row, FWangTileGrid& Grid,
+		std::vector<std::atomic<int>>& PlacedCellsPerRow, const std::atomic<bool>& SolveCancelled,
+		FWangTileSolverStats& WorkerStats) const;
+
+	/** Resolve() for settings that have been validated, and candidates that have been prepared. */
+	void ResolvePrepared(const FWangTileSolverSettings& Settings, FWangTileGrid& Grid, const FWangTileRect& RerollRect,
+		const std::vector<FWangTileRect>& RefillRects, uint64_t RerollSeed, std::vector<int>& OutChangedCells,
+		FWangTileSolverStats& OutPlacementStats) const;
+
+	/**
+	* Solve the tiles around the smallest cut-off region again (with a new stream each time), until
+	* the layout is connected, or Settings.MaxConnectivityRepairs is reached. Returns true if the
+	* layout is connected. Any cell changed is added to OutChangedCells (if set).
+	*/
+	bool RepairConnectivity(const FWangTileSolverSettings& Settings, FWangTileGrid& Grid,
+		FWangTileConnectivity& Connectivity, std::vector<int>* OutChangedCells,
+		FWangTileSolverStats& OutPlacementStats) const;
+
+	/** Place the tile in one cell again, for Resolve(). Returns true if its tile changed. */
+	bool ResolveCell(const FWangTileSolverSettings& Settings, FWangTileGrid& Grid, int X, int Y, int Z,
+		const FWangTileRect& RerollRect, uint64_t RerollSeed, FWangTileSolverStats& OutPlacementStats) const;
+
+	/** Find the candidates for the tiles to the west and south, from their Coefficients. */
+	void PrepareCoefficientCandidates(const FWangTileSolverSettings& Settings);
+
+	/** Find the candidates for each pair of colours (on the west and south sides of a tile). */
+	void PrepareEdgeColourCandidates();
+
+	/** For the tiles that may be placed in each class of cell (see GetVerticalClass()). */
+	void PrepareVerticalClassMasks();
+
+	/**
+	* Add the candidate sets of a pair of neighbours (at PairIndex in CandidateSetIds) for each
+	* vertical class: the candidates that suit the tile below, then the tiles to the west that
+	* do, then any tile that does (and if none do, the candidates as they are).
+	*/
+	void AddVerticalCandidateSets(int PairIndex, const uint64_t* Candidates, const uint64_t* WestCandidates,
+		bool IsWestOnly, std::map<std::vector<uint64_t>, int>* CandidateSetIdsByMask);
+
+	/** For the id of the candidate set of these tiles (adding it, if it is new). */
+	int FindOrAddCandidateSet(const uint64_t* Candidates, bool IsWestOnly, bool IsVerticalOnly,
+		std::map<std::vector<uint64_t>, int>& CandidateSetIdsByMask);
+
+	/** The tiles that may be placed between the tiles to the west and south, in a cell of the given vertical class. */
+	const FWangTileCandidateSet& GetInteriorCandidates(const FWangTileCell& WestCell,
+		const FWangTileCell& SouthCell, int VerticalClass) const;
+
+	/** For a tile in the interior of the area, considering the tiles to the west and south, and below. */
+	int GetInteriorTile(const FWangTileCell& WestCell, const FWangTileCell& SouthCell, int VerticalClass,
+		FWangTileRandomStream& CellRandomStream, FWangTileSolverStats& WorkerStats) const;
+
+	// Properties:
+
+	std::vector<FWangTileDefinition> TileSet;
+
+	// The Coefficients, as contiguous arrays (for FWangTileMask::Compare()). The Flanking
+	// Coefficient only depends on the placement, so it needs no array (see GetFlankingCoefficient()):
+
+	/** Indexed by [Placement * TileCount + Tile]. */
+	std::vector<float> DefensivenessCoefficients;
+
+	// Indexed by tile:
+	std::vector<float> DispersionCoefficients;
+	std::vector<float> SelectionWeights;
+
+	/** For the words in each tile mask (see FWangTileMask::GetWordCount()). */
+	int MaskWordCount = 0;
+
+	/**
+	* The candidates for a cell only depend on the row of the tile to its west, and the column
+	* of the tile to its south, in CandidateSetIds. These are indexed by [Placement * TileCount + Tile]:
+	* - with Coefficients, many tiles share a row and column (such as every tile on the same
+	*   side of the Defensiveness threshold),
+	* - and with edge colours, the row is the colour of the tile's east side, and the column is
+	*   the colour of its north side.
+	*/
+	std::vector<int> WestCandidateRows;
+	std::vector<int> SouthCandidateColumns;
+
+	/**
+	* The tiles that may be placed to the east of, and to the north of, each placed tile (as masks
+	* of MaskWordCount words, starting at [(Placement * TileCount + Tile) * MaskWordCount]).
+	*/
+	std::vector<uint64_t> EastNeighbourMasks;
+	std::vector<uint64_t> NorthNeighbourMasks;
+
+	/**
+	* Indexed by [VerticalClass * CandidatePairCount + West candidate row + South candidate column],
+	* into CandidateSets.
+	*/
+	std::vector<int> CandidateSetIds;
+	int CandidatePairCount = 0;
+
+	/** For the tiles that may be placed in each class of cell (as masks of MaskWordCount words). */
+	std::vector<uint64_t> VerticalClassMasks;
+
+	/** Indexed by tile (see FWangTileDefinition::VerticalLinks). */
+	std::vector<uint8_t> TileVerticalLinks;
+
+	std::vector<FWangTileCandidateSet> CandidateSets;
+	std::vector<uint64_t> CandidateMasks;
+	std::vector<FWangTileAliasEntry> AliasEntries;
+
+	FWangTileSolverStats Stats;
+
+	// Constant Values:
+
+	/** How many cells a row places between telling the row to its north (and above). */
+	static const int ROW_PROGRESS_INTERVAL = 32;
+
+	/**
+	* A cell is classed by whether the tile below it leads up (so its tile must lead down, and
+	* otherwise must not), and whether it is on the top floor (so its tile must not lead up).
+	*/
+	static const int VERTICAL_CLASS_LINKED_BELOW = 1;
+	static const int VERTICAL_CLASS_TOP_FLOOR = 2;
+	static const int VERTICAL_CLASS_COUNT = 4;
+
+	/** So that the streams of connectivity repairs never meet those of Resolve()'s rerolls. */
+	static const uint64_t CONNECTIVITY_REPAIR_STREAM_OFFSET = uint64_t(1) << 48;
+};
@@ -0,0 +1,13 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+// The WangTile* headers (and their source files) are plain C++, so that the placement algorithm can be
+// built, tested and profiled without the engine. Each of them includes this header first:
+#include <cstddef>
+#include <cstdint>
+
+// (Outside the engine, there is no module to export from):
+#ifndef BALANCEDFPSLEVELGENERATORRUNTIME_API
+#define BALANCEDFPSLEVELGENERATORRUNTIME_API
+#endif
@@ -0,0 +1,181 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Runtime/Engine/Classes/GameFramework/Actor.h"
+#include "UObject/NoExportTypes.h"
+#include <vector> // For misc. collections.
+#include "FPSLevelGeneratorEdge.h" // For this Zone's Edges.
+#include "WangTileSolver.h" // For this Zone's footprint.
+#include "Zone.generated.h"
+
+/**
+* What the solver needs to know about a Zone Blueprint, taken from its class (rather than from a
+* Zone placed in the level), so that it only has to be found once for each Blueprint.
+*/
+struct FZoneProfile
+{
+	int ZoneObjectCount = 0;
+	float TotalZoneObjectArea = 0.0f;
+	float DispersionCoefficient = 0.0f;
+	float SelectionWeight = 1.0f;
+
+	/** What the Zone's objects leave open (see AZone::MeasureZoneFootprint()). */
+	FWangTileFootprint Footprint;
+
+	/** Indexed by EZoneEdgeSide (see UFPSLevelGeneratorEdge::EdgeColour). */
+	int32 EdgeColours[4] = { UFPSLevelGeneratorEdge::NO_EDGE_COLOUR, UFPSLevelGeneratorEdge::NO_EDGE_COLOUR,
+		UFPSLevelGeneratorEdge::NO_EDGE_COLOUR, UFPSLevelGeneratorEdge::NO_EDGE_COLOUR };
+
+	/** For a stair or ramp Zone (see FWangTileDefinition::VerticalLinks). */
+	uint8 VerticalLinks = 0;
+};
+
+/** A static-mesh component of a Zone Blueprint's class, and where it sits within the Zone. */
+struct FZoneObjectTemplate
+{
+	const UStaticMeshComponent* Template = nullptr;
+
+	/** Relative to the Zone (as each of its objects is placed when the Zone is spawned). */
+	FTransform ZoneObjectTransform;
+};
+
+/**
+ * This class represents the area of a level, that the space-filling algorithm
+ * (Wang Tiles, as of 13/03/2018), will use to fix components of the level 
+ * together.
+ */
+UCLASS()
+class BALANCEDFPSLEVELGENERATORRUNTIME_API AZone : public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	// Properties:
+
+	/**
+	* How often this Zone is chosen, relative to the other Zones that suit the same neighbours
+	* (a Zone with a weight of 0 is only chosen if every other Zone that suits them has one too).
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "Level Generation", meta = (ClampMin = "0.0"))
+	float SelectionWeight;
+
+	/** This Zone's Edges (one for each side, in the order of EZoneEdgeSide). */
+	UPROPERTY(EditDefaultsOnly, Instanced, EditFixedSize, Category = "Level Generation")
+	TArray<UFPSLevelGeneratorEdge*> ZoneEdges;
+
+	/**
+	* For a stair or ramp Zone, in an arena of several floors: it is only placed beneath a Zone that
+	* leads down, and a Zone that leads down is only placed above one that leads up.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "Level Generation|Floors")
+	bool bLeadsUp;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Level Generation|Floors")
+	bool bLeadsDown;
+
+	// Constant values:
+
+	/** These values are used to idenfiy each Zone. */
+	const FName WANG_TILE_ONE = "WangTile1";
+	const FName WANG_TILE_TWO = "WangTile2";
+	const FName WANG_TILE_THREE = "WangTile3";
+	const FName WANG_TILE_FOUR = "WangTile4";
+	const FName WANG_TILE_FIVE = "WangTile5";
+	const FName WANG_TILE_SIX = "WangTile6";
+	const FName WANG_TILE_SEVEN = "WangTile7";
+	const FName WANG_TILE_EIGHT = "WangTile8";
+	const FName WANG_TILE_NINE = "WangTile9";
+	const FName WANG_TILE_TEN = "WangTile10";
+	const FName WANG_TILE_ELEVEN = "WangTile11";
+	const FName WANG_TILE_TWELVE = "WangTile12";
+	const FName WANG_TILE_THIRTEEN = "WangTile13";
+	const FName WANG_TILE_FOURTEEN = "WangTile14";
+	const FName WANG_TILE_FIFTHTEEN = "WangTile15";
+	const FName WANG_TILE_SIXTEEN = "WangTile16";
+	const FName WANG_TILE_SEVENTEEN = "WangTile17";
+	const FName WANG_TILE_EIGHTTEEN = "WangTile18";
+	const FName WANG_TILE_NINETEEN = "WangTile19";
+	const FName WANG_TILE_TWENTY = "WangTile20";
+	const FName WANG_TILE_TWENTY_ONE = "WangTile21";
+	const FName WANG_TILE_TWENTY_TWO = "WangTile22";
+
+	/** For the default ZoneEdge properties (during initialisation). */
+	static const int DEFAULT_ZONE_EDGE_COUNT = 4;
+
+	/** Half the width of the square a Zone fills (at its default scale), about its origin. */
+	static constexpr float ZONE_FOOTPRINT_HALF_WIDTH = 50.0f;
+
+	// Functions/Methods:
+
+	/** Default constructor (required by UE4). */
+	AZone();
+
+	/** For proper initialisation. */
+	void InitialiseZone();
+	
+	/** Determine these Coefficients, now the Zone will be placed. */
+	void DetermineDefensivenessAndFlankingCoefficients(float SurroundingZones,
+		float AdjacentZones);
+
+	// Get functions:
+
+	float GetDefensivenessCoefficient();
+	float GetFlankingCoefficient();
+	float GetDispersonCoefficient();
+	int GetZoneObjectCount();
+	float GetTotalZoneObjectArea();
+
+	/** For the index of this Zone in the tile-set (WangTile1 is 0), or INDEX_NONE. */
+	int GetWangTileIndex();
+
+	/**
+	* Profile a Zone Blueprint's class (at WangTileIndex in the tile-set), from the templates of its
+	* static-mesh components (both native and those added in the Blueprint's components panel).
+	*/
+	static FZoneProfile BuildZoneProfile(UClass* ZoneClass, int WangTileIndex);
+
+	/**
+	* For the templates of a Zone Blueprint class's static-mesh components (both native and those
+	* added in the Blueprint's components panel, of it and any Blueprint it derives from).
+	*/
+	static void GetZoneObjectTemplates(UClass* ZoneClass, TArray<FZoneObjectTemplate>& OutZoneObjectTemplates);
+
+	/**
+	* Rasterise the bounds of the Zone objects that have collision into an occupancy bitmap of the
+	* Zone's square, and measure what they leave open (the solver's north is the Zone's -Y).
+	*/
+	static FWangTileFootprint MeasureZoneFootprint(const TArray<FZoneObjectTemplate>& ZoneObjectTemplates);
+
+	/** For the Dispersion Coefficient of the Zone at WangTileIndex in the tile-set (0 if there is none). */
+	static float GetDispersionCoefficientForWangTileIndex(int WangTileIndex);
+
+private:
+
+	// Properties:
+
+	/** To hold all the objects in the Zone. */
+	TArray<UStaticMeshComponent*> ZoneObjects;
+
+	// For the Coefficients used in determining Zone placement:
+	float DefensivenessCoefficient;
+	float FlankingCoefficient;
+	float DispersionCoefficient;
+
+	/** Measured from ZoneObjects (in InitialiseZone()). */
+	FWangTileFootprint Footprint;
+
+	// Constant Values:
+
+	const FVector DEFAULT_ZONE_EXTENTS = FVector(100.0f, 100.0f, 100.0f);
+
+	// Functions/Methods:
+
+	/** Determine the initial values of this zone. */
+	void DetermineInitialZoneValues();
+
+	/** For the footprint of one object in the Zone (its relative scale, in X and Y). */
+	static float GetZoneObjectArea(const UStaticMeshComponent* ZoneObject);
+};
@@ -0,0 +1,187 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Async/Future.h"
+#include <atomic>
+
+// Bespoke header files:
+#include "Zone.h"
+#include "WangTileGrid.h"
+
+#include "ZoneArenaGenerator.generated.h"
+
+struct FWangTileDefinition;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnZoneArenaGenerated, bool, bSucceeded, float, GenerationSeconds);
+
+/** The Zones of one Zone Blueprint that are not in the arena, ready to be used again. */
+USTRUCT()
+struct FZonePool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AZone*> Zones;
+};
+
+/**
+ * Generates an arena of Zones in a running game (such as on a dedicated server, behind the
+ * loading screen at the start of a match), with the same solver and tile-set rules as the
+ * editor tool, so a Seed gives the same layout in both. The layout is solved off the game
+ * thread, then its Zones are spawned over several ticks. The Zones of the last arena are
+ * pooled (hidden, without collision) and used again before any more are spawned.
+ *
+ * Only the server (or a standalone game) generates; clients get the Zones as their
+ * Blueprints replicate.
+ */
+UCLASS()
+class BALANCEDFPSLEVELGENERATORRUNTIME_API AZoneArenaGenerator : public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	// Functions/Methods:
+
+	/** Standard constructor. */
+	AZoneArenaGenerator();
+
+	/**
+	* Replace the current arena with the one for NewSeed (OnArenaGenerated is broadcast once it
+	* is spawned). Returns false if generation could not begin.
+	*/
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Level Generation")
+	bool GenerateArena(int32 NewSeed);
+
+	/**
+	* Replace the current arena with the one saved in the given layout file (by the editor tool's
+	* SaveLayout), read off the game thread then spawned as for GenerateArena. Returns false if
+	* the file cannot be read, or was saved with different Zone Blueprints.
+	*/
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Level Generation")
+	bool LoadArena(const FString& LayoutFilename);
+
+	UFUNCTION(BlueprintPure, Category = "Level Generation")
+	bool IsGeneratingArena() const;
+
+	virtual void BeginPlay() override;
+	virtual void Tick(float DeltaSeconds) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Properties:
+
+	/** The Zone Blueprints (WangTile1 to WangTile22, in that order). */
+	UPROPERTY(EditAnywhere, EditFixedSize, Category = "Level Generation")
+	TArray<TSubclassOf<AZone>> ZoneClasses;
+
+	/** The number of Zones along each axis (from this actor, along its X and Y axes). */
+	UPROPERTY(EditAnywhere, Category = "Level Generation", meta = (ClampMin = "3"))
+	FIntPoint ArenaSizeInTiles;
+
+	/**
+	* The storeys of the arena, each FloorHeight above the last, joined by the stair and ramp Zones
+	* (see AZone::bLeadsUp). Every floor has the same corner and edge Zones.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Level Generation", meta = (ClampMin = "1"))
+	int32 FloorCount;
+
+	UPROPERTY(EditAnywhere, Category = "Level Generation", meta = (ClampMin = "0.0"))
+	float FloorHeight;
+
+	/** The same Seed, ArenaSizeInTiles and FloorCount will always generate the same arena. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Level Generation")
+	int32 Seed;
+
+	/** As the editor tool's bPropagateConstraints. */
+	UPROPERTY(EditAnywhere, Category = "Level Generation")
+	bool bPropagateConstraints;
+
+	/** As the editor tool's bRequireConnectivity. */
+	UPROPERTY(EditAnywhere, Category = "Level Generation")
+	bool bRequireConnectivity;
+
+	/** Generate the arena for Seed as soon as play begins. */
+	UPROPERTY(EditAnywhere, Category = "Level Generation")
+	bool bGenerateOnBeginPlay;
+
+	/** How long each tick may spend spawning, while generation is on course for LatencyBudgetSeconds. */
+	UPROPERTY(EditAnywhere, Category = "Latency Budget", meta = (ClampMin = "1.0"))
+	float SpawnBudgetMilliseconds;
+
+	/**
+	* How long generating an arena may take in all (such as one loading-screen window). Once
+	* spawning (at the rate it has gone so far) would take longer, the rest is spawned at once.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Latency Budget", meta = (ClampMin = "0.1"))
+	float LatencyBudgetSeconds;
+
+	/** 
+	* Once an arena is spawned, draw its Zones' meshes with a few instanced components (see
+	* FZoneMeshMerge). Only where it is generated: clients draw the Zones' own meshes.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Mesh Merging")
+	bool bMergeZoneMeshes;
+
+	UPROPERTY(BlueprintAssignable, Category = "Level Generation")
+	FOnZoneArenaGenerated OnArenaGenerated;
+
+private:
+
+	// Functions/Methods:
+
+	/** Move the Zones of the current arena into their pools (unmerging their meshes first). */
+	void ReleaseArenaZones();
+
+	/** For a Zone of the given Blueprint (an index of ZoneClasses) at the given transform (from its pool, if it has any). */
+	AZone* AcquireZone(int WangTileIndex, const FTransform& ZoneTransform);
+
+	/** Spawn the pending Zones until the deadline (in seconds). Returns true once all are spawned. */
+	bool SpawnPendingZones(double SpawnDeadline);
+
+	void EndGeneration(bool bSucceeded);
+
+	/** Profile ZoneClasses for the solver. Returns false if any are missing. */
+	bool GatherZoneTileSet(std::vector<FWangTileDefinition>& OutTileSet) const;
+
+	/** Release the current arena, and start a new (empty) pending layout. */
+	void BeginGeneration();
+
+	/** The world-space transform for the Zone at the given grid cell (the solver's first row is the arena's last). */
+	FTransform GetZoneTransform(int GridX, int GridY, int GridZ, int GridHeight) const;
+
+	// Properties:
+
+	UPROPERTY()
+	TArray<AZone*> ArenaZones;
+
+	/** That draw the meshes of ArenaZones, if they are merged. */
+	UPROPERTY()
+	TArray<class AInstancedStaticMeshActor*> MergedMeshActors;
+
+	/** Indexed as ZoneClasses. */
+	UPROPERTY()
+	TArray<FZonePool> ZonePools;
+
+	// For a generation that is part of the way through:
+
+	/** The layout being spawned (shared with the solver's thread). */
+	TSharedPtr<FWangTileGrid, ESPMode::ThreadSafe> PendingArenaLayout;
+	TFuture<bool> PendingArenaSolve;
+	TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe> PendingGenerationCancelled;
+
+	int PendingCellIndex;
+	double GenerationStartTime;
+	double SpawnStartTime;
+
+	// Constant Values:
+
+	/** The width and height of a Zone (as with the editor tool). */
+	const float ZONE_WIDTH = 100.0f;
+	const float ZONE_HEIGHT = 100.0f;
+
+	/** For which XY-plane (relative to this actor) the Zones of the lowest floor are placed upon. */
+	const float ZONE_Z_POSITION = 40.0f;
+};
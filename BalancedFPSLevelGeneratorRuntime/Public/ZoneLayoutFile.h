@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Bespoke header files:
+#include "WangTileLayoutFile.h"
+
+/**
+* Saves and loads Zone layouts as files (see FWangTileLayoutFile), shared by the editor tool and
+* AZoneArenaGenerator. A layout is loaded a row at a time, so only one row of the file is held
+* in memory beside the layout itself; this can be called off the game thread.
+*/
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FZoneLayoutFile
+{
+	// Functions/Methods:
+
+	/** Returns false if the file could not be written. */
+	static bool SaveLayout(const FString& Filename, const FWangTileGrid& ZoneLayout, const FWangTileLayoutHeader& Header);
+
+	/** Read only the header (so that it can be checked before the layout is loaded). */
+	static bool LoadLayoutHeader(const FString& Filename, FWangTileLayoutHeader& OutHeader);
+
+	/**
+	* Read the whole layout. Returns false if the file is missing, is not a layout file, is cut
+	* short, its tiles do not match its checksum, or any cell is not one of ZoneCount Zones.
+	*/
+	static bool LoadLayout(const FString& Filename, int32 ZoneCount, FWangTileLayoutHeader& OutHeader, FWangTileGrid& OutLayout);
+
+	/** Where the editor tool saves a layout, unless told otherwise. */
+	static FString GetDefaultLayoutFilename();
+
+	// Constant Values:
+
+	/** For a layout file (Wang Tile Layout). */
+	static const TCHAR* LAYOUT_FILE_EXTENSION;
+};
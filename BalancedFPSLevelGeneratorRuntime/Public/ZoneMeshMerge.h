@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AZone;
+class AInstancedStaticMeshActor;
+class ULevel;
+class UStaticMesh;
+class UStaticMeshComponent;
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
+
+/** What the Zone objects drawn by one instanced component have in common. */
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FZoneMeshMergeKey
+{
+	// Functions/Methods:
+
+	/** For what ZoneObject draws (and, if bWithCollision, what it collides as). */
+	FZoneMeshMergeKey(const UStaticMeshComponent* ZoneObject, bool bWithCollision);
+
+	/** Set the mesh, materials and collision of an instanced component to match. */
+	void ApplyTo(UInstancedStaticMeshComponent* InstancedComponent) const;
+
+	bool operator==(const FZoneMeshMergeKey& Other) const
+	{
+		return Mesh == Other.Mesh && Materials == Other.Materials && CollisionProfileName == Other.CollisionProfileName;
+	}
+
+	friend uint32 GetTypeHash(const FZoneMeshMergeKey& Key)
+	{
+		uint32 KeyHash = HashCombine(GetTypeHash(Key.Mesh), GetTypeHash(Key.CollisionProfileName));
+		for (UMaterialInterface* Material : Key.Materials)
+		{
+			KeyHash = HashCombine(KeyHash, GetTypeHash(Material));
+		}
+
+		return KeyHash;
+	}
+
+	// Properties:
+
+	UStaticMesh* Mesh;
+	TArray<UMaterialInterface*> Materials;
+
+	/** None for no collision. */
+	FName CollisionProfileName;
+};
+
+/**
+* Draws the static meshes of many Zones with a handful of hierarchical instanced components (one
+* for each mesh, set of materials and collision profile), rather than with a component for each
+* object of each Zone, for the editor tool and AZoneArenaGenerator.
+*
+* The instances are drawn and collide in place of the Zones' own components, which are unregistered
+* (so that they cost nothing, though their objects are still counted). Traces then hit the merged
+* actors rather than the Zones.
+*/
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FZoneMeshMerge
+{
+	// Functions/Methods:
+
+	/** Merge the visible static meshes of the Zones, spawning the merged actors into Level. */
+	static void MergeZoneMeshes(ULevel* Level, const TArray<AZone*>& Zones,
+		TArray<AInstancedStaticMeshActor*>& OutMergedActors);
+
+	/** Register the Zones' own meshes again (for drawing and collision), and destroy the merged actors. */
+	static void UnmergeZoneMeshes(const TArray<AZone*>& Zones, const TArray<AInstancedStaticMeshActor*>& MergedActors);
+
+	// Constant Values:
+
+	/** For the Zone objects unregistered by MergeZoneMeshes() (so that only those are registered again). */
+	static const FName MERGED_ZONE_OBJECT_TAG;
+};
@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Bespoke header files:
+#include "Zone.h"
+#include "WangTileSolver.h"
+
+/**
+* The rules of the level generator's tile-set (WangTile1 to WangTile22), shared by the editor
+* tool and AZoneArenaGenerator, so that both place the same Zones for the same Seed.
+*/
+struct BALANCEDFPSLEVELGENERATORRUNTIME_API FZoneTileSet
+{
+	// Functions/Methods:
+
+	/** Describe a Zone Blueprint to the solver, from its profile (see AZone::BuildZoneProfile()). */
+	static FWangTileDefinition MakeTileDefinition(const FZoneProfile& ZoneProfile);
+
+	/** Set the tiles the solver places in the corners, along the edges and next to WangTile2/10. */
+	static void ApplyPlacementRules(FWangTileSolverSettings& Settings);
+
+	/** For the path of the class of the Zone Blueprint at WangTileIndex (WangTile1 is 0). */
+	static FString GetZoneClassPath(int WangTileIndex);
+
+	// Constant Values:
+
+	/** For a count of all of the Blueprints that represent Zones. */
+	static const int ZONE_BLUEPRINT_COUNT = 22;
+};
@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// (The engine builds every source file of the module, so the tests are only built by CMakeLists.txt):
+#ifdef WANG_TILE_STANDALONE_BUILD
+
+#include "WangTileTestSupport.h"
+#include "WangTileAliasTable.h"
+#include "WangTileMask.h"
+#include <cmath>
+
+/** For the chance of each tile being picked from a table (exactly, from its columns), indexed by tile. */
+static std::vector<double> GetAliasTableChances(const FWangTileAliasEntry* Entries, int EntryCount, int TileCount)
+{
+	std::vector<double> Chances(TileCount, 0.0);
+
+	for (int Column = 0; Column < EntryCount; Column++)
+	{
+		const FWangTileAliasEntry& Entry = Entries[Column];
+		const double KeepChance = Entry.Threshold == FWangTileAliasEntry::ALWAYS_KEEP ? 1.0 :
+			Entry.Threshold / 4294967296.0;
+
+		Chances[Entry.Tile] += KeepChance / EntryCount;
+		Chances[Entry.AliasTile] += (1.0 - KeepChance) / EntryCount;
+	}
+
+	return Chances;
+}
+
+WANG_TILE_TEST(AliasTableMatchesWeights)
+{
+	// Across two words of a mask, with a tile of no weight, and one far heavier than the rest:
+	const int TileCount = 100;
+	FWangTileRandomStream RandomStream(29);
+	std::vector<float> Weights(TileCount);
+	std::vector<uint64_t> Mask(FWangTileMask::GetWordCount(TileCount), 0);
+	double TotalWeight = 0.0;
+
+	for (int Tile = 0; Tile < TileCount; Tile++)
+	{
+		Weights[Tile] = static_cast<float>(RandomStream.GetBoundedUInt32(300)) / 100.0f;
+		Weights[Tile] = Tile == 70 ? 0.0f : Tile == 71 ? 40.0f : Weights[Tile];
+
+		if (Tile % 3 != 0)
+		{
+			FWangTileMask::AddTile(Mask.data(), Tile);
+			TotalWeight += Weights[Tile];
+		}
+	}
+
+	// (After another table, as the solver appends every table to the same entries):
+	std::vector<FWangTileAliasEntry> Entries(5);
+	FWangTileAliasTable::Build(Mask.data(), static_cast<int>(Mask.size()), Weights.data(), Entries);
+	const int EntryCount = static_cast<int>(Entries.size()) - 5;
+	WANG_TILE_CHECK(EntryCount == FWangTileMask::CountTiles(Mask.data(), static_cast<int>(Mask.size())));
+
+	const std::vector<double> Chances = GetAliasTableChances(&Entries[5], EntryCount, TileCount);
+	for (int Tile = 0; Tile < TileCount; Tile++)
+	{
+		const double Expected = FWangTileMask::ContainsTile(Mask.data(), Tile) ? Weights[Tile] / TotalWeight : 0.0;
+		WANG_TILE_CHECK(std::fabs(Chances[Tile] - Expected) < 1.0e-6);
+	}
+
+	// And the picks follow the chances (to within 5 standard deviations):
+	const int PickCount = 2000000;
+	std::vector<int> PickCounts(TileCount, 0);
+	for (int Pick = 0; Pick < PickCount; Pick++)
+	{
+		PickCounts[FWangTileAliasTable::Pick(&Entries[5], EntryCount, RandomStream)]++;
+	}
+
+	for (int Tile = 0; Tile < TileCount; Tile++)
+	{
+		const double Expected = PickCount * Chances[Tile];
+		const double StandardDeviation = std::sqrt(Expected * (1.0 - Chances[Tile]));
+		WANG_TILE_CHECK(std::fabs(PickCounts[Tile] - Expected) <= 5.0 * StandardDeviation + 1.0);
+	}
+
+	WANG_TILE_CHECK(PickCounts[70] == 0);
+}
+
+WANG_TILE_TEST(AliasTableEqualWeightsKeepEveryColumn)
+{
+	std::vector<uint64_t> Mask(1, 0);
+	for (int Tile : { 1, 4, 9, 16, 25, 36, 49 })
+	{
+		FWangTileMask::AddTile(Mask.data(), Tile);
+	}
+
+	// Equal weights, and weights that sum to nothing, are both a uniform choice of column:
+	for (float Weight : { 2.5f, 0.0f, -1.0f })
+	{
+		const std::vector<float> Weights(64, Weight);
+		std::vector<FWangTileAliasEntry> Entries;
+		FWangTileAliasTable::Build(Mask.data(), 1, Weights.data(), Entries);
+
+		WANG_TILE_CHECK(Entries.size() == 7);
+		for (const FWangTileAliasEntry& Entry : Entries)
+		{
+			WANG_TILE_CHECK(Entry.Threshold == FWangTileAliasEntry::ALWAYS_KEEP);
+			WANG_TILE_CHECK(Entry.AliasTile == Entry.Tile);
+		}
+	}
+
+	// An empty set has no table:
+	std::vector<FWangTileAliasEntry> Entries;
+	const uint64_t EmptyMask = 0;
+	const float Weight = 1.0f;
+	FWangTileAliasTable::Build(&EmptyMask, 1, &Weight, Entries);
+	WANG_TILE_CHECK(Entries.empty());
+}
+
+#endif
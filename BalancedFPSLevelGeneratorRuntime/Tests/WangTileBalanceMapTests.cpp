@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// (The engine builds every source file of the module, so the tests are only built by CMakeLists.txt):
+#ifdef WANG_TILE_STANDALONE_BUILD
+
+#include "WangTileTestSupport.h"
+#include "WangTileBalanceMap.h"
+#include <cmath>
+
+/** The Coefficients of the cells in Rect (clipped to the layout), summed a cell (and floor) at a time. */
+static FWangTileRegionBalance SumRegionBalance(const FWangTileSolver& Solver, const std::vector<FWangTileDefinition>& TileSet,
+	const FWangTileGrid& Grid, const FWangTileRect& Rect)
+{
+	FWangTileRegionBalance RegionBalance;
+
+	for (int Y = 0; Y < Grid.GetHeight(); Y++)
+	{
+		for (int X = 0; X < Grid.GetWidth(); X++)
+		{
+			if (!Rect.Contains(X, Y))
+			{
+				continue;
+			}
+
+			double Coefficients[static_cast<int>(EWangTileCoefficient::Count)] = { 0.0, 0.0, 0.0 };
+			for (int Z = 0; Z < Grid.GetDepth(); Z++)
+			{
+				const FWangTileCell& Cell = Grid.At(X, Y, Z);
+				Coefficients[static_cast<int>(EWangTileCoefficient::Defensiveness)] += Solver.GetDefensivenessCoefficient(Cell);
+				Coefficients[static_cast<int>(EWangTileCoefficient::Flanking)] += FWangTileSolver::GetFlankingCoefficient(Cell.Placement);
+				Coefficients[static_cast<int>(EWangTileCoefficient::Dispersion)] += TileSet[Cell.TileId].DispersionCoefficient;
+			}
+
+			RegionBalance.CellCount++;
+			for (int CoefficientIndex = 0; CoefficientIndex < static_cast<int>(EWangTileCoefficient::Count); CoefficientIndex++)
+			{
+				RegionBalance.Sums[CoefficientIndex] += Coefficients[CoefficientIndex] / Grid.GetDepth();
+			}
+		}
+	}
+
+	return RegionBalance;
+}
+
+/** If two region balances have the same cells, and sums within rounding of each other. */
+static bool RegionBalancesMatch(const FWangTileRegionBalance& RegionBalance, const FWangTileRegionBalance& OtherRegionBalance)
+{
+	if (RegionBalance.CellCount != OtherRegionBalance.CellCount)
+	{
+		return false;
+	}
+
+	for (int CoefficientIndex = 0; CoefficientIndex < static_cast<int>(EWangTileCoefficient::Count); CoefficientIndex++)
+	{
+		if (std::abs(RegionBalance.Sums[CoefficientIndex] - OtherRegionBalance.Sums[CoefficientIndex]) >
+			1.0e-5 * (1.0 + std::abs(OtherRegionBalance.Sums[CoefficientIndex])))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+WANG_TILE_TEST(BalanceMapRegionsMatchBruteForce)
+{
+	const std::vector<FWangTileDefinition> TileSet = MakeTestTileSet();
+	FWangTileSolver Solver(TileSet);
+	const int GridSizes[][3] = { { 1, 1, 1 }, { 3, 3, 1 }, { 37, 23, 1 }, { 64, 64, 1 }, { 5, 90, 1 }, { 20, 17, 3 } };
+
+	for (const int* GridSize : GridSizes)
+	{
+		FWangTileSolverSettings Settings = MakeTestSettings(GridSize[0], GridSize[1], GridSize[2]);
+		Settings.Seed = 17;
+		FWangTileGrid Grid;
+		WANG_TILE_CHECK(Solver.Solve(Settings, Grid));
+
+		// (The tables are built in bands, so on one thread and on more than there are rows or columns):
+		FWangTileBalanceMap BalanceMap;
+		Settings.ThreadCount = 1;
+		BalanceMap.Build(TileSet, Grid, Settings);
+
+		FWangTileBalanceMap ThreadedBalanceMap;
+		Settings.ThreadCount = 7;
+		ThreadedBalanceMap.Build(TileSet, Grid, Settings);
+
+		// Every rectangle in (and partly out of) a small layout, and some at random in a larger one:
+		FWangTileRandomStream RandomStream(GridSize[0] * 1000 + GridSize[1]);
+		const bool TryEveryRect = Grid.GetCellCount() <= 16 * 16;
+		const int RectCount = TryEveryRect ? 0 : 2000;
+		std::vector<FWangTileRect> Rects;
+
+		for (int MinY = -1; TryEveryRect && MinY <= Grid.GetHeight(); MinY++)
+		{
+			for (int MinX = -1; MinX <= Grid.GetWidth(); MinX++)
+			{
+				for (int MaxY = MinY; MaxY <= Grid.GetHeight() + 1; MaxY++)
+				{
+					for (int MaxX = MinX; MaxX <= Grid.GetWidth() + 1; MaxX++)
+					{
+						Rects.emplace_back(MinX, MinY, MaxX, MaxY);
+					}
+				}
+			}
+		}
+
+		for (int RectIndex = 0; RectIndex < RectCount; RectIndex++)
+		{
+			const int MinX = static_cast<int>(RandomStream.GetBoundedUInt32(Grid.GetWidth() + 2)) - 1;
+			const int MinY = static_cast<int>(RandomStream.GetBoundedUInt32(Grid.GetHeight() + 2)) - 1;
+			Rects.emplace_back(MinX, MinY, MinX + static_cast<int>(RandomStream.GetBoundedUInt32(Grid.GetWidth() + 2)),
+				MinY + static_cast<int>(RandomStream.GetBoundedUInt32(Grid.GetHeight() + 2)));
+		}
+
+		for (const FWangTileRect& Rect : Rects)
+		{
+			const FWangTileRegionBalance RegionBalance = BalanceMap.GetRegionBalance(Rect);
+			const FWangTileRegionBalance ThreadedRegionBalance = ThreadedBalanceMap.GetRegionBalance(Rect);
+
+			WANG_TILE_CHECK(RegionBalancesMatch(RegionBalance, SumRegionBalance(Solver, TileSet, Grid, Rect)));
+			WANG_TILE_CHECK(ThreadedRegionBalance.CellCount == RegionBalance.CellCount);
+			for (int CoefficientIndex = 0; CoefficientIndex < static_cast<int>(EWangTileCoefficient::Count); CoefficientIndex++)
+			{
+				WANG_TILE_CHECK(ThreadedRegionBalance.Sums[CoefficientIndex] == RegionBalance.Sums[CoefficientIndex]);
+			}
+		}
+
+		// And the report scores the layout as the solver does:
+		const FWangTileBalanceReport Report = BalanceMap.ComputeReport(Settings);
+		const FWangTileLayoutScore Score = Solver.ScoreLayout(Grid);
+		WANG_TILE_CHECK(RegionBalancesMatch(Report.Level, SumRegionBalance(Solver, TileSet, Grid,
+			FWangTileRect(0, 0, Grid.GetWidth(), Grid.GetHeight()))));
+		WANG_TILE_CHECK(std::abs(Report.Score.DefensivenessImbalance - Score.DefensivenessImbalance) < 1.0e-4f);
+		WANG_TILE_CHECK(std::abs(Report.Score.DispersionImbalance - Score.DispersionImbalance) < 1.0e-4f);
+	}
+}
+
+#endif
@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// (The engine builds every source file of the module, so the tests are only built by CMakeLists.txt):
+#ifdef WANG_TILE_STANDALONE_BUILD
+
+#include "WangTileTestSupport.h"
+
+/** The test tile set, with some of its interior tiles made into stairs (up, down, or both). */
+static std::vector<FWangTileDefinition> MakeTestTileSetWithStairs()
+{
+	std::vector<FWangTileDefinition> TileSet = MakeTestTileSet();
+
+	TileSet[6].VerticalLinks = FWangTileDefinition::VERTICAL_LINK_UP;
+	TileSet[12].VerticalLinks = FWangTileDefinition::VERTICAL_LINK_UP;
+	TileSet[7].VerticalLinks = FWangTileDefinition::VERTICAL_LINK_DOWN;
+	TileSet[14].VerticalLinks = FWangTileDefinition::VERTICAL_LINK_DOWN;
+	TileSet[11].VerticalLinks = FWangTileDefinition::VERTICAL_LINK_UP | FWangTileDefinition::VERTICAL_LINK_DOWN;
+
+	return TileSet;
+}
+
+/**
+* How many cells break the vertical rules: a tile leads down exactly where the tile below it leads up,
+* and nothing leads up from the top floor. The stairs up (below the top floor) are counted too.
+*/
+static int CountVerticalRuleViolations(const std::vector<FWangTileDefinition>& TileSet, const FWangTileGrid& Grid,
+	int& OutStairCount)
+{
+	int ViolationCount = 0;
+	OutStairCount = 0;
+
+	for (int CellIndex = 0; CellIndex < Grid.GetCellCount(); CellIndex++)
+	{
+		const int Z = Grid.GetZ(CellIndex);
+		const FWangTileDefinition& Tile = TileSet[Grid[CellIndex].TileId];
+		const bool IsLinkedBelow = Z > 0 && TileSet[Grid[Grid.GetBelowIndex(CellIndex)].TileId].LinksUp();
+
+		ViolationCount += Tile.LinksDown() != IsLinkedBelow || (Z == Grid.GetDepth() - 1 && Tile.LinksUp()) ? 1 : 0;
+		OutStairCount += Z < Grid.GetDepth() - 1 && Tile.LinksUp() ? 1 : 0;
+	}
+
+	return ViolationCount;
+}
+
+WANG_TILE_TEST(FloorsKeepVerticalRules)
+{
+	const std::vector<FWangTileDefinition> TileSet = MakeTestTileSetWithStairs();
+	FWangTileSolver Solver(TileSet);
+
+	for (uint32_t Seed = 1; Seed <= 5; Seed++)
+	{
+		FWangTileSolverSettings Settings = MakeTestSettings(64, 64, 4);
+		Settings.Seed = Seed;
+		Settings.ThreadCount = 1;
+
+		FWangTileGrid SingleThreadGrid;
+		WANG_TILE_CHECK(Solver.Solve(Settings, SingleThreadGrid));
+
+		int StairCount = 0;
+		WANG_TILE_CHECK(CountVerticalRuleViolations(TileSet, SingleThreadGrid, StairCount) == 0);
+		WANG_TILE_CHECK(StairCount > 0);
+
+		// (The rows of each floor follow those of the floor below, however many threads there are):
+		Settings.ThreadCount = 4;
+		FWangTileGrid ThreadedGrid;
+		WANG_TILE_CHECK(Solver.Solve(Settings, ThreadedGrid));
+		WANG_TILE_CHECK(ThreadedGrid.ComputeLayoutChecksum() == SingleThreadGrid.ComputeLayoutChecksum());
+	}
+
+	// A single floor has nowhere for a stair to lead:
+	FWangTileGrid FlatGrid;
+	WANG_TILE_CHECK(Solver.Solve(MakeTestSettings(64, 64), FlatGrid));
+
+	int FlatStairCount = 0;
+	WANG_TILE_CHECK(CountVerticalRuleViolations(TileSet, FlatGrid, FlatStairCount) == 0);
+}
+
+WANG_TILE_TEST(FloorsKeepVerticalRulesWhenPropagating)
+{
+	const std::vector<FWangTileDefinition> TileSet = MakeTestTileSetWithStairs();
+	FWangTileSolver Solver(TileSet);
+
+	for (uint32_t Seed = 1; Seed <= 3; Seed++)
+	{
+		FWangTileSolverSettings Settings = MakeTestSettings(64, 64, 4);
+		Settings.Seed = Seed;
+		Settings.PropagateConstraints = true;
+
+		FWangTileGrid Grid;
+		WANG_TILE_CHECK(Solver.Solve(Settings, Grid));
+		WANG_TILE_CHECK(Grid.GetDepth() == 4);
+
+		int StairCount = 0;
+		WANG_TILE_CHECK(CountVerticalRuleViolations(TileSet, Grid, StairCount) == 0);
+		WANG_TILE_CHECK(StairCount > 0);
+
+		// Every floor is filled, with the same corners and edges:
+		for (int CellIndex = 0; CellIndex < Grid.GetCellCount(); CellIndex++)
+		{
+			WANG_TILE_CHECK(Grid[CellIndex].HasTile());
+			WANG_TILE_CHECK(Grid.IsInterior(CellIndex) || Grid[CellIndex].TileId ==
+				Grid[CellIndex % Grid.GetFloorCellCount()].TileId);
+		}
+
+		// And the propagator still suits the neighbours more often than the scanline solver:
+		Settings.PropagateConstraints = false;
+		FWangTileGrid ScanlineGrid;
+		WANG_TILE_CHECK(Solver.Solve(Settings, ScanlineGrid));
+		const FWangTileSolverStats ScanlineStats = Solver.GetStats();
+
+		Settings.PropagateConstraints = true;
+		WANG_TILE_CHECK(Solver.Solve(Settings, Grid));
+		WANG_TILE_CHECK(Solver.GetStats().RelaxedCells < ScanlineStats.WestOnlyFallbacks + ScanlineStats.VerticalOnlyFallbacks);
+	}
+}
+
+#endif
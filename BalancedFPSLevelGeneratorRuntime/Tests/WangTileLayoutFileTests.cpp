@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// (The engine builds every source file of the module, so the tests are only built by CMakeLists.txt):
+#ifdef WANG_TILE_STANDALONE_BUILD
+
+#include "WangTileTestSupport.h"
+#include "WangTileLayoutFile.h"
+
+WANG_TILE_TEST(LayoutFileKeepsTheWinningSeed)
+{
+	const std::vector<FWangTileDefinition> TileSet = MakeTestTileSet();
+	FWangTileSolver Solver(TileSet);
+
+	// The candidates' Seeds wrap around past the largest, so the winner's may be any of them:
+	for (int GridDepth = 1; GridDepth <= 2; GridDepth++)
+	{
+		FWangTileSolverSettings Settings = MakeTestSettings(40, 30, GridDepth);
+		Settings.Seed = 0xFFFFFFFCu;
+
+		FWangTileGrid WinningGrid;
+		FWangTileCandidateReport CandidateReport;
+		WANG_TILE_CHECK(Solver.SolveBestOf(Settings, 8, WinningGrid, CandidateReport));
+
+		FWangTileLayoutHeader Header;
+		Header.Seed = CandidateReport.BestSeed;
+		Header.ExtentX = 4000.0f;
+		Header.ExtentY = 3000.0f;
+		Header.TileSetHash = FWangTileLayoutFile::ComputeTileSetHash(TileSet);
+		const std::vector<uint8_t> FileData = FWangTileLayoutFile::Encode(WinningGrid, Header);
+
+		FWangTileLayoutHeader DecodedHeader;
+		FWangTileGrid DecodedGrid;
+		WANG_TILE_CHECK(FWangTileLayoutFile::Decode(FileData.data(), FileData.size(), static_cast<int>(TileSet.size()), DecodedHeader,
+			DecodedGrid));
+		WANG_TILE_CHECK(FileData.size() == FWangTileLayoutFile::GetFileSize(DecodedHeader));
+		WANG_TILE_CHECK(DecodedHeader.Seed == CandidateReport.BestSeed);
+		WANG_TILE_CHECK(DecodedHeader.Depth == GridDepth);
+		WANG_TILE_CHECK(DecodedHeader.TileSetHash == Header.TileSetHash);
+		WANG_TILE_CHECK(DecodedGrid.ComputeLayoutChecksum() == WinningGrid.ComputeLayoutChecksum());
+
+		// And the file's Seed solves the same layout again:
+		Settings.Seed = DecodedHeader.Seed;
+		FWangTileGrid SolvedGrid;
+		WANG_TILE_CHECK(Solver.Solve(Settings, SolvedGrid));
+		WANG_TILE_CHECK(SolvedGrid.ComputeLayoutChecksum() == DecodedHeader.LayoutChecksum);
+	}
+}
+
+WANG_TILE_TEST(LayoutFileRejectsDamagedFiles)
+{
+	const std::vector<FWangTileDefinition> TileSet = MakeTestTileSet();
+	const int TileCount = static_cast<int>(TileSet.size());
+	FWangTileSolver Solver(TileSet);
+	FWangTileGrid Grid;
+	WANG_TILE_CHECK(Solver.Solve(MakeTestSettings(16, 16), Grid));
+
+	const std::vector<uint8_t> FileData = FWangTileLayoutFile::Encode(Grid, FWangTileLayoutHeader());
+	FWangTileLayoutHeader Header;
+	FWangTileGrid DecodedGrid;
+	WANG_TILE_CHECK(FWangTileLayoutFile::Decode(FileData.data(), FileData.size(), TileCount, Header, DecodedGrid));
+
+	// Cut short:
+	WANG_TILE_CHECK(!FWangTileLayoutFile::Decode(FileData.data(), FileData.size() - 1, TileCount, Header, DecodedGrid));
+	WANG_TILE_CHECK(!FWangTileLayoutFile::Decode(FileData.data(), FWangTileLayoutFile::HEADER_SIZE - 1, TileCount, Header, DecodedGrid));
+
+	// Not a layout file:
+	std::vector<uint8_t> DamagedData = FileData;
+	DamagedData[0] ^= 1;
+	WANG_TILE_CHECK(!FWangTileLayoutFile::Decode(DamagedData.data(), DamagedData.size(), TileCount, Header, DecodedGrid));
+
+	// A tile that doesn't match the checksum:
+	DamagedData = FileData;
+	DamagedData[FWangTileLayoutFile::GetRowOffset(Header, 5) + 1] ^= 1;
+	WANG_TILE_CHECK(!FWangTileLayoutFile::Decode(DamagedData.data(), DamagedData.size(), TileCount, Header, DecodedGrid));
+}
+
+WANG_TILE_TEST(LayoutFileRejectsCellsOutsideTheTileSet)
+{
+	const std::vector<FWangTileDefinition> TileSet = MakeTestTileSet();
+	const int TileCount = static_cast<int>(TileSet.size());
+	FWangTileSolver Solver(TileSet);
+	FWangTileGrid Grid;
+	WANG_TILE_CHECK(Solver.Solve(MakeTestSettings(16, 16), Grid));
+
+	// Files that are whole (and match their checksums), but can't be looked up in the tile-set:
+	const uint16_t BadTileIds[] = { FWangTileCell::NO_TILE, static_cast<uint16_t>(TileCount),
+		static_cast<uint16_t>(TileCount + 9) };
+
+	for (uint16_t BadTileId : BadTileIds)
+	{
+		FWangTileGrid BadGrid = Grid;
+		BadGrid[7 * 16 + 3].TileId = BadTileId;
+
+		const std::vector<uint8_t> FileData = FWangTileLayoutFile::Encode(BadGrid, FWangTileLayoutHeader());
+		FWangTileLayoutHeader Header;
+		FWangTileGrid DecodedGrid;
+		WANG_TILE_CHECK(!FWangTileLayoutFile::Decode(FileData.data(), FileData.size(), TileCount, Header, DecodedGrid));
+		WANG_TILE_CHECK(!FWangTileLayoutFile::HasOnlyTiles(DecodedGrid, TileCount));
+
+		// (It is only the tile-set that rules it out):
+		WANG_TILE_CHECK(DecodedGrid.ComputeLayoutChecksum() == Header.LayoutChecksum);
+		WANG_TILE_CHECK(DecodedGrid[7 * 16 + 3].TileId == BadTileId);
+	}
+
+	WANG_TILE_CHECK(FWangTileLayoutFile::HasOnlyTiles(Grid, TileCount));
+	WANG_TILE_CHECK(!FWangTileLayoutFile::HasOnlyTiles(Grid, 0));
+}
+
+#endif
@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// (The engine builds every source file of the module, so the tests are only built by CMakeLists.txt):
+#ifdef WANG_TILE_STANDALONE_BUILD
+
+#include "WangTileTestSupport.h"
+#include "WangTileMask.h"
+#include <cmath>
+#include <limits>
+
+/** For the values Compare() is checked against (a few of each exactly on the bound, and a NaN). */
+static std::vector<float> MakeMaskTestValues(int TileCount, float Bound, FWangTileRandomStream& RandomStream)
+{
+	std::vector<float> Values(TileCount);
+	for (float& Value : Values)
+	{
+		switch (RandomStream.GetBoundedUInt32(8))
+		{
+		case 0:
+			Value = Bound;
+			break;
+		case 1:
+			Value = std::nextafter(Bound, 2.0f);
+			break;
+		case 2:
+			Value = std::nextafter(Bound, -2.0f);
+			break;
+		default:
+			Value = static_cast<float>(RandomStream.GetNextUInt32()) / 4294967296.0f;
+			break;
+		}
+	}
+
+	if (TileCount > 0)
+	{
+		Values[RandomStream.GetBoundedUInt32(static_cast<uint32_t>(TileCount))] = std::numeric_limits<float>::quiet_NaN();
+	}
+
+	return Values;
+}
+
+WANG_TILE_TEST(MaskCompareMatchesScalarComparisons)
+{
+	FWangTileRandomStream RandomStream(13);
+	const EWangTileComparison Comparisons[] = { EWangTileComparison::LessOrEqual, EWangTileComparison::GreaterOrEqual,
+		EWangTileComparison::Less };
+
+	// Every length up to a few words (so every tail of a word of four lanes, and of a mask of words):
+	for (int TileCount = 0; TileCount <= 200; TileCount++)
+	{
+		const float Bound = static_cast<float>(RandomStream.GetNextUInt32()) / 4294967296.0f;
+		const std::vector<float> Values = MakeMaskTestValues(TileCount, Bound, RandomStream);
+		const int WordCount = FWangTileMask::GetWordCount(TileCount);
+
+		for (EWangTileComparison Comparison : Comparisons)
+		{
+			// (Filled, so that any word Compare() leaves alone shows up):
+			std::vector<uint64_t> Mask(WordCount + 1, ~uint64_t(0));
+			FWangTileMask::Compare(Values.data(), TileCount, Comparison, Bound, Mask.data());
+
+			int ExpectedTileCount = 0;
+			for (int Tile = 0; Tile < WordCount * 64; Tile++)
+			{
+				bool bExpected = false;
+				if (Tile < TileCount)
+				{
+					bExpected = Comparison == EWangTileComparison::LessOrEqual ? Values[Tile] <= Bound :
+						Comparison == EWangTileComparison::GreaterOrEqual ? Values[Tile] >= Bound : Values[Tile] < Bound;
+				}
+
+				ExpectedTileCount += bExpected ? 1 : 0;
+				WANG_TILE_CHECK(FWangTileMask::ContainsTile(Mask.data(), Tile) == bExpected);
+			}
+
+			WANG_TILE_CHECK(Mask[WordCount] == ~uint64_t(0));
+			WANG_TILE_CHECK(FWangTileMask::CountTiles(Mask.data(), WordCount) == ExpectedTileCount);
+		}
+	}
+}
+
+WANG_TILE_TEST(MaskIntersectAndForEachMatchScalar)
+{
+	FWangTileRandomStream RandomStream(17);
+
+	for (int WordCount = 1; WordCount <= 4; WordCount++)
+	{
+		for (int Repetition = 0; Repetition < 50; Repetition++)
+		{
+			std::vector<uint64_t> A(WordCount, 0);
+			std::vector<uint64_t> B(WordCount, 0);
+			std::vector<bool> IsInA(WordCount * 64);
+			std::vector<bool> IsInB(WordCount * 64);
+
+			for (int Tile = 0; Tile < WordCount * 64; Tile++)
+			{
+				IsInA[Tile] = RandomStream.GetBoundedUInt32(3) == 0;
+				IsInB[Tile] = RandomStream.GetBoundedUInt32(2) == 0;
+
+				if (IsInA[Tile])
+				{
+					FWangTileMask::AddTile(A.data(), Tile);
+				}
+
+				if (IsInB[Tile])
+				{
+					FWangTileMask::AddTile(B.data(), Tile);
+				}
+			}
+
+			std::vector<uint64_t> Both(WordCount);
+			const int BothCount = FWangTileMask::Intersect(A.data(), B.data(), WordCount, Both.data());
+
+			std::vector<int> ExpectedTiles;
+			for (int Tile = 0; Tile < WordCount * 64; Tile++)
+			{
+				if (IsInA[Tile] && IsInB[Tile])
+				{
+					ExpectedTiles.push_back(Tile);
+				}
+			}
+
+			std::vector<int> VisitedTiles;
+			FWangTileMask::ForEachTile(Both.data(), WordCount, [&VisitedTiles](int Tile) { VisitedTiles.push_back(Tile); });
+
+			WANG_TILE_CHECK(BothCount == static_cast<int>(ExpectedTiles.size()));
+			WANG_TILE_CHECK(VisitedTiles == ExpectedTiles);
+		}
+	}
+
+	for (int Bit = 0; Bit < 64; Bit++)
+	{
+		WANG_TILE_CHECK(FWangTileMask::GetLowestBit(uint64_t(1) << Bit | uint64_t(1) << 63) == Bit);
+	}
+}
+
+#endif
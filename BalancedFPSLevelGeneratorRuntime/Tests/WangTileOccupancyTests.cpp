@@ -0,0 +1,299 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// (The engine builds every source file of the module, so the tests are only built by CMakeLists.txt):
+#ifdef WANG_TILE_STANDALONE_BUILD
+
+#include "WangTileTestSupport.h"
+#include "WangTileOccupancy.h"
+#include <algorithm>
+#include <cmath>
+
+static const int OCCUPANCY_TEST_RESOLUTION = FWangTileOccupancy::RESOLUTION;
+static const int OCCUPANCY_TEST_SIDE_COUNT = static_cast<int>(EWangTileSide::Count);
+
+/** A cell at a time, as [Y][X] (true if open). */
+typedef std::vector<std::vector<bool>> FOpenCells;
+
+/** A box in tile space (see FWangTileOccupancy::AddBox()). */
+struct FOccupancyTestBox
+{
+	float MinX;
+	float MinY;
+	float MaxX;
+	float MaxY;
+};
+
+/** If a cell is along one side, Inset cells in (not including the corners), as FWangTileOccupancy sees the sides. */
+static bool IsSideCell(int Side, int Inset, int X, int Y)
+{
+	const int FirstCell = Inset + 1;
+	const int LastCell = OCCUPANCY_TEST_RESOLUTION - 2 - Inset;
+
+	if (2 * Inset + 2 >= OCCUPANCY_TEST_RESOLUTION)
+	{
+		return false;
+	}
+
+	switch (static_cast<EWangTileSide>(Side))
+	{
+	case EWangTileSide::North:
+		return Y == OCCUPANCY_TEST_RESOLUTION - 1 - Inset && X >= FirstCell && X <= LastCell;
+	case EWangTileSide::South:
+		return Y == Inset && X >= FirstCell && X <= LastCell;
+	case EWangTileSide::East:
+		return X == OCCUPANCY_TEST_RESOLUTION - 1 - Inset && Y >= FirstCell && Y <= LastCell;
+	case EWangTileSide::West:
+		return X == Inset && Y >= FirstCell && Y <= LastCell;
+	default:
+		return false;
+	}
+}
+
+/** For the open cells reached (north, east, south or west) from the open cells along any of the Sides (a bit for each). */
+static FOpenCells FillFromSides(const FOpenCells& Open, int Sides, int Inset)
+{
+	FOpenCells Reached(OCCUPANCY_TEST_RESOLUTION, std::vector<bool>(OCCUPANCY_TEST_RESOLUTION, false));
+	std::vector<std::pair<int, int>> Worklist;
+
+	for (int Y = 0; Y < OCCUPANCY_TEST_RESOLUTION; Y++)
+	{
+		for (int X = 0; X < OCCUPANCY_TEST_RESOLUTION; X++)
+		{
+			for (int Side = 0; Side < OCCUPANCY_TEST_SIDE_COUNT; Side++)
+			{
+				if (((Sides >> Side) & 1) && Open[Y][X] && !Reached[Y][X] && IsSideCell(Side, Inset, X, Y))
+				{
+					Reached[Y][X] = true;
+					Worklist.emplace_back(X, Y);
+				}
+			}
+		}
+	}
+
+	while (!Worklist.empty())
+	{
+		const std::pair<int, int> Cell = Worklist.back();
+		Worklist.pop_back();
+
+		const int Offsets[4][2] = { { 0, 1 }, { 1, 0 }, { 0, -1 }, { -1, 0 } };
+		for (const int* Offset : Offsets)
+		{
+			const int X = Cell.first + Offset[0];
+			const int Y = Cell.second + Offset[1];
+
+			if (X >= 0 && Y >= 0 && X < OCCUPANCY_TEST_RESOLUTION && Y < OCCUPANCY_TEST_RESOLUTION && Open[Y][X] && !Reached[Y][X])
+			{
+				Reached[Y][X] = true;
+				Worklist.emplace_back(X, Y);
+			}
+		}
+	}
+
+	return Reached;
+}
+
+/** Measure a footprint a cell at a time (by the rules FWangTileOccupancy::Measure() documents). */
+static FWangTileFootprint MeasureFootprintByCell(const std::vector<FOccupancyTestBox>& Boxes)
+{
+	FWangTileFootprint Footprint;
+
+	// A box covers the cells it overlaps by more than an edge:
+	FOpenCells Open(OCCUPANCY_TEST_RESOLUTION, std::vector<bool>(OCCUPANCY_TEST_RESOLUTION, true));
+	int OpenCellCount = OCCUPANCY_TEST_RESOLUTION * OCCUPANCY_TEST_RESOLUTION;
+
+	for (int Y = 0; Y < OCCUPANCY_TEST_RESOLUTION; Y++)
+	{
+		for (int X = 0; X < OCCUPANCY_TEST_RESOLUTION; X++)
+		{
+			for (const FOccupancyTestBox& Box : Boxes)
+			{
+				if (Open[Y][X] && Box.MinX * OCCUPANCY_TEST_RESOLUTION < X + 1 && Box.MaxX * OCCUPANCY_TEST_RESOLUTION > X &&
+					Box.MinY * OCCUPANCY_TEST_RESOLUTION < Y + 1 && Box.MaxY * OCCUPANCY_TEST_RESOLUTION > Y)
+				{
+					Open[Y][X] = false;
+					OpenCellCount--;
+				}
+			}
+		}
+	}
+
+	Footprint.OpenArea = static_cast<float>(OpenCellCount) / (OCCUPANCY_TEST_RESOLUTION * OCCUPANCY_TEST_RESOLUTION);
+
+	const int AllSides = (1 << OCCUPANCY_TEST_SIDE_COUNT) - 1;
+	for (int Side = 0; Side < OCCUPANCY_TEST_SIDE_COUNT; Side++)
+	{
+		const FOpenCells ReachedFromOthers = FillFromSides(Open, AllSides & ~(1 << Side), 0);
+		const FOpenCells Reached = FillFromSides(Open, 1 << Side, 0);
+		int SideOpeningCount = 0;
+
+		for (int Y = 0; Y < OCCUPANCY_TEST_RESOLUTION; Y++)
+		{
+			for (int X = 0; X < OCCUPANCY_TEST_RESOLUTION; X++)
+			{
+				SideOpeningCount += ReachedFromOthers[Y][X] && IsSideCell(Side, 0, X, Y) ? 1 : 0;
+
+				for (int OtherSide = 0; OtherSide < OCCUPANCY_TEST_SIDE_COUNT; OtherSide++)
+				{
+					if (OtherSide != Side && Reached[Y][X] && IsSideCell(OtherSide, 0, X, Y))
+					{
+						Footprint.SideLinks[Side] |= 1 << OtherSide;
+					}
+				}
+			}
+		}
+
+		Footprint.SideOpenings[Side] = static_cast<float>(SideOpeningCount) / (OCCUPANCY_TEST_RESOLUTION - 2);
+	}
+
+	if (OpenCellCount == OCCUPANCY_TEST_RESOLUTION * OCCUPANCY_TEST_RESOLUTION)
+	{
+		Footprint.ChokepointWidth = 1.0f;
+		return Footprint;
+	}
+
+	// The widest path is the most erosions (of the open cells whose 8 neighbours are open) that leave
+	// a path between two sides, as many cells in:
+	for (int ErosionCount = 0; 2 * ErosionCount + 1 <= OCCUPANCY_TEST_RESOLUTION; ErosionCount++)
+	{
+		bool HasPath = false;
+		for (int Side = 0; Side < OCCUPANCY_TEST_SIDE_COUNT && !HasPath; Side++)
+		{
+			const FOpenCells Reached = FillFromSides(Open, 1 << Side, ErosionCount);
+
+			for (int Y = 0; Y < OCCUPANCY_TEST_RESOLUTION; Y++)
+			{
+				for (int X = 0; X < OCCUPANCY_TEST_RESOLUTION; X++)
+				{
+					for (int OtherSide = 0; OtherSide < OCCUPANCY_TEST_SIDE_COUNT; OtherSide++)
+					{
+						HasPath |= OtherSide != Side && Reached[Y][X] && IsSideCell(OtherSide, ErosionCount, X, Y);
+					}
+				}
+			}
+		}
+
+		if (!HasPath)
+		{
+			break;
+		}
+
+		Footprint.ChokepointWidth = static_cast<float>(2 * ErosionCount + 1) / OCCUPANCY_TEST_RESOLUTION;
+
+		FOpenCells Eroded = Open;
+		for (int Y = 0; Y < OCCUPANCY_TEST_RESOLUTION; Y++)
+		{
+			for (int X = 0; X < OCCUPANCY_TEST_RESOLUTION; X++)
+			{
+				for (int OffsetY = -1; OffsetY <= 1; OffsetY++)
+				{
+					for (int OffsetX = -1; OffsetX <= 1; OffsetX++)
+					{
+						const int NeighbourX = X + OffsetX;
+						const int NeighbourY = Y + OffsetY;
+
+						// (The cells beyond the tile count as covered):
+						if (NeighbourX < 0 || NeighbourY < 0 || NeighbourX >= OCCUPANCY_TEST_RESOLUTION ||
+							NeighbourY >= OCCUPANCY_TEST_RESOLUTION || !Open[NeighbourY][NeighbourX])
+						{
+							Eroded[Y][X] = false;
+						}
+					}
+				}
+			}
+		}
+
+		Open = Eroded;
+	}
+
+	return Footprint;
+}
+
+/** If two footprints are the same (to within rounding). */
+static bool FootprintsMatch(const FWangTileFootprint& Footprint, const FWangTileFootprint& OtherFootprint)
+{
+	bool IsMatch = std::abs(Footprint.OpenArea - OtherFootprint.OpenArea) < 1.0e-6f &&
+		std::abs(Footprint.ChokepointWidth - OtherFootprint.ChokepointWidth) < 1.0e-6f;
+
+	for (int Side = 0; Side < OCCUPANCY_TEST_SIDE_COUNT; Side++)
+	{
+		IsMatch &= std::abs(Footprint.SideOpenings[Side] - OtherFootprint.SideOpenings[Side]) < 1.0e-6f &&
+			Footprint.SideLinks[Side] == OtherFootprint.SideLinks[Side];
+	}
+
+	return IsMatch;
+}
+
+/** Measure the footprint of some boxes, with FWangTileOccupancy. */
+static FWangTileFootprint MeasureFootprint(const std::vector<FOccupancyTestBox>& Boxes)
+{
+	FWangTileOccupancy Occupancy;
+	for (const FOccupancyTestBox& Box : Boxes)
+	{
+		Occupancy.AddBox(Box.MinX, Box.MinY, Box.MaxX, Box.MaxY);
+	}
+
+	return Occupancy.Measure();
+}
+
+WANG_TILE_TEST(OccupancyKnownFootprints)
+{
+	// Nothing in the way:
+	const FWangTileFootprint OpenFootprint = MeasureFootprint({});
+	WANG_TILE_CHECK(OpenFootprint.OpenArea == 1.0f);
+	WANG_TILE_CHECK(OpenFootprint.ChokepointWidth == 1.0f);
+	for (int Side = 0; Side < OCCUPANCY_TEST_SIDE_COUNT; Side++)
+	{
+		WANG_TILE_CHECK(OpenFootprint.SideOpenings[Side] == 1.0f);
+		WANG_TILE_CHECK(OpenFootprint.SideLinks[Side] == (((1 << OCCUPANCY_TEST_SIDE_COUNT) - 1) & ~(1 << Side)));
+	}
+
+	// A corridor 5 cells wide from south to north (a box touching a cell's edge doesn't cover it):
+	const FWangTileFootprint CorridorFootprint = MeasureFootprint({ { -0.5f, 0.0f, 30.0f / 64, 1.0f },
+		{ 35.0f / 64, -0.5f, 1.5f, 1.5f } });
+	WANG_TILE_CHECK(CorridorFootprint.OpenArea == 5.0f / 64);
+	WANG_TILE_CHECK(CorridorFootprint.ChokepointWidth == 5.0f / 64);
+	WANG_TILE_CHECK(CorridorFootprint.SideOpenings[static_cast<int>(EWangTileSide::North)] == 5.0f / 62);
+	WANG_TILE_CHECK(CorridorFootprint.SideOpenings[static_cast<int>(EWangTileSide::South)] == 5.0f / 62);
+	WANG_TILE_CHECK(CorridorFootprint.SideOpenings[static_cast<int>(EWangTileSide::East)] == 0.0f);
+	WANG_TILE_CHECK(CorridorFootprint.SideLinks[static_cast<int>(EWangTileSide::North)] == 1 << static_cast<int>(EWangTileSide::South));
+	WANG_TILE_CHECK(CorridorFootprint.SideLinks[static_cast<int>(EWangTileSide::West)] == 0);
+
+	// Covered all over:
+	const FWangTileFootprint CoveredFootprint = MeasureFootprint({ { 0.0f, 0.0f, 1.0f, 1.0f } });
+	WANG_TILE_CHECK(CoveredFootprint.OpenArea == 0.0f);
+	WANG_TILE_CHECK(CoveredFootprint.ChokepointWidth == 0.0f);
+	WANG_TILE_CHECK(CoveredFootprint.GetMeanSideOpening() == 0.0f);
+}
+
+WANG_TILE_TEST(OccupancyMatchesCellByCellFootprints)
+{
+	FWangTileRandomStream RandomStream(64);
+
+	for (int TileIndex = 0; TileIndex < 300; TileIndex++)
+	{
+		// A few boxes, some reaching out of the tile, some thin enough to leave narrow paths:
+		std::vector<FOccupancyTestBox> Boxes(RandomStream.GetBoundedUInt32(8));
+		for (FOccupancyTestBox& Box : Boxes)
+		{
+			const float Coordinates[4] = { RandomStream.GetBoundedUInt32(1400) / 1000.0f - 0.2f,
+				RandomStream.GetBoundedUInt32(1400) / 1000.0f - 0.2f, RandomStream.GetBoundedUInt32(1400) / 1000.0f - 0.2f,
+				RandomStream.GetBoundedUInt32(1400) / 1000.0f - 0.2f };
+
+			Box = { std::min(Coordinates[0], Coordinates[2]), std::min(Coordinates[1], Coordinates[3]),
+				std::max(Coordinates[0], Coordinates[2]), std::max(Coordinates[1], Coordinates[3]) };
+		}
+
+		FWangTileOccupancy Occupancy;
+		for (const FOccupancyTestBox& Box : Boxes)
+		{
+			Occupancy.AddBox(Box.MinX, Box.MinY, Box.MaxX, Box.MaxY);
+		}
+
+		const FWangTileFootprint ExpectedFootprint = MeasureFootprintByCell(Boxes);
+		WANG_TILE_CHECK(Occupancy.GetOccupiedCellCount() == static_cast<int>(std::lround((1.0f - ExpectedFootprint.OpenArea) *
+			OCCUPANCY_TEST_RESOLUTION * OCCUPANCY_TEST_RESOLUTION)));
+		WANG_TILE_CHECK(FootprintsMatch(Occupancy.Measure(), ExpectedFootprint));
+	}
+}
+
+#endif
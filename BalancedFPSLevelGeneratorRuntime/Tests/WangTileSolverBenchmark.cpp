@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// (The engine builds every source file of the module, so the benchmark is only built by CMakeLists.txt):
+#ifdef WANG_TILE_STANDALONE_BUILD
+
+#include "WangTileTestSupport.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+/** For the fastest of (at least MIN_REPETITIONS, or MIN_BENCHMARK_SECONDS of) solves, in seconds. */
+static double TimeSolves(FWangTileSolver& Solver, const FWangTileSolverSettings& Settings, FWangTileGrid& OutGrid,
+	int& OutRepetitions)
+{
+	static const int MIN_REPETITIONS = 3;
+	static const double MIN_BENCHMARK_SECONDS = 0.5;
+
+	double FastestSeconds = 0.0;
+	double TotalSeconds = 0.0;
+	OutRepetitions = 0;
+
+	while (OutRepetitions < MIN_REPETITIONS || TotalSeconds < MIN_BENCHMARK_SECONDS)
+	{
+		const auto SolveStartTime = std::chrono::steady_clock::now();
+		Solver.Solve(Settings, OutGrid);
+		const double SolveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - SolveStartTime).count();
+
+		FastestSeconds = OutRepetitions == 0 ? SolveSeconds : std::min(FastestSeconds, SolveSeconds);
+		TotalSeconds += SolveSeconds;
+		OutRepetitions++;
+	}
+
+	return FastestSeconds;
+}
+
+/**
+* Times Solve() on square grids from 10x10 up to 2000x2000 tiles, on one thread and on every core
+* (each of the same Seed, so their checksums match).
+*
+* Usage: WangTileSolverBenchmark [--max-size Tiles] [--threads Count] [--seed Seed]
+*/
+int main(int ArgumentCount, char** Arguments)
+{
+	int MaxGridSize = 2000;
+	int ThreadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	uint32_t Seed = 735;
+
+	for (int ArgumentIndex = 1; ArgumentIndex + 1 < ArgumentCount; ArgumentIndex += 2)
+	{
+		if (std::strcmp(Arguments[ArgumentIndex], "--max-size") == 0)
+		{
+			MaxGridSize = std::atoi(Arguments[ArgumentIndex + 1]);
+		}
+		else if (std::strcmp(Arguments[ArgumentIndex], "--threads") == 0)
+		{
+			ThreadCount = std::max(1, std::atoi(Arguments[ArgumentIndex + 1]));
+		}
+		else if (std::strcmp(Arguments[ArgumentIndex], "--seed") == 0)
+		{
+			Seed = static_cast<uint32_t>(std::strtoul(Arguments[ArgumentIndex + 1], nullptr, 10));
+		}
+	}
+
+	static const int GRID_SIZES[] = { 10, 25, 50, 100, 250, 500, 1000, 2000 };
+
+	FWangTileSolver Solver(MakeTestTileSet());
+	FWangTileGrid Grid;
+
+	std::printf("%-11s %7s %5s %12s %10s  %s\n", "grid", "threads", "runs", "fastest ms", "ns/tile", "checksum");
+
+	for (int GridSize : GRID_SIZES)
+	{
+		if (GridSize > MaxGridSize)
+		{
+			break;
+		}
+
+		for (int SolveThreadCount : { 1, ThreadCount })
+		{
+			FWangTileSolverSettings Settings = MakeTestSettings(GridSize, GridSize);
+			Settings.Seed = Seed;
+			Settings.ThreadCount = SolveThreadCount;
+
+			int Repetitions = 0;
+			const double FastestSeconds = TimeSolves(Solver, Settings, Grid, Repetitions);
+
+			char GridName[32];
+			std::snprintf(GridName, sizeof(GridName), "%dx%d", GridSize, GridSize);
+			std::printf("%-11s %7d %5d %12.3f %10.2f  %016llx\n", GridName, SolveThreadCount, Repetitions,
+				FastestSeconds * 1000.0, FastestSeconds * 1.0e9 / Grid.GetCellCount(),
+				static_cast<unsigned long long>(Grid.ComputeLayoutChecksum()));
+
+			// (Only one row, if there is only one core):
+			if (ThreadCount == 1)
+			{
+				break;
+			}
+		}
+	}
+
+	return 0;
+}
+
+#endif
@@ -0,0 +1,258 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// (The engine builds every source file of the module, so the tests are only built by CMakeLists.txt):
+#ifdef WANG_TILE_STANDALONE_BUILD
+
+#include "WangTileTestSupport.h"
+
+/** For the tile the settings give the cell at (X, Y), if it is in a corner or along an edge (otherwise -1). */
+static int GetExpectedBoundaryTile(const FWangTileSolverSettings& Settings, int X, int Y)
+{
+	const bool IsWest = X == 0;
+	const bool IsEast = X == Settings.GridWidth - 1;
+	const bool IsSouth = Y == 0;
+	const bool IsNorth = Y == Settings.GridHeight - 1;
+
+	if (IsSouth)
+	{
+		return IsWest ? Settings.SouthWestCornerTile : IsEast ? Settings.SouthEastCornerTile : Settings.SouthEdgeTile;
+	}
+
+	if (IsNorth)
+	{
+		return IsWest ? Settings.NorthWestCornerTile : IsEast ? Settings.NorthEastCornerTile : Settings.NorthEdgeTile;
+	}
+
+	return IsWest ? Settings.WestEdgeTile : IsEast ? Settings.EastEdgeTile : -1;
+}
+
+/** If every cell has a tile, and the corners and edges (of every floor) have the tiles the settings give them. */
+static bool IsLayoutComplete(const FWangTileSolverSettings& Settings, const FWangTileGrid& Grid)
+{
+	if (Grid.GetWidth() != Settings.GridWidth || Grid.GetHeight() != Settings.GridHeight ||
+		Grid.GetDepth() != Settings.GridDepth)
+	{
+		return false;
+	}
+
+	for (int CellIndex = 0; CellIndex < Grid.GetCellCount(); CellIndex++)
+	{
+		const int BoundaryTile = GetExpectedBoundaryTile(Settings, Grid.GetX(CellIndex), Grid.GetY(CellIndex));
+
+		if (!Grid[CellIndex].HasTile() || (BoundaryTile != -1 && Grid[CellIndex].TileId != BoundaryTile))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+WANG_TILE_TEST(SolverSameChecksumOnAnyThreadCount)
+{
+	FWangTileSolver Solver(MakeTestTileSet());
+	const int GridSizes[][2] = { { 3, 3 }, { 10, 10 }, { 64, 64 }, { 200, 7 }, { 7, 200 } };
+
+	for (const int* GridSize : GridSizes)
+	{
+		for (uint32_t Seed = 1; Seed <= 10; Seed++)
+		{
+			FWangTileSolverSettings Settings = MakeTestSettings(GridSize[0], GridSize[1]);
+			Settings.Seed = Seed;
+			Settings.ThreadCount = 1;
+
+			FWangTileGrid SingleThreadGrid;
+			WANG_TILE_CHECK(Solver.Solve(Settings, SingleThreadGrid));
+			WANG_TILE_CHECK(IsLayoutComplete(Settings, SingleThreadGrid));
+
+			for (int ThreadCount : { 2, 3, 8 })
+			{
+				Settings.ThreadCount = ThreadCount;
+
+				FWangTileGrid ThreadedGrid;
+				WANG_TILE_CHECK(Solver.Solve(Settings, ThreadedGrid));
+				WANG_TILE_CHECK(ThreadedGrid.ComputeLayoutChecksum() == SingleThreadGrid.ComputeLayoutChecksum());
+			}
+		}
+	}
+}
+
+WANG_TILE_TEST(SolverBestOfSameOnAnyThreadCount)
+{
+	FWangTileSolver Solver(MakeTestTileSet());
+	FWangTileSolverSettings Settings = MakeTestSettings(32, 32);
+	Settings.Seed = 735;
+
+	FWangTileGrid SingleThreadGrid;
+	FWangTileCandidateReport SingleThreadReport;
+	Settings.ThreadCount = 1;
+	WANG_TILE_CHECK(Solver.SolveBestOf(Settings, 8, SingleThreadGrid, SingleThreadReport));
+
+	FWangTileGrid ThreadedGrid;
+	FWangTileCandidateReport ThreadedReport;
+	Settings.ThreadCount = 4;
+	WANG_TILE_CHECK(Solver.SolveBestOf(Settings, 8, ThreadedGrid, ThreadedReport));
+
+	WANG_TILE_CHECK(ThreadedReport.BestSeed == SingleThreadReport.BestSeed);
+	WANG_TILE_CHECK(ThreadedGrid.ComputeLayoutChecksum() == SingleThreadGrid.ComputeLayoutChecksum());
+
+	// The winning Seed solves the same layout on its own:
+	FWangTileGrid WinningGrid;
+	Settings.Seed = SingleThreadReport.BestSeed;
+	WANG_TILE_CHECK(Solver.Solve(Settings, WinningGrid));
+	WANG_TILE_CHECK(WinningGrid.ComputeLayoutChecksum() == SingleThreadGrid.ComputeLayoutChecksum());
+}
+
+WANG_TILE_TEST(SolverBestOfSeedWrapsAround)
+{
+	// The candidates after the largest Seed start again from 0 (as the editor tool's int32 Seed does):
+	FWangTileSolver Solver(MakeTestTileSet());
+	FWangTileSolverSettings Settings = MakeTestSettings(16, 16);
+	Settings.Seed = 0xFFFFFFFE;
+
+	bool bWrappedCandidateWon = false;
+
+	for (int CandidateCount = 2; CandidateCount <= 12; CandidateCount++)
+	{
+		FWangTileGrid BestGrid;
+		FWangTileCandidateReport Report;
+		WANG_TILE_CHECK(Solver.SolveBestOf(Settings, CandidateCount, BestGrid, Report));
+		WANG_TILE_CHECK(Report.BestSeed == static_cast<uint32_t>(Settings.Seed + Report.BestCandidate));
+		bWrappedCandidateWon |= Report.BestSeed < Settings.Seed;
+
+		// The reported Seed, through the tool's int32 and back, solves the layout that won:
+		FWangTileSolverSettings WinningSettings = Settings;
+		WinningSettings.Seed = static_cast<uint32_t>(static_cast<int32_t>(Report.BestSeed));
+
+		FWangTileGrid WinningGrid;
+		WANG_TILE_CHECK(Solver.Solve(WinningSettings, WinningGrid));
+		WANG_TILE_CHECK(WinningGrid.ComputeLayoutChecksum() == BestGrid.ComputeLayoutChecksum());
+	}
+
+	WANG_TILE_CHECK(bWrappedCandidateWon);
+}
+
+WANG_TILE_TEST(SolverFallsBackFromEmptyApplicableTiles)
+{
+	// (The fallbacks the tile-set needs anyway):
+	FWangTileSolverSettings Settings = MakeTestSettings(24, 24);
+	FWangTileSolver Solver(MakeTestTileSet());
+	FWangTileGrid Grid;
+	WANG_TILE_CHECK(Solver.Solve(Settings, Grid));
+	const FWangTileSolverStats DefaultStats = Solver.GetStats();
+
+	// WangTile2 has no pre-defined tiles, so its candidates come from the Dispersion rule...
+	Settings.ApplicableTilesForWangTile2.clear();
+	WANG_TILE_CHECK(Solver.Solve(Settings, Grid));
+	WANG_TILE_CHECK(IsLayoutComplete(Settings, Grid));
+	WANG_TILE_CHECK(Solver.GetStats().DispersionFallbacks > DefaultStats.DispersionFallbacks);
+	WANG_TILE_CHECK(Solver.GetStats().AnyTileFallbacks == DefaultStats.AnyTileFallbacks);
+
+	// ...and if it also has the lowest Dispersion Coefficient, from any tile:
+	std::vector<FWangTileDefinition> TileSet = MakeTestTileSet();
+	TileSet[Settings.WangTile2].DispersionCoefficient = 0.0f;
+
+	FWangTileSolver LowestDispersionSolver(TileSet);
+	WANG_TILE_CHECK(LowestDispersionSolver.Solve(MakeTestSettings(24, 24), Grid));
+	const int LowestDispersionAnyTileFallbacks = LowestDispersionSolver.GetStats().AnyTileFallbacks;
+
+	WANG_TILE_CHECK(LowestDispersionSolver.Solve(Settings, Grid));
+	WANG_TILE_CHECK(IsLayoutComplete(Settings, Grid));
+	WANG_TILE_CHECK(LowestDispersionSolver.GetStats().AnyTileFallbacks > LowestDispersionAnyTileFallbacks);
+}
+
+WANG_TILE_TEST(SolverFallsBackFromOneSidedThreshold)
+{
+	// Every tile is below the threshold, so none is ever across it from the tile placed:
+	FWangTileSolverSettings Settings = MakeTestSettings(24, 24);
+	Settings.DefensivenessThreshold = 1000.0f;
+
+	FWangTileSolver Solver(MakeTestTileSet());
+	FWangTileGrid Grid;
+	WANG_TILE_CHECK(Solver.Solve(Settings, Grid));
+	WANG_TILE_CHECK(IsLayoutComplete(Settings, Grid));
+	WANG_TILE_CHECK(Solver.GetStats().DispersionFallbacks > 0);
+}
+
+WANG_TILE_TEST(SolverFallsBackFromUnmatchedEdgeColours)
+{
+	// Every tile is colour 0 on its west and south sides, so a tile to the west with another colour
+	// on its east side is matched by no tile, and one to the south with another colour by none
+	// that also matches the tile to the west:
+	std::vector<FWangTileDefinition> TileSet = MakeTestTileSet();
+	for (int Tile = 0; Tile < static_cast<int>(TileSet.size()); Tile++)
+	{
+		FWangTileDefinition& Definition = TileSet[Tile];
+		Definition.EdgeColours[static_cast<int>(EWangTileSide::North)] = (Tile / 3) % 3;
+		Definition.EdgeColours[static_cast<int>(EWangTileSide::East)] = Tile % 3;
+		Definition.EdgeColours[static_cast<int>(EWangTileSide::South)] = 0;
+		Definition.EdgeColours[static_cast<int>(EWangTileSide::West)] = 0;
+	}
+
+	FWangTileSolver Solver(TileSet);
+	WANG_TILE_CHECK(Solver.UsesEdgeColours());
+
+	FWangTileSolverSettings Settings = MakeTestSettings(24, 24);
+	FWangTileGrid Grid;
+	WANG_TILE_CHECK(Solver.Solve(Settings, Grid));
+	WANG_TILE_CHECK(IsLayoutComplete(Settings, Grid));
+	WANG_TILE_CHECK(Solver.GetStats().AnyTileFallbacks > 0);
+	WANG_TILE_CHECK(Solver.GetStats().WestOnlyFallbacks > 0);
+}
+
+WANG_TILE_TEST(SolverRejectsInvalidSettings)
+{
+	FWangTileSolver Solver(MakeTestTileSet());
+	const int TileCount = Solver.GetTileCount();
+
+	auto IsRejected = [&Solver](const FWangTileSolverSettings& Settings)
+	{
+		FWangTileGrid Grid(4, 4);
+		return !Solver.Solve(Settings, Grid) && Grid.GetCellCount() == 0;
+	};
+
+	FWangTileSolverSettings Settings = MakeTestSettings(0, 16);
+	WANG_TILE_CHECK(IsRejected(Settings));
+
+	Settings = MakeTestSettings(16, -1);
+	WANG_TILE_CHECK(IsRejected(Settings));
+
+	Settings = MakeTestSettings(16, 16, 0);
+	WANG_TILE_CHECK(IsRejected(Settings));
+
+	Settings = MakeTestSettings(16, 16);
+	Settings.SouthWestCornerTile = -1;
+	WANG_TILE_CHECK(IsRejected(Settings));
+
+	Settings = MakeTestSettings(16, 16);
+	Settings.WestEdgeTile = TileCount;
+	WANG_TILE_CHECK(IsRejected(Settings));
+
+	Settings = MakeTestSettings(16, 16);
+	Settings.ApplicableTilesForWangTile10.push_back(TileCount);
+	WANG_TILE_CHECK(IsRejected(Settings));
+
+	Settings = MakeTestSettings(16, 16);
+	Settings.ApplicableTilesForWangTile2.push_back(-1);
+	WANG_TILE_CHECK(IsRejected(Settings));
+
+	// An edge colour beyond the table of candidates:
+	std::vector<FWangTileDefinition> TileSet = MakeTestTileSet();
+	TileSet[7].EdgeColours[0] = FWangTileDefinition::MAX_EDGE_COLOUR_COUNT;
+	FWangTileGrid Grid;
+	WANG_TILE_CHECK(!FWangTileSolver(TileSet).Solve(MakeTestSettings(16, 16), Grid));
+
+	// A corner that leads to another floor (only rejected with more than one floor):
+	TileSet = MakeTestTileSet();
+	TileSet[MakeTestSettings(16, 16).NorthEastCornerTile].VerticalLinks = FWangTileDefinition::VERTICAL_LINK_UP;
+	WANG_TILE_CHECK(!FWangTileSolver(TileSet).Solve(MakeTestSettings(16, 16, 2), Grid));
+	WANG_TILE_CHECK(FWangTileSolver(TileSet).Solve(MakeTestSettings(16, 16), Grid));
+
+	// No tiles at all:
+	WANG_TILE_CHECK(!FWangTileSolver(std::vector<FWangTileDefinition>()).Solve(MakeTestSettings(16, 16), Grid));
+
+	// (And the settings that are valid still solve):
+	WANG_TILE_CHECK(Solver.Solve(MakeTestSettings(16, 16), Grid));
+}
+
+#endif
@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// (The engine builds every source file of the module, so the tests are only built by CMakeLists.txt):
+#ifdef WANG_TILE_STANDALONE_BUILD
+
+#include "WangTileTestSupport.h"
+
+std::vector<FWangTileTest>& GetWangTileTests()
+{
+	static std::vector<FWangTileTest> Tests;
+	return Tests;
+}
+
+std::vector<FWangTileDefinition> MakeTestTileSet()
+{
+	static const float DISPERSION_COEFFICIENTS[] = { 0.23f, 0.5f, 0.25f, 0.25f, 0.25f, 0.25f, 1.0f, 0.14f, 0.13f, 0.5f,
+		0.15f, 1.0f, 0.14f, 0.24f, 0.24f, 0.24f, 0.17f, 0.15f, 1.0f, 1.0f, 1.0f, 1.0f };
+
+	std::vector<FWangTileDefinition> TileSet;
+	for (int Tile = 0; Tile < static_cast<int>(sizeof(DISPERSION_COEFFICIENTS) / sizeof(float)); Tile++)
+	{
+		FWangTileDefinition Definition;
+		Definition.DispersionCoefficient = DISPERSION_COEFFICIENTS[Tile];
+		Definition.ZoneObjectCount = Tile % 5;
+		Definition.TotalZoneObjectArea = 0.1f * (Tile % 3);
+		TileSet.push_back(Definition);
+	}
+
+	return TileSet;
+}
+
+FWangTileSolverSettings MakeTestSettings(int GridWidth, int GridHeight, int GridDepth)
+{
+	FWangTileSolverSettings Settings;
+	Settings.GridWidth = GridWidth;
+	Settings.GridHeight = GridHeight;
+	Settings.GridDepth = GridDepth;
+
+	Settings.SouthWestCornerTile = 5;
+	Settings.SouthEastCornerTile = 4;
+	Settings.NorthEastCornerTile = 3;
+	Settings.NorthWestCornerTile = 2;
+
+	Settings.NorthEdgeTile = 18;
+	Settings.EastEdgeTile = 19;
+	Settings.SouthEdgeTile = 20;
+	Settings.WestEdgeTile = 21;
+
+	Settings.WangTile2 = 1;
+	Settings.WangTile10 = 9;
+	Settings.ApplicableTilesForWangTile2 = { 3, 4, 6, 7, 9, 10, 11, 14 };
+	Settings.ApplicableTilesForWangTile10 = { 4, 5, 6, 11, 12, 15, 16, 18 };
+
+	return Settings;
+}
+
+#endif
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "WangTileTypes.h"
+#include <vector>
+#include "WangTileSolver.h"
+
+/** A named check, run by WangTileTests (see WangTileTests.cpp). */
+struct FWangTileTest
+{
+	const char* Name;
+	void (*Run)();
+};
+
+/** Every test, in the order they were registered (by WANG_TILE_TEST). */
+std::vector<FWangTileTest>& GetWangTileTests();
+
+struct FWangTileTestRegistration
+{
+	FWangTileTestRegistration(const char* Name, void (*Run)()) { GetWangTileTests().push_back({ Name, Run }); }
+};
+
+/** Define a test (named as its group, then what it checks, such as SolverSameChecksumOnAnyThreadCount). */
+#define WANG_TILE_TEST(TestName) \
+	static void TestName(); \
+	static FWangTileTestRegistration TestName##Registration(#TestName, &TestName); \
+	static void TestName()
+
+/** Record a failure (with where it was), and carry on with the test. */
+void ReportWangTileCheckFailure(const char* Condition, const char* File, int Line);
+
+#define WANG_TILE_CHECK(Condition) \
+	((Condition) ? static_cast<void>(0) : ReportWangTileCheckFailure(#Condition, __FILE__, __LINE__))
+
+/**
+* The 22 tiles of the level generator (with the Dispersion Coefficients of the Zone Blueprints, and
+* made-up objects), in the order of FZoneTileSet.
+*/
+std::vector<FWangTileDefinition> MakeTestTileSet();
+
+/** For a grid of the given size, with the placement rules of FZoneTileSet::ApplyPlacementRules(). */
+FWangTileSolverSettings MakeTestSettings(int GridWidth, int GridHeight, int GridDepth = 1);
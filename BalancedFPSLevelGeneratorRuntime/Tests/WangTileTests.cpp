@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// (The engine builds every source file of the module, so the tests are only built by CMakeLists.txt):
+#ifdef WANG_TILE_STANDALONE_BUILD
+
+#include "WangTileTestSupport.h"
+#include <cstdio>
+#include <cstring>
+
+static int WangTileCheckFailures = 0;
+
+void ReportWangTileCheckFailure(const char* Condition, const char* File, int Line)
+{
+	std::printf("  %s:%d: check failed: %s\n", File, Line, Condition);
+	WangTileCheckFailures++;
+}
+
+/**
+* Runs every test whose name starts with the first argument (or every test, with no argument).
+* Returns 1 if any check failed, or if no test matched.
+*/
+int main(int ArgumentCount, char** Arguments)
+{
+	const char* NamePrefix = ArgumentCount > 1 ? Arguments[1] : "";
+	int TestsRun = 0;
+	int TestsFailed = 0;
+
+	for (const FWangTileTest& Test : GetWangTileTests())
+	{
+		if (std::strncmp(Test.Name, NamePrefix, std::strlen(NamePrefix)) != 0)
+		{
+			continue;
+		}
+
+		const int FailuresBefore = WangTileCheckFailures;
+		Test.Run();
+		TestsRun++;
+
+		const bool bPassed = WangTileCheckFailures == FailuresBefore;
+		TestsFailed += bPassed ? 0 : 1;
+		std::printf("%s %s\n", bPassed ? "[ OK ]" : "[FAIL]", Test.Name);
+	}
+
+	std::printf("%d tests, %d failed\n", TestsRun, TestsFailed);
+
+	return TestsRun > 0 && TestsFailed == 0 ? 0 : 1;
+}
+
+#endif
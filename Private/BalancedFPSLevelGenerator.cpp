@@ -12,7 +12,10 @@
 #include "LevelEditor.h"
 #include "UObjectIterator.h"
 
+DEFINE_LOG_CATEGORY_STATIC(LogBalancedFPSLevelGenerator, Log, All);
+
 static const FName BalancedFPSLevelGeneratorTabName("BalancedFPSLevelGenerator");
+static const FName BalancedFPSLevelGeneratorRuntimeModuleName("BalancedFPSLevelGeneratorRuntime");
 
 #define LOCTEXT_NAMESPACE "FBalancedFPSLevelGeneratorModule"
 
@@ -25,6 +28,23 @@ void FBalancedFPSLevelGeneratorModule::StartupModule()
 	FBalancedFPSLevelGeneratorCommands::Register();
 	
 	PluginCommands = MakeShareable(new FUICommandList);
+
+	// The Zones and the solver are in the runtime module, which the .uplugin file must list (loaded before
+	// this one), or the Zone Blueprints will have loaded without its class redirects:
+	if (!FModuleManager::Get().IsModuleLoaded(BalancedFPSLevelGeneratorRuntimeModuleName))
+	{
+		const FText MissingRuntimeModuleMessage = LOCTEXT("MissingRuntimeModule",
+			"The BalancedFPSLevelGeneratorRuntime module was not loaded before the level generator. Add it to the plugin's .uplugin file (with a LoadingPhase of PreDefault), then restart the editor.");
+
+		UE_LOG(LogBalancedFPSLevelGenerator, Error, TEXT("%s"), *MissingRuntimeModuleMessage.ToString());
+		FMessageDialog::Open(EAppMsgType::Ok, MissingRuntimeModuleMessage);
+
+		// (Without it, there is no tool to add):
+		if (!FModuleManager::Get().LoadModule(BalancedFPSLevelGeneratorRuntimeModuleName))
+		{
+			return;
+		}
+	}
 		
 	FLevelEditorModule& LevelEditorModule = FModuleManager::LoadModuleChecked<FLevelEditorModule>("LevelEditor");
 	
@@ -0,0 +1,299 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BalancedFPSLevelGeneratorBenchmarkCommandlet.h"
+#include "BalancedFPSLevelGeneratorTool.h"
+#include "Editor/UnrealEd/Public/Editor.h"
+#include "Editor/UnrealEd/Public/FileHelpers.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/EngineVersion.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogBalancedFPSLevelGeneratorBenchmark, Log, All);
+
+UBalancedFPSLevelGeneratorBenchmarkCommandlet::UBalancedFPSLevelGeneratorBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBalancedFPSLevelGeneratorBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString MapName;
+	if (!FParse::Value(*Params, TEXT("Map="), MapName))
+	{
+		UE_LOG(LogBalancedFPSLevelGeneratorBenchmark, Error,
+			TEXT("-Map= is required (a map that holds the Zone Blueprints)."));
+		return 1;
+	}
+
+	// The matrix to generate (with defaults, for a quick run):
+	FString ExtentsList = TEXT("300x300+1000x1000+3000x3000");
+	FString SeedList = TEXT("0+1+2");
+	FParse::Value(*Params, TEXT("Extents="), ExtentsList);
+	FParse::Value(*Params, TEXT("Seeds="), SeedList);
+
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("BalancedFPSLevelGenerator") / TEXT("Benchmark.json");
+	FString BaselinePath;
+	float RegressionTolerance = DEFAULT_REGRESSION_TOLERANCE;
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+	FParse::Value(*Params, TEXT("Tolerance="), RegressionTolerance);
+
+	TArray<FVector2D> LevelExtentsMatrix = ParseLevelExtents(ExtentsList);
+	TArray<int32> Seeds = ParseSeeds(SeedList);
+
+	// Sanity check:
+	if (LevelExtentsMatrix.Num() == 0 || Seeds.Num() == 0)
+	{
+		UE_LOG(LogBalancedFPSLevelGeneratorBenchmark, Error, TEXT("-Extents= and -Seeds= must not be empty."));
+		return 1;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Runs;
+
+	for (const FVector2D& LevelExtents : LevelExtentsMatrix)
+	{
+		for (int32 Seed : Seeds)
+		{
+			TSharedPtr<FJsonObject> Run = RunBenchmark(MapName, LevelExtents, Seed);
+			if (!Run.IsValid())
+			{
+				UE_LOG(LogBalancedFPSLevelGeneratorBenchmark, Error, TEXT("Could not load %s."), *MapName);
+				return 1;
+			}
+
+			UE_LOG(LogBalancedFPSLevelGeneratorBenchmark, Display,
+				TEXT("%.0fx%.0f, Seed %d: %.3fs (%.0f tiles per second, %d actors)."), LevelExtents.X,
+				LevelExtents.Y, Seed, Run->GetNumberField(TEXT("WallSeconds")), Run->GetNumberField(TEXT("TilesPerSecond")),
+				static_cast<int32>(Run->GetNumberField(TEXT("ActorCount"))));
+
+			Runs.Add(MakeShareable(new FJsonValueObject(Run)));
+		}
+	}
+
+	int32 RegressionCount = 0;
+	if (!BaselinePath.IsEmpty())
+	{
+		RegressionCount = FlagRegressions(Runs, BaselinePath, RegressionTolerance);
+	}
+
+	TSharedRef<FJsonObject> Results = MakeShareable(new FJsonObject());
+	Results->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+	Results->SetStringField(TEXT("Map"), MapName);
+	Results->SetNumberField(TEXT("RegressionCount"), RegressionCount);
+	Results->SetArrayField(TEXT("Runs"), Runs);
+
+	FString ResultsString;
+	TSharedRef<TJsonWriter<>> ResultsWriter = TJsonWriterFactory<>::Create(&ResultsString);
+	if (!FJsonSerializer::Serialize(Results, ResultsWriter) || !FFileHelper::SaveStringToFile(ResultsString, *OutputPath))
+	{
+		UE_LOG(LogBalancedFPSLevelGeneratorBenchmark, Error, TEXT("Could not write %s."), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogBalancedFPSLevelGeneratorBenchmark, Display, TEXT("Wrote %d runs to %s (%d regressions)."), Runs.Num(),
+		*OutputPath, RegressionCount);
+
+	return RegressionCount > 0 ? 1 : 0;
+}
+
+TSharedPtr<FJsonObject> UBalancedFPSLevelGeneratorBenchmarkCommandlet::RunBenchmark(const FString& MapName,
+	const FVector2D& LevelExtents, int32 Seed) const
+{
+	// Start each generation from the same (unmodified) map:
+	if (!FEditorFileUtils::LoadMap(MapName, false, false))
+	{
+		return nullptr;
+	}
+
+	UWorld* EditorWorld = GEditor->GetEditorWorldContext().World();
+	int32 InitialActorCount = 0;
+	for (TActorIterator<AActor> ActorIterator(EditorWorld); ActorIterator; ++ActorIterator)
+	{
+		InitialActorCount++;
+	}
+
+	UBalancedFPSLevelGeneratorTool* GeneratorTool = NewObject<UBalancedFPSLevelGeneratorTool>(GetTransientPackage());
+	GeneratorTool->LevelExtents = LevelExtents;
+	GeneratorTool->Seed = Seed;
+	GeneratorTool->bGenerateAsynchronously = false;
+	GeneratorTool->bGenerateInStreamingChunks = false;
+
+	const double GenerationStartTime = FPlatformTime::Seconds();
+	GeneratorTool->GenerateLevel();
+	const double WallSeconds = FPlatformTime::Seconds() - GenerationStartTime;
+
+	int32 ActorCount = 0;
+	for (TActorIterator<AActor> ActorIterator(EditorWorld); ActorIterator; ++ActorIterator)
+	{
+		ActorCount++;
+	}
+
+	const FIntPoint ZoneGridSize = GeneratorTool->GetZoneGridSize();
+	const int32 TileCount = ZoneGridSize.X * ZoneGridSize.Y;
+	const FLevelGenerationTimings& Timings = GeneratorTool->GetLastGenerationTimings();
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+
+	TSharedPtr<FJsonObject> Run = MakeShareable(new FJsonObject());
+	Run->SetNumberField(TEXT("LevelExtentsX"), LevelExtents.X);
+	Run->SetNumberField(TEXT("LevelExtentsY"), LevelExtents.Y);
+	Run->SetNumberField(TEXT("Seed"), Seed);
+	Run->SetStringField(TEXT("LayoutChecksum"), GeneratorTool->LayoutChecksum);
+	Run->SetNumberField(TEXT("TileCount"), TileCount);
+	Run->SetNumberField(TEXT("ActorCount"), ActorCount - InitialActorCount);
+	Run->SetNumberField(TEXT("WallSeconds"), WallSeconds);
+	Run->SetNumberField(TEXT("SolveSeconds"), Timings.SolveSeconds);
+	Run->SetNumberField(TEXT("EncapsulationSeconds"), Timings.EncapsulationSeconds);
+	Run->SetNumberField(TEXT("LightSourceSeconds"), Timings.LightSourceSeconds);
+	Run->SetNumberField(TEXT("ZoneSeconds"), Timings.ZoneSeconds);
+	Run->SetNumberField(TEXT("TilesPerSecond"), WallSeconds > 0.0 ? TileCount / WallSeconds : 0.0);
+
+	// The peak is for the whole process so far (so run the largest extents last, to isolate them):
+	Run->SetNumberField(TEXT("PeakUsedPhysicalMegabytes"), MemoryStats.PeakUsedPhysical / BYTES_PER_MEGABYTE);
+	Run->SetNumberField(TEXT("UsedPhysicalMegabytes"), MemoryStats.UsedPhysical / BYTES_PER_MEGABYTE);
+
+	GeneratorTool->MarkPendingKill();
+
+	return Run;
+}
+
+int32 UBalancedFPSLevelGeneratorBenchmarkCommandlet::FlagRegressions(const TArray<TSharedPtr<FJsonValue>>& Runs,
+	const FString& BaselinePath, float RegressionTolerance) const
+{
+	FString BaselineString;
+	if (!FFileHelper::LoadFileToString(BaselineString, *BaselinePath))
+	{
+		UE_LOG(LogBalancedFPSLevelGeneratorBenchmark, Warning, TEXT("No baseline at %s, so nothing was compared."),
+			*BaselinePath);
+		return 0;
+	}
+
+	TSharedPtr<FJsonObject> Baseline;
+	TSharedRef<TJsonReader<>> BaselineReader = TJsonReaderFactory<>::Create(BaselineString);
+	if (!FJsonSerializer::Deserialize(BaselineReader, Baseline) || !Baseline.IsValid())
+	{
+		UE_LOG(LogBalancedFPSLevelGeneratorBenchmark, Warning, TEXT("%s is not a benchmark file."), *BaselinePath);
+		return 0;
+	}
+
+	TMap<FString, TSharedPtr<FJsonObject>> BaselineRuns;
+	for (const TSharedPtr<FJsonValue>& BaselineRun : Baseline->GetArrayField(TEXT("Runs")))
+	{
+		BaselineRuns.Add(GetRunKey(*BaselineRun->AsObject()), BaselineRun->AsObject());
+	}
+
+	int32 RegressionCount = 0;
+
+	for (const TSharedPtr<FJsonValue>& RunValue : Runs)
+	{
+		TSharedPtr<FJsonObject> Run = RunValue->AsObject();
+		const TSharedPtr<FJsonObject>* BaselineRun = BaselineRuns.Find(GetRunKey(*Run));
+		if (!BaselineRun)
+		{
+			continue;
+		}
+
+		TArray<TSharedPtr<FJsonValue>> Regressions;
+
+		// Slower, or larger, than the baseline allows:
+		for (const TCHAR* SecondsField : { TEXT("WallSeconds"), TEXT("SolveSeconds"), TEXT("EncapsulationSeconds"),
+			TEXT("LightSourceSeconds"), TEXT("ZoneSeconds") })
+		{
+			double Seconds = Run->GetNumberField(SecondsField);
+			double BaselineSeconds = (*BaselineRun)->GetNumberField(SecondsField);
+
+			if (Seconds > BaselineSeconds * (1.0 + RegressionTolerance) &&
+				Seconds - BaselineSeconds > MINIMUM_REGRESSION_SECONDS)
+			{
+				Regressions.Add(MakeShareable(new FJsonValueString(FString::Printf(TEXT("%s: %.3f (baseline %.3f)"),
+					SecondsField, Seconds, BaselineSeconds))));
+			}
+		}
+
+		double PeakMegabytes = Run->GetNumberField(TEXT("PeakUsedPhysicalMegabytes"));
+		double BaselinePeakMegabytes = (*BaselineRun)->GetNumberField(TEXT("PeakUsedPhysicalMegabytes"));
+		if (PeakMegabytes > BaselinePeakMegabytes * (1.0 + RegressionTolerance))
+		{
+			Regressions.Add(MakeShareable(new FJsonValueString(FString::Printf(
+				TEXT("PeakUsedPhysicalMegabytes: %.1f (baseline %.1f)"), PeakMegabytes, BaselinePeakMegabytes))));
+		}
+
+		// More actors for the same LevelExtents and Seed, means that fewer are being batched:
+		double ActorCount = Run->GetNumberField(TEXT("ActorCount"));
+		double BaselineActorCount = (*BaselineRun)->GetNumberField(TEXT("ActorCount"));
+		if (ActorCount > BaselineActorCount)
+		{
+			Regressions.Add(MakeShareable(new FJsonValueString(FString::Printf(TEXT("ActorCount: %.0f (baseline %.0f)"),
+				ActorCount, BaselineActorCount))));
+		}
+
+		// A different layout is not a regression itself, but the timings are then less comparable:
+		if (Run->GetStringField(TEXT("LayoutChecksum")) != (*BaselineRun)->GetStringField(TEXT("LayoutChecksum")))
+		{
+			UE_LOG(LogBalancedFPSLevelGeneratorBenchmark, Warning, TEXT("%s generated a different layout to the baseline."),
+				*GetRunKey(*Run));
+		}
+
+		for (const TSharedPtr<FJsonValue>& Regression : Regressions)
+		{
+			UE_LOG(LogBalancedFPSLevelGeneratorBenchmark, Error, TEXT("Regression in %s: %s"), *GetRunKey(*Run),
+				*Regression->AsString());
+		}
+
+		if (Regressions.Num() > 0)
+		{
+			Run->SetArrayField(TEXT("Regressions"), Regressions);
+			RegressionCount += Regressions.Num();
+		}
+	}
+
+	return RegressionCount;
+}
+
+FString UBalancedFPSLevelGeneratorBenchmarkCommandlet::GetRunKey(const FJsonObject& Run)
+{
+	return FString::Printf(TEXT("%.0fx%.0f, Seed %.0f"), Run.GetNumberField(TEXT("LevelExtentsX")),
+		Run.GetNumberField(TEXT("LevelExtentsY")), Run.GetNumberField(TEXT("Seed")));
+}
+
+TArray<FVector2D> UBalancedFPSLevelGeneratorBenchmarkCommandlet::ParseLevelExtents(const FString& ExtentsList)
+{
+	TArray<FString> ExtentsStrings;
+	ExtentsList.ParseIntoArray(ExtentsStrings, TEXT("+"));
+
+	TArray<FVector2D> LevelExtentsMatrix;
+	for (const FString& ExtentsString : ExtentsStrings)
+	{
+		FString ExtentsX;
+		FString ExtentsY;
+
+		if (ExtentsString.Split(TEXT("x"), &ExtentsX, &ExtentsY))
+		{
+			LevelExtentsMatrix.Add(FVector2D(FCString::Atof(*ExtentsX), FCString::Atof(*ExtentsY)));
+		}
+	}
+
+	return LevelExtentsMatrix;
+}
+
+TArray<int32> UBalancedFPSLevelGeneratorBenchmarkCommandlet::ParseSeeds(const FString& SeedList)
+{
+	TArray<FString> SeedStrings;
+	SeedList.ParseIntoArray(SeedStrings, TEXT("+"));
+
+	TArray<int32> Seeds;
+	for (const FString& SeedString : SeedStrings)
+	{
+		Seeds.Add(FCString::Atoi(*SeedString));
+	}
+
+	return Seeds;
+}
@@ -8,28 +8,81 @@
 #include "Runtime/Engine/Classes/Kismet/GameplayStatics.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/SCS_Node.h"
+#include "Components/StaticMeshComponent.h"
+#include "InstancedStaticMeshActor.h"
+#include "ZoneLayoutFile.h"
+#include "ZoneMeshMerge.h"
+#include "PackedZoneLayout.h"
+#include "WangTileConnectivity.h"
+// For building the HLOD clusters:
+#include "Engine/LODActor.h"
+#include "GameFramework/WorldSettings.h"
+#include "HierarchicalLODUtilitiesModule.h"
+#include "IHierarchicalLODUtilities.h"
+// For generating the level in streaming chunks:
+#include "Editor/UnrealEd/Public/EditorLevelUtils.h"
+#include "Runtime/Engine/Public/LevelUtils.h"
+#include "Engine/LevelStreamingKismet.h"
+#include "Engine/LevelStreamingVolume.h"
+#include "Builders/CubeBuilder.h"
+#include "Misc/PackageName.h"
+// For generating the level asynchronously:
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformTime.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+// For solving the Zone layout across every core:
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
 // For access to the GEditor object:
 #include "Editor/UnrealEd/Public/Editor.h"
 #include "Runtime/Engine/Classes/GameFramework/Actor.h"
 #include "Runtime/Engine/Classes/Engine/PointLight.h"
+// For pinning the Zones selected in the editor:
+#include "Engine/Selection.h"
 #include "Runtime/Core/Public//Math/UnrealMathUtility.h"
 #include "Runtime/Core/Public/HAL/Platform.h"
+// For profiling each phase of generation ('stat BalancedFPSLevelGenerator'):
+#include "Stats/Stats.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogBalancedFPSLevelGeneratorTool, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("BalancedFPSLevelGenerator"), STATGROUP_BalancedFPSLevelGenerator, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT(TEXT("Generate Level"), STAT_GenerateLevel, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_CYCLE_STAT(TEXT("Encapsulation"), STAT_Encapsulation, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_CYCLE_STAT(TEXT("Light Source"), STAT_LightSource, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_CYCLE_STAT(TEXT("Zone Discovery"), STAT_ZoneDiscovery, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_CYCLE_STAT(TEXT("Zone Solve"), STAT_ZoneSolve, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_CYCLE_STAT(TEXT("Coefficient Evaluation"), STAT_CoefficientEvaluation, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_CYCLE_STAT(TEXT("Tile Placement"), STAT_TilePlacement, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_CYCLE_STAT(TEXT("Zone Spawn"), STAT_ZoneSpawn, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_CYCLE_STAT(TEXT("Zone Construction"), STAT_ZoneConstruction, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_CYCLE_STAT(TEXT("HLOD Clusters"), STAT_HLODClusters, STATGROUP_BalancedFPSLevelGenerator);
+
+// These keep their values from the last generation (rather than being reset each frame):
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Candidates Considered"), STAT_CandidatesConsidered, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("West-Only Fallbacks"), STAT_WestOnlyFallbacks, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dispersion Fallbacks"), STAT_DispersionFallbacks, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Any-Tile Fallbacks"), STAT_AnyTileFallbacks, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Backtracks"), STAT_Backtracks, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Relaxed Cells"), STAT_RelaxedCells, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Connectivity Repairs"), STAT_ConnectivityRepairs, STATGROUP_BalancedFPSLevelGenerator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Actors Spawned"), STAT_ActorsSpawned, STATGROUP_BalancedFPSLevelGenerator);
 
-// For pseudo-random number generation:
-#include "random"
-#include "time.h"
 
 // Initialise:
 UBalancedFPSLevelGeneratorTool::UBalancedFPSLevelGeneratorTool()
 {
-	ApplicableZoneIndicesForWangTile2 = { 3, 4, 6, 7, 9, 10, 11, 14 };
-	ApplicableZoneIndicesForWangTile10 = { 4, 5, 6, 11, 12, 15, 16, 18 };
-
 	WallPanelBlueprintAsset = ConstructorHelpers::FObjectFinder<UBlueprint>(
 		TEXT("Blueprint'/Game/BalancedFPSLevelGeneratorAssets/Blueprints/WallPanel.WallPanel'"))
 		.Object;
 
-	for (int ZoneBlueprintCounter = 1; ZoneBlueprintCounter < TOTAL_ZONE_BLUEPRINT_COUNT + 1;
+	for (int ZoneBlueprintCounter = 1; ZoneBlueprintCounter < FZoneTileSet::ZONE_BLUEPRINT_COUNT + 1;
 		ZoneBlueprintCounter++)
 	{
 		FString IncrementalPathString = "Blueprint'/Game/BalancedFPSLevelGeneratorAssets/Blueprints/WangTiles/";
@@ -42,6 +95,41 @@ UBalancedFPSLevelGeneratorTool::UBalancedFPSLevelGeneratorTool()
 	DefaultRelativePanelScale = FVector(1.0f, 1.0f, 1.0f);
 	LevelExtents = FVector2D(300.0f, 300.0f);
 	LevelGenerationStartPoint = FVector(0.0f, 0.0f, 0.0f);
+	bUseInstancedWallPanels = true;
+	Seed = 0;
+	bSolveInParallel = true;
+	CandidateLayoutCount = 1;
+	bPropagateConstraints = false;
+	bRequireConnectivity = false;
+	BalanceQueryMin = FIntPoint(0, 0);
+	BalanceQueryMax = FIntPoint(0, 0);
+	DirtyRegionMin = FIntPoint(0, 0);
+	DirtyRegionMax = FIntPoint(-1, -1);
+	bGenerateInStreamingChunks = false;
+	ChunkSizeInTiles = 16;
+	bMergeZoneMeshes = false;
+	bBuildHLODClusters = false;
+	HLODClusterSizeInTiles = 8;
+	HLODTransitionScreenSize = 0.25f;
+	bPackZones = false;
+	ChunkStreamingDistance = 3000.0f;
+	bGenerateAsynchronously = false;
+	SpawnBudgetMilliseconds = 8.0f;
+	LayoutFilePath.FilePath = FZoneLayoutFile::GetDefaultLayoutFilename();
+
+	PendingZoneRegionIndex = 0;
+	PendingZoneCellIndex = 0;
+	bPendingZoneRegionBegun = false;
+	PendingZoneRegionLevel = nullptr;
+	PendingPackedZoneLayout = nullptr;
+	SpawnedZoneCount = 0;
+
+	GeneratedLevelExtents = LevelExtents;
+	GeneratedStartPoint = LevelGenerationStartPoint;
+	bGeneratedWithInstancedWallPanels = false;
+	bGeneratedInStreamingChunks = false;
+	bGeneratedPackedZones = false;
+	RegenerationCount = 0;
 
 	HelpText = FText::FromString(
 		"Change properties, before generating a level" 
@@ -56,61 +144,132 @@ UBalancedFPSLevelGeneratorTool::UBalancedFPSLevelGeneratorTool()
 
 void UBalancedFPSLevelGeneratorTool::GenerateLevel()
 {
+	// Only one level can be generated at a time:
+	if (IsGenerating())
+	{
+		return;
+	}
+
+	LastGenerationTimings = FLevelGenerationTimings();
+	SET_DWORD_STAT(STAT_ActorsSpawned, 0);
+
+	if (bGenerateAsynchronously)
+	{
+		BeginAsynchronousGeneration();
+		return;
+	}
+
 	// Initialise the level generation area first...
 	InitialiseLevelGenerationArea();		
 }
 
+void UBalancedFPSLevelGeneratorTool::RandomiseSeed()
+{
+	Seed = FMath::Rand();
+}
+
 // These functions handle initialisation of the level generation area:
 void UBalancedFPSLevelGeneratorTool::InitialiseLevelGenerationArea()
 {
-	// Encapsulate this level generation area first...
-	EncapsulateLevelGenerationArea();
+	SCOPE_CYCLE_COUNTER(STAT_GenerateLevel);
+
+	// Place the Zones first (nothing is spawned if this fails)...
+	TSharedPtr<FWangTileGrid, ESPMode::ThreadSafe> ZoneLayout = MakeShareable(new FWangTileGrid());
+	if (!SolveZoneLayout(*ZoneLayout))
+	{
+		return;
+	}
 
-	// ...add a light source to it...
+	// ...add a light source to the current (persistent) level...
 	AddLightSourceToLevelGenerationArea();
 
-	// ...then the level Zones can be added to it:
-	AddZonesToLevelGenerationArea();
+	// ...then encapsulate the area and add the level Zones to it, all at once:
+	if (BeginSpawningZoneLayout(ZoneLayout))
+	{
+		SpawnPendingZoneRegions(TNumericLimits<double>::Max());
+	}
 }
 
-void UBalancedFPSLevelGeneratorTool::EncapsulateLevelGenerationArea()
+void UBalancedFPSLevelGeneratorTool::EncapsulateLevelGenerationArea(const FIntRect& ZoneRegion, int GridHeight)
 {
-	// For testing:
-	int FrontFaceLoopCycleCount = 0;
-	int RightFaceLoopCycleCount = 0;
-	int BackFaceLoopCycleCount = 0;
-	int LeftFaceLoopCycleCount = 0;
+	SCOPE_CYCLE_COUNTER(STAT_Encapsulation);
+	const double EncapsulationStartTime = FPlatformTime::Seconds();
+
+	// For the instanced faces (where each panel is an instance, instead of an actor):
+	TArray<FTransform> BottomFacePanelTransforms;
+	TArray<FTransform> TopFacePanelTransforms;
 
-	
 	// Offset by DEFAULT_ENCAPSULATION_OFFSET, to allow Zones to fill in these gaps:
-	// Top and bottom faces:
-	for (float CurrentYPosition = LevelGenerationStartPoint.Y;
-		CurrentYPosition < LevelExtents.Y; CurrentYPosition +=
-		DEFAULT_TILE_WIDTH)
-	{
-		for (float CurrentXPosition = LevelGenerationStartPoint.X;
-			CurrentXPosition < LevelExtents.X; CurrentXPosition +=
-			DEFAULT_TILE_WIDTH)
+	// Top and bottom faces (one panel under and over each Zone in this region):
+	for (int GridY = ZoneRegion.Min.Y; GridY < ZoneRegion.Max.Y; GridY++)
+	{
+		for (int GridX = ZoneRegion.Min.X; GridX < ZoneRegion.Max.X; GridX++)
 		{	
+			FVector PanelTilePosition = GetPanelTilePosition(GridX, GridY, GridHeight);
+
+			if (bUseInstancedWallPanels)
+			{
+				BottomFacePanelTransforms.Add(GetTopOrBottomWallPanelTransform(PanelTilePosition, false));
+				TopFacePanelTransforms.Add(GetTopOrBottomWallPanelTransform(PanelTilePosition, true));
+				continue;
+			}
+
 			// For the bottom tile first...
-			SpawnTopOrBottomWallPanelTileForCurrentPosition(FVector(CurrentXPosition, CurrentYPosition, 0.0f), false);
+			AActor* BottomPanel = SpawnTopOrBottomWallPanelTileForCurrentPosition(PanelTilePosition, false);
 		
 			// ...then the top tile:
-			SpawnTopOrBottomWallPanelTileForCurrentPosition(FVector(CurrentXPosition, CurrentYPosition, 0.0f), true);
+			AActor* TopPanel = SpawnTopOrBottomWallPanelTileForCurrentPosition(PanelTilePosition, true);
+
+			// Kept, so that they can be moved or removed by RegenerateDirtyRegion():
+			const int PanelIndex = 2 * GeneratedZoneLayout->GetIndex(GridX, GridY);
+			if (GeneratedPanelActors.IsValidIndex(PanelIndex + 1))
+			{
+				GeneratedPanelActors[PanelIndex] = BottomPanel;
+				GeneratedPanelActors[PanelIndex + 1] = TopPanel;
+			}
 		}
 	}
+
+	if (bUseInstancedWallPanels)
+	{
+		GeneratedPanelFaces.Add(SpawnInstancedWallPanelFace(BottomFacePanelTransforms, "BottomFacePanels"));
+		GeneratedPanelFaces.Add(SpawnInstancedWallPanelFace(TopFacePanelTransforms, "TopFacePanels"));
+	}
+
+	LastGenerationTimings.EncapsulationSeconds += FPlatformTime::Seconds() - EncapsulationStartTime;
 }
 
 // For either the top of bottom faces, of the level-generation area encapsulation geometry:
-void UBalancedFPSLevelGeneratorTool::SpawnTopOrBottomWallPanelTileForCurrentPosition(FVector PanelTilePosition, bool IsTopFaceTile)
+AActor* UBalancedFPSLevelGeneratorTool::SpawnTopOrBottomWallPanelTileForCurrentPosition(FVector PanelTilePosition, bool IsTopFaceTile)
 {
 	// For each wall panel to use in initialisation:
 	static AActor* WallPanelActor;
 
+	FTransform LevelPanelTransform = GetTopOrBottomWallPanelTransform(PanelTilePosition, IsTopFaceTile);
+
+	WallPanelActor = UGameplayStatics::BeginSpawningActorFromBlueprint(GEditor->GetEditorWorldContext().World()->GetCurrentLevel(),
+		WallPanelBlueprintAsset, LevelPanelTransform, false);
+	WallPanelActor->ExecuteConstruction(LevelPanelTransform, nullptr, nullptr, true);
+	INC_DWORD_STAT(STAT_ActorsSpawned);
+
+	return WallPanelActor;
+}
+
+FVector UBalancedFPSLevelGeneratorTool::GetPanelTilePosition(int GridX, int GridY, int GridHeight) const
+{
+	// Panels are positioned by their corner, rather than their centre (as Zones are):
+	FVector PanelTilePosition = GetZoneTransform(GridX, GridY, GridHeight).GetLocation() -
+		FVector(ZONE_POSITION_OFFSET.X, ZONE_POSITION_OFFSET.Y, 0.0f);
+	PanelTilePosition.Z = 0.0f;
+
+	return PanelTilePosition;
+}
+
+FTransform UBalancedFPSLevelGeneratorTool::GetTopOrBottomWallPanelTransform(FVector PanelTilePosition, bool IsTopFaceTile) const
+{
 	// It seems rotation has been shuffled to the left, with a 
 	// wrap around (Z for Y, Y for X etc.) in UE4:
 	FRotator TopBottomFaceRotation = FRotator(0.0f, 0.0f, 90.0f);
-	FTransform LevelPanelTransform = FTransform();
 
 	if (IsTopFaceTile)
 	{
@@ -124,494 +283,1453 @@ void UBalancedFPSLevelGeneratorTool::SpawnTopOrBottomWallPanelTileForCurrentPosi
 		PanelTilePosition.Z -= DEFAULT_ENCAPSULATION_OFFSET;
 	}
 
-	LevelPanelTransform = FTransform(TopBottomFaceRotation.Quaternion(), PanelTilePosition, DefaultRelativePanelScale);
-
-	WallPanelActor = UGameplayStatics::BeginSpawningActorFromBlueprint(GEditor->GetEditorWorldContext().World()->GetCurrentLevel(),
-		WallPanelBlueprintAsset, LevelPanelTransform, false);
-	WallPanelActor->ExecuteConstruction(LevelPanelTransform, nullptr, nullptr, true);
+	return FTransform(TopBottomFaceRotation.Quaternion(), PanelTilePosition, DefaultRelativePanelScale);
 }
 
-void UBalancedFPSLevelGeneratorTool::AddLightSourceToLevelGenerationArea()
+AActor* UBalancedFPSLevelGeneratorTool::SpawnInstancedWallPanelFace(const TArray<FTransform>& PanelTransforms,
+	const FString& FaceLabel)
 {
-	// Put a point-light at the centre of the now encapsulated level generation area:
-	FTransform DefaultLightSourceTransform = FTransform(FRotator::ZeroRotator.Quaternion(), FVector(LevelGenerationStartPoint.X + 0.50f
-		* LevelExtents.X, LevelGenerationStartPoint.Y + 0.50f * LevelExtents.Y, LevelGenerationStartPoint.Z + 0.50f * DEFAULT_TILE_HEIGHT),
-		FVector(1.0f));
-	APointLight* DefaultLightSource = Cast<APointLight>(GEditor->AddActor(GEditor->GetEditorWorldContext().World()->GetCurrentLevel(),
-		APointLight::StaticClass(), DefaultLightSourceTransform));
-}
+	UStaticMeshComponent* WallPanelMeshTemplate = FindWallPanelMeshTemplate();
 
-// Now zones can be added to it (Wang Tiles):
-void UBalancedFPSLevelGeneratorTool::AddZonesToLevelGenerationArea()
-{
-	// For each Zone to use in initialisation:
-	static AActor* ZoneTile;
+	// Sanity check:
+	if (!WallPanelMeshTemplate || PanelTransforms.Num() == 0)
+	{
+		return nullptr;
+	}
 
-	// Set-up the relative corner positions (now that the bounds of the level-generation area are known):
-	TopLeftCorner = FVector2D(LevelGenerationStartPoint.X + ZONE_POSITION_OFFSET.X,
-		LevelGenerationStartPoint.Y + ZONE_POSITION_OFFSET.Y);
-	TopRightCorner = FVector2D(LevelExtents.X - ZONE_POSITION_OFFSET.X,
-		LevelGenerationStartPoint.Y + ZONE_POSITION_OFFSET.Y);
-	BottomRightCorner = FVector2D(LevelExtents.X - ZONE_POSITION_OFFSET.X,
-		LevelExtents.Y - ZONE_POSITION_OFFSET.Y);
-	BottomLeftCorner = FVector2D(LevelGenerationStartPoint.X + ZONE_POSITION_OFFSET.X,
-		LevelExtents.Y - ZONE_POSITION_OFFSET.Y);
+	UWorld* EditorWorld = GEditor->GetEditorWorldContext().World();
+	FActorSpawnParameters FaceSpawnParameters;
+	FaceSpawnParameters.OverrideLevel = EditorWorld->GetCurrentLevel();
 
-	// For the Zone Blueprints, as Actors:
-	TArray<AActor*> ActorZones;
-	UGameplayStatics::GetAllActorsOfClass(GEditor->GetEditorWorldContext()
-		.World()->GetCurrentLevel(), AZone::StaticClass(), ActorZones);
+	AInstancedStaticMeshActor* WallPanelFace = EditorWorld->SpawnActor<AInstancedStaticMeshActor>(
+		AInstancedStaticMeshActor::StaticClass(), FTransform::Identity, FaceSpawnParameters);
 
-	// Remove all the Zone Blueprints that have no 'TileSpawnBlueprint' tag:
-	for (int ActorZonesIterator = 0; ActorZonesIterator < ActorZones.Num() - 1; ActorZonesIterator++)
+	if (!WallPanelFace)
 	{
-		if (ActorZones[ActorZonesIterator]->Tags.Find(TILE_SPAWN_BLUEPRINT_TAG) == INDEX_NONE)
-		{
-			ActorZones.RemoveAt(ActorZonesIterator, 1, true);
-			// As this item has been removed:
-			ActorZonesIterator--;
-		}
+		return nullptr;
 	}
-	
-	// Store the zones:
-	for (int ActorZonesCounter = 0; ActorZonesCounter < ActorZones.Num(); ActorZonesCounter++)
+
+	WallPanelFace->SetActorLabel(FaceLabel);
+	INC_DWORD_STAT(STAT_ActorsSpawned);
+
+	// Match the panel's mesh, materials and collision:
+	UHierarchicalInstancedStaticMeshComponent* InstancedPanels = WallPanelFace->GetInstancedStaticMeshComponent();
+	InstancedPanels->SetStaticMesh(WallPanelMeshTemplate->GetStaticMesh());
+	InstancedPanels->SetCollisionProfileName(WallPanelMeshTemplate->GetCollisionProfileName());
+
+	for (int MaterialIndex = 0; MaterialIndex < WallPanelMeshTemplate->GetNumMaterials(); MaterialIndex++)
 	{
-		// Initialise here as well:
-		LevelZones.Add(Cast<AZone, AActor>(ActorZones[ActorZonesCounter]));
-		LevelZones[ActorZonesCounter]->InitialiseZone();
+		InstancedPanels->SetMaterial(MaterialIndex, WallPanelMeshTemplate->GetMaterial(MaterialIndex));
 	}
 
-	// The main loop to place the zones:
-	
-	// Work backwards from the last row:
-	for (float CurrentYPosition = LevelGenerationStartPoint.Y + LevelExtents.Y;
-		CurrentYPosition > LevelGenerationStartPoint.Y; CurrentYPosition -=
-		DEFAULT_TILE_WIDTH)
+	// The mesh may be offset (or scaled) within the WallPanel Blueprint:
+	TArray<FTransform> InstanceTransforms;
+	InstanceTransforms.Reserve(PanelTransforms.Num());
+
+	for (const FTransform& PanelTransform : PanelTransforms)
 	{
-		for (float CurrentXPosition = LevelGenerationStartPoint.X;
-			CurrentXPosition < LevelExtents.X; CurrentXPosition +=
-			DEFAULT_TILE_WIDTH)
-		{
-			FVector CurrentPosition = FVector(CurrentXPosition,
-				CurrentYPosition, DEFAULT_TILE_Z_POSITION);
-			FRotator ZoneRotation = FRotator(0.0f, 0.0f, 0.0f);
+		InstanceTransforms.Add(WallPanelMeshTemplate->GetRelativeTransform() * PanelTransform);
+	}
 
-			FTransform LevelZoneTransform = FTransform(ZoneRotation.Quaternion(), CurrentPosition, DEFAULT_ZONE_SCALE);
+	WallPanelFace->AddInstances(InstanceTransforms);
 
-			// RESOLVE ISSUES WITH THE PLACEMENT OF ZONES THAT ARE NOT CORNER OR EDGE PIECES: 
+	return WallPanelFace;
+}
 
-			// Offset the X and Y components of the CurrentPosition:
-			LevelZoneTransform.SetComponents(LevelZoneTransform.GetRotation(), FVector(LevelZoneTransform.GetLocation().X +
-				ZONE_POSITION_OFFSET.X, LevelZoneTransform.GetLocation().Y - ZONE_POSITION_OFFSET.Y, LevelZoneTransform.GetLocation().Z),
-				LevelZoneTransform.GetScale3D());
+UStaticMeshComponent* UBalancedFPSLevelGeneratorTool::FindWallPanelMeshTemplate() const
+{
+	UBlueprintGeneratedClass* WallPanelClass = WallPanelBlueprintAsset ?
+		Cast<UBlueprintGeneratedClass>(WallPanelBlueprintAsset->GeneratedClass) : nullptr;
 
-			// INVALID ACCESS OPERATION OCCURS HERE:
-			UBlueprint* ZoneTileBlueprint = GetSuitableZoneTile(FVector2D(LevelZoneTransform.GetLocation()));
+	if (!WallPanelClass)
+	{
+		return nullptr;
+	}
 
-			ZoneTile = UGameplayStatics::BeginSpawningActorFromBlueprint(GEditor->GetEditorWorldContext().World()->GetCurrentLevel(),
-				ZoneTileBlueprint, LevelZoneTransform, false);
-			// Nullify the ZoneTileBlueprint, so that it is set again in the next iterator of this loop:
-			ZoneTileBlueprint = nullptr;
+	// A native component (if the WallPanel derives from AStaticMeshActor)...
+	if (UStaticMeshComponent* NativeMeshComponent = WallPanelClass->GetDefaultObject<AActor>()->
+		FindComponentByClass<UStaticMeshComponent>())
+	{
+		return NativeMeshComponent;
+	}
 
-			// Sanity check:
-			if (ZoneTile)
+	// ...or one added in the Blueprint's components panel:
+	if (WallPanelClass->SimpleConstructionScript)
+	{
+		for (USCS_Node* ComponentNode : WallPanelClass->SimpleConstructionScript->GetAllNodes())
+		{
+			if (UStaticMeshComponent* MeshTemplate = Cast<UStaticMeshComponent>(ComponentNode->ComponentTemplate))
 			{
-				ZoneTile->ExecuteConstruction(LevelZoneTransform, nullptr, nullptr, true);
+				return MeshTemplate;
 			}
 		}
 	}
-	
-	// Clear up the placed level Zones for the next level generated:
-	PlacedLevelZones.Empty();
-	PlacedZonePositions.empty();
+
+	return nullptr;
 }
 
-UBlueprint* UBalancedFPSLevelGeneratorTool::GetSuitableZoneTile(FVector2D CurrentPlacementPosition)
-{	
-	// For the index to find the target Zone, from the array of Zones:
-	int ZoneChoice = -1;
+void UBalancedFPSLevelGeneratorTool::AddLightSourceToLevelGenerationArea()
+{
+	SCOPE_CYCLE_COUNTER(STAT_LightSource);
+	const double LightSourceStartTime = FPlatformTime::Seconds();
+
+	APointLight* DefaultLightSource = Cast<APointLight>(GEditor->AddActor(GEditor->GetEditorWorldContext().World()->GetCurrentLevel(),
+		APointLight::StaticClass(), GetLightSourceTransform()));
+	INC_DWORD_STAT(STAT_ActorsSpawned);
 
-	// Flags:
+	GeneratedLightSource = DefaultLightSource;
 
-	bool PlacementInCorner = false;
-	bool PlacementAlongEdge = false;	
+	LastGenerationTimings.LightSourceSeconds += FPlatformTime::Seconds() - LightSourceStartTime;
+}
 
-	// Check to see if the function can return a value here,
-	// before checking against the placed Zones in the level
-	// -generation area:
+FTransform UBalancedFPSLevelGeneratorTool::GetLightSourceTransform() const
+{
+	// Put a point-light at the centre of the now encapsulated level generation area:
+	return FTransform(FRotator::ZeroRotator.Quaternion(), FVector(LevelGenerationStartPoint.X + 0.50f
+		* LevelExtents.X, LevelGenerationStartPoint.Y + 0.50f * LevelExtents.Y, LevelGenerationStartPoint.Z + 0.50f * DEFAULT_TILE_HEIGHT),
+		FVector(1.0f));
+}
 
-	// Zone 3:
-	if (CurrentPlacementPosition == TopLeftCorner)
-	{		
-		ZoneChoice = ZONE_THREE_INDEX;
-		PlacementInCorner = true;
-	}
-	// Zone 4:
-	else if (CurrentPlacementPosition == TopRightCorner)
+bool UBalancedFPSLevelGeneratorTool::PrepareZoneSolve(std::vector<FWangTileDefinition>& OutZoneTileSet,
+	FWangTileSolverSettings& OutSolverSettings)
+{
+	if (!GatherZoneTileSet(OutZoneTileSet))
 	{
-		ZoneChoice = ZONE_FOUR_INDEX;
-		PlacementInCorner = true;
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(
+			"Zones could not be added: every Zone Blueprint (WangTile1 to WangTile22) must be in"
+			" /Game/BalancedFPSLevelGeneratorAssets/Blueprints/WangTiles/, and derive from Zone."));
+		return false;
 	}
-	// Zone 5:
-	else if (CurrentPlacementPosition == BottomRightCorner)
+
+	const FIntPoint ZoneGridSize = GetZoneGridSize();
+	OutSolverSettings = GetSolverSettings(ZoneGridSize.X, ZoneGridSize.Y);
+	return true;
+}
+
+FIntPoint UBalancedFPSLevelGeneratorTool::GetZoneGridSize() const
+{
+	// The number of Zones that fit along each axis of the level-generation area:
+	return FIntPoint(FMath::CeilToInt((LevelExtents.X - LevelGenerationStartPoint.X) / DEFAULT_TILE_WIDTH),
+		FMath::CeilToInt(LevelExtents.Y / DEFAULT_TILE_HEIGHT));
+}
+
+bool UBalancedFPSLevelGeneratorTool::SolveZoneLayout(FWangTileGrid& OutZoneLayout)
+{
+	std::vector<FWangTileDefinition> ZoneTileSet;
+	FWangTileSolverSettings SolverSettings;
+	if (!PrepareZoneSolve(ZoneTileSet, SolverSettings))
 	{
-		ZoneChoice = ZONE_FIVE_INDEX;
-		PlacementInCorner = true;
+		return false;
 	}
-	// Zone 6:
-	else if (CurrentPlacementPosition == BottomLeftCorner)
+
+	const double SolveStartTime = FPlatformTime::Seconds();
+
+	FWangTileCandidateReport CandidateReport;
+	bool ZoneLayoutSolved = RunZoneSolver(ZoneTileSet, SolverSettings, CandidateLayoutCount, OutZoneLayout,
+		CandidateReport);
+
+	LastGenerationTimings.SolveSeconds += FPlatformTime::Seconds() - SolveStartTime;
+
+	if (!ZoneLayoutSolved)
 	{
-		ZoneChoice = ZONE_SIX_INDEX;
-		PlacementInCorner = true;
+		return false;
 	}
 
-	// If this Zone is to be placed against an edge of
-	// the level generation area, then the tile will 
-	// have to match 'pure' wall 'edges', as well as
-	// the Edge colour of any other adjacent Zones:
+	ReportZoneLayout(OutZoneLayout, CandidateReport);
+	return true;
+}
+
+bool UBalancedFPSLevelGeneratorTool::RunZoneSolver(const std::vector<FWangTileDefinition>& ZoneTileSet,
+	const FWangTileSolverSettings& SolverSettings, int32 CandidateCount, FWangTileGrid& OutZoneLayout,
+	FWangTileCandidateReport& OutCandidateReport)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ZoneSolve);
+
+	FWangTileSolver ZoneSolver(ZoneTileSet);
+	OutCandidateReport = FWangTileCandidateReport();
+
+	bool ZoneLayoutSolved = CandidateCount > 1 ?
+		ZoneSolver.SolveBestOf(SolverSettings, CandidateCount, OutZoneLayout, OutCandidateReport) :
+		ZoneSolver.Solve(SolverSettings, OutZoneLayout);
+
+#if STATS
+	// The solver is plain C++, so it times (and counts) its own phases:
+	const FWangTileSolverStats& SolverStats = ZoneSolver.GetStats();
+	SET_CYCLE_COUNTER(STAT_CoefficientEvaluation, SolverStats.PrepareSeconds / FPlatformTime::GetSecondsPerCycle());
+	SET_CYCLE_COUNTER(STAT_TilePlacement, SolverStats.PlacementSeconds / FPlatformTime::GetSecondsPerCycle());
+	SET_DWORD_STAT(STAT_CandidatesConsidered, SolverStats.CandidatesConsidered);
+	SET_DWORD_STAT(STAT_WestOnlyFallbacks, SolverStats.WestOnlyFallbacks);
+	SET_DWORD_STAT(STAT_DispersionFallbacks, SolverStats.DispersionFallbacks);
+	SET_DWORD_STAT(STAT_AnyTileFallbacks, SolverStats.AnyTileFallbacks);
+	SET_DWORD_STAT(STAT_Backtracks, SolverStats.Backtracks);
+	SET_DWORD_STAT(STAT_RelaxedCells, SolverStats.RelaxedCells);
+	SET_DWORD_STAT(STAT_ConnectivityRepairs, SolverStats.ConnectivityRepairs);
+#endif
+
+	return ZoneLayoutSolved;
+}
 
-	// If this area has already been deemed to be a corner,
-	// then skip these checks:
+void UBalancedFPSLevelGeneratorTool::ReportZoneLayout(const FWangTileGrid& ZoneLayout,
+	const FWangTileCandidateReport& CandidateReport)
+{
+	LayoutChecksum = FString::Printf(TEXT("%016llX"), static_cast<uint64>(ZoneLayout.ComputeLayoutChecksum()));
+	ReportZoneBalance(ZoneLayout);
 
-	// This Zone will be placed along an edge of the level generation area:
-	if (!PlacementInCorner)
+	// Only for the best of several layouts:
+	if (CandidateReport.CandidateCount == 0)
 	{
-		// North level-generation area 'edge':
-		if (CurrentPlacementPosition.Y == LevelGenerationStartPoint.Y + ZONE_POSITION_OFFSET.Y)
-		{
-			ZoneChoice = ZONE_NINETEEN_INDEX;
-			PlacementAlongEdge = true;
-		}
+		CandidateScoreSpread.Empty();
+		return;
+	}
 
-		// East level-generation area 'edge':
-		if (CurrentPlacementPosition.X == LevelExtents.X - ZONE_POSITION_OFFSET.X)
-		{
-			ZoneChoice = ZONE_TWENTY_INDEX;
-			PlacementAlongEdge = true;
-		}
+	// (The solver's Seeds are as wide as this one, so the best candidate's Seed generates it again):
+	Seed = static_cast<int32>(CandidateReport.BestSeed);
 
-		// South level-generation area 'edge':
-		if (CurrentPlacementPosition.Y == LevelExtents.Y - ZONE_POSITION_OFFSET.Y)
-		{
-			ZoneChoice = ZONE_TWENTY_ONE_INDEX;
-			PlacementAlongEdge = true;
-		}
+	CandidateScoreSpread = FString::Printf(TEXT("Best of %d: %.4f (Defensiveness %.4f, Dispersion %.4f);"
+		" mean %.4f, worst %.4f, standard deviation %.4f"), CandidateReport.CandidateCount,
+		CandidateReport.BestScore.GetTotalImbalance(), CandidateReport.BestScore.DefensivenessImbalance,
+		CandidateReport.BestScore.DispersionImbalance, CandidateReport.MeanImbalance,
+		CandidateReport.WorstImbalance, CandidateReport.ImbalanceStandardDeviation);
 
-		// West level-generation area 'edge':
-		if (CurrentPlacementPosition.X == LevelGenerationStartPoint.X + ZONE_POSITION_OFFSET.X)
-		{
-			ZoneChoice = ZONE_TWENTY_TWO_INDEX;
-			PlacementAlongEdge = true;
-		}
-	}
-	
-	// A Zone will be placed in a corner or along an Edge of the level-generation area
-	// (so determine its defensive and flanking coefficients' respectivly):
-	if (PlacementInCorner)
+	if (bRequireConnectivity)
 	{
-		LevelZones[ZoneChoice]->DetermineDefensivenessAndFlankingCoefficients(3.0f, 2.0f);
-		PlacedZonePositions.push_back(CurrentPlacementPosition);
-		return GetTargetZone(ZoneChoice);
+		CandidateScoreSpread += FString::Printf(TEXT("; %d left cut off"), CandidateReport.DisconnectedCandidates);
 	}
+}
 
-	if (PlacementAlongEdge)
+void UBalancedFPSLevelGeneratorTool::ReportZoneBalance(const FWangTileGrid& ZoneLayout)
+{
+	std::vector<FWangTileDefinition> ZoneTileSet;
+	if (!GatherZoneTileSet(ZoneTileSet))
 	{
-		LevelZones[ZoneChoice]->DetermineDefensivenessAndFlankingCoefficients(5.0f, 3.0f);
-		PlacedZonePositions.push_back(CurrentPlacementPosition);
-		return GetTargetZone(ZoneChoice);
+		GeneratedBalanceMap = FWangTileBalanceMap();
+		BalanceReport.Empty();
+		ConnectivityReport.Empty();
+		return;
 	}
 
-	CurrentPlacementPosition.X == 1500.0f && CurrentPlacementPosition.Y == 1500.0f;
-	// Check If any Zones have been placed:
-	for (int PlacedZonesIterator = 0; PlacedZonesIterator < PlacedLevelZones.Num();
-		PlacedZonesIterator++)
+	ReportZoneConnectivity(ZoneTileSet, ZoneLayout);
+
+	// (Across every core, if solving in parallel):
+	const FWangTileSolverSettings SolverSettings = GetSolverSettings(ZoneLayout.GetWidth(), ZoneLayout.GetHeight());
+	GeneratedBalanceMap.Build(ZoneTileSet, ZoneLayout, SolverSettings);
+	const FWangTileBalanceReport Report = GeneratedBalanceMap.ComputeReport(SolverSettings);
+
+	const TCHAR* CoefficientNames[] = { TEXT("Defensiveness"), TEXT("Flanking"), TEXT("Dispersion") };
+	BalanceReport.Empty();
+
+	for (int CoefficientIndex = 0; CoefficientIndex < static_cast<int>(EWangTileCoefficient::Count); CoefficientIndex++)
 	{
-		if (PlacedLevelZones.Num() == 0)
-		{
-			// No zones have been placed:
-			break;
-		}
+		const EWangTileCoefficient Coefficient = static_cast<EWangTileCoefficient>(CoefficientIndex);
 
-		// There is a tile to the west:
-		if (PlacedZonePositions[PlacedZonesIterator].X ==
-			(CurrentPlacementPosition.X - DEFAULT_TILE_WIDTH))
-		{
-			ZoneChoice = GetZoneConsideringCoefficients(PlacedZonesIterator,
-				ZoneAdjacencyDirection::Westwards);
-		}
+		BalanceReport += FString::Printf(TEXT("%s%s: mean %.4f (%.4f to %.4f, standard deviation %.4f),"
+			" south half %.4f, north half %.4f"), BalanceReport.IsEmpty() ? TEXT("") : TEXT("; "),
+			CoefficientNames[CoefficientIndex], Report.Level.GetMean(Coefficient), Report.Minimums[CoefficientIndex],
+			Report.Maximums[CoefficientIndex], Report.StandardDeviations[CoefficientIndex],
+			Report.SouthHalf.GetMean(Coefficient), Report.NorthHalf.GetMean(Coefficient));
+	}
+}
 
-		// There is a tile to the south:
-		if (PlacedZonePositions[PlacedZonesIterator].Y ==
-			(CurrentPlacementPosition.Y - DEFAULT_TILE_HEIGHT))
-		{
-			ZoneChoice = GetZoneConsideringCoefficients(PlacedZonesIterator,
-				ZoneAdjacencyDirection::Southwards);
-		}
+void UBalancedFPSLevelGeneratorTool::ReportZoneConnectivity(const std::vector<FWangTileDefinition>& ZoneTileSet,
+	const FWangTileGrid& ZoneLayout)
+{
+	FWangTileConnectivity Connectivity(ZoneTileSet);
+	const FWangTileConnectivityReport& Report = Connectivity.Check(ZoneLayout);
 
-		if (ZoneChoice != -1)
-		{
-			// For a Zone that will be placed in a position that is not in a corner, or along an
-			// edge of the level-generation area:
-			LevelZones[ZoneChoice]->DetermineDefensivenessAndFlankingCoefficients(8.0f, 4.0f);
-			PlacedZonePositions.push_back(CurrentPlacementPosition);
-			return GetTargetZone(ZoneChoice);
-		}
+	if (Report.IsConnected())
+	{
+		ConnectivityReport = FString::Printf(TEXT("Connected (%d walkable Zones)"), Report.MainComponentCellCount);
+		return;
 	}
 
-	//if (ZoneChoice == -1)
-	//{
-	//	// Test for now:
-	//	ZoneChoice = GetZoneConsideringCoefficients(0,
-	//			ZoneAdjacencyDirection::Westwards);	
-	//	LevelZones[ZoneChoice]->DetermineDefensivenessAndFlankingCoefficients(8.0f, 4.0f);
-	//	return GetTargetZone(ZoneChoice);
-	//}
+	ConnectivityReport = FString::Printf(TEXT("%d regions: %d Zones cut off from the largest (of %d Zones)"),
+		Report.ComponentCount, static_cast<int>(Report.CutOffCells.size()), Report.MainComponentCellCount);
 
-	// Flow should never reach this point:
+	// The smallest region (the first to be solved again), in Zones from LevelGenerationStartPoint as for the dirty region:
+	const FWangTileRect& SmallestBounds = Report.CutOffBounds.front();
+	const FIntPoint SmallestMin = GetGridCellForZone(FIntPoint(SmallestBounds.MinX, SmallestBounds.MaxY - 1),
+		ZoneLayout.GetHeight());
+	const FIntPoint SmallestMax = GetGridCellForZone(FIntPoint(SmallestBounds.MaxX - 1, SmallestBounds.MinY),
+		ZoneLayout.GetHeight());
 
-	return nullptr;
+	ConnectivityReport += FString::Printf(TEXT("; smallest from (%d, %d) to (%d, %d)"), SmallestMin.X, SmallestMin.Y,
+		SmallestMax.X, SmallestMax.Y);
 }
 
-// The coefficients will be considered here, for the choice of Zone to place:
-int UBalancedFPSLevelGeneratorTool::GetZoneConsideringCoefficients(int ZoneToCompareTo, ZoneAdjacencyDirection PlacedZoneAdjacency)
+// Now zones can be added to it (Wang Tiles):
+void UBalancedFPSLevelGeneratorTool::AddZonesToLevelGenerationArea(const FWangTileGrid& ZoneLayout, const FIntRect& ZoneRegion)
 {
-	// For the Coefficients to consider:
-	float ConsideredZoneDefensivenessCoefficient = PlacedLevelZones[ZoneToCompareTo]->GetDefensivenessCoefficient();
-	float ConsideredZoneFlankingCoefficient = PlacedLevelZones[ZoneToCompareTo]->GetFlankingCoefficient();
-	float ConsideredZoneDispersionCoefficient = PlacedLevelZones[ZoneToCompareTo]->GetDispersonCoefficient();
+	const double ZoneStartTime = FPlatformTime::Seconds();
 
-	// Check through all of the Zones to find a suitable Zone for placement:
-	for (int ZoneIterator = 0; ZoneIterator < LevelZones.Num() - 1;
-		ZoneIterator++)
-	{
-		// Consider dispersion first (of the Zone already placed in the level):
+	// For each Zone to use in initialisation:
+	static AActor* ZoneTile;
 
-		// The placed Zone is WangTile2 or WangTile10:
-		if (ZoneIsWangTile2Or10(ZoneToCompareTo, true))
-		{
-			// Pick based on the adjacency of ZoneToCompareTo against a possible Zone-Index from one
-			// of the pre-defined sets of indicies, for valid tiles that can be placed next to 
-			// WangTile2 or WangTile10:
-			return PickZoneConsideringAdjacencyToWangTile10Or2(ZoneToCompareTo);
-		}
-		else if (ZoneIsWangTile2Or10(ZoneToCompareTo, false))
-		{
-			return PickZoneConsideringAdjacencyToWangTile10Or2(ZoneToCompareTo);
-		}
-		// Considering Defensiveness:
-		else if (PlacedZoneDefensivenessIsGreaterThanOrEqualToOrLessThanOrEqualToThreshold(
-			ZoneToCompareTo, true))
-		{
-			FindApplicableZoneIndicesConsideringDefensiveness(true);
-		}
-		else if (PlacedZoneDefensivenessIsGreaterThanOrEqualToOrLessThanOrEqualToThreshold(
-			ZoneToCompareTo, false))
-		{
-			FindApplicableZoneIndicesConsideringDefensiveness(false);
-		}
-		else
+	// Spawn the Zones that the solver placed:
+	for (int GridY = ZoneRegion.Min.Y; GridY < ZoneRegion.Max.Y; GridY++)
+	{
+		for (int GridX = ZoneRegion.Min.X; GridX < ZoneRegion.Max.X; GridX++)
 		{
-			// Otherwise, find applicable Zone indices based on Dispersion:
-			FindApplicableZoneIndicesConsideringDispersion(ZoneToCompareTo);
+			// Only recorded, if the Zones are packed (see APackedZoneLayout):
+			if (PendingPackedZoneLayout)
+			{
+				PendingPackedZoneLayout->SetWangTileIndex(GridX, GridY, ZoneLayout.GetTileId(GridX, GridY));
+				continue;
+			}
+
+			FTransform LevelZoneTransform = GetZoneTransform(GridX, GridY, ZoneLayout.GetHeight());
+			UBlueprint* ZoneTileBlueprint = LevelZoneTileBlueprints[ZoneLayout.GetTileId(GridX, GridY)];
+
+			{
+				SCOPE_CYCLE_COUNTER(STAT_ZoneSpawn);
+				ZoneTile = UGameplayStatics::BeginSpawningActorFromBlueprint(GEditor->GetEditorWorldContext().World()->GetCurrentLevel(),
+					ZoneTileBlueprint, LevelZoneTransform, false);
+			}
+
+			// Sanity check:
+			if (ZoneTile)
+			{
+				SCOPE_CYCLE_COUNTER(STAT_ZoneConstruction);
+				ZoneTile->ExecuteConstruction(LevelZoneTransform, nullptr, nullptr, true);
+				INC_DWORD_STAT(STAT_ActorsSpawned);
+			}
+
+			// Kept, so that it can be replaced by RegenerateDirtyRegion():
+			if (&ZoneLayout == GeneratedZoneLayout.Get())
+			{
+				GeneratedZoneActors[ZoneLayout.GetIndex(GridX, GridY)] = ZoneTile;
+			}
 		}
-			
-		return GetApplicableZoneIndex(ZoneCollectionToChoose::OtherCollection);
 	}
 
-	// No Zone found:
-	return -1;
+	LastGenerationTimings.ZoneSeconds += FPlatformTime::Seconds() - ZoneStartTime;
 }
 
-UBlueprint* UBalancedFPSLevelGeneratorTool::GetTargetZone(int ZoneChoice)
+bool UBalancedFPSLevelGeneratorTool::BeginSpawningZoneLayout(TSharedPtr<FWangTileGrid, ESPMode::ThreadSafe> ZoneLayout)
 {
-	// Return the Blueprint that represents this Zone:
-	for (int ZoneBlueprintIterator = 0; ZoneBlueprintIterator < LevelZones.Num(); ZoneBlueprintIterator++)
+	// What is spawned for this layout is kept track of, for RegenerateDirtyRegion():
+	GeneratedZoneLayout = ZoneLayout;
+	GeneratedZoneActors.Init(nullptr, ZoneLayout->GetCellCount());
+	GeneratedPanelActors.Init(nullptr, bUseInstancedWallPanels ? 0 : 2 * ZoneLayout->GetCellCount());
+	GeneratedPanelFaces.Empty();
+	GeneratedMergedMeshActors.Empty();
+	GeneratedHLODActors.Empty();
+	GeneratedLevelExtents = LevelExtents;
+	GeneratedStartPoint = LevelGenerationStartPoint;
+	bGeneratedWithInstancedWallPanels = bUseInstancedWallPanels;
+	bGeneratedInStreamingChunks = bGenerateInStreamingChunks;
+	bGeneratedPackedZones = bPackZones;
+
+	PendingZoneLayout = ZoneLayout;
+	PendingZoneRegions.Empty();
+	PendingZoneRegionIndex = 0;
+	PendingZoneCellIndex = 0;
+	bPendingZoneRegionBegun = false;
+
+	if (!bGenerateInStreamingChunks)
+	{
+		PendingZoneRegions.Add(FIntRect(0, 0, ZoneLayout->GetWidth(), ZoneLayout->GetHeight()));
+		return true;
+	}
+
+	// The sub-levels are saved next to the persistent level:
+	UWorld* EditorWorld = GEditor->GetEditorWorldContext().World();
+	if (!FPackageName::DoesPackageExist(EditorWorld->GetOutermost()->GetName()))
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(
+			"The level must be saved, before it can be generated in streaming chunks."));
+		PendingZoneLayout.Reset();
+		GeneratedZoneLayout.Reset();
+		return false;
+	}
+
+	const int ChunkSize = FMath::Max(1, ChunkSizeInTiles);
+
+	for (int ChunkStartY = 0; ChunkStartY < ZoneLayout->GetHeight(); ChunkStartY += ChunkSize)
 	{
-		if (LevelZones[ZoneChoice]->GetName() == LevelZones[ZoneBlueprintIterator]->GetName())
+		for (int ChunkStartX = 0; ChunkStartX < ZoneLayout->GetWidth(); ChunkStartX += ChunkSize)
 		{
-			PlacedLevelZones.Add(LevelZones[ZoneChoice]);
-			return LevelZoneTileBlueprints[ZoneBlueprintIterator];
+			PendingZoneRegions.Add(FIntRect(ChunkStartX, ChunkStartY,
+				FMath::Min(ChunkStartX + ChunkSize, ZoneLayout->GetWidth()),
+				FMath::Min(ChunkStartY + ChunkSize, ZoneLayout->GetHeight())));
 		}
 	}
 
-	return nullptr;
+	return true;
 }
 
-// Helper functions:
-
-bool UBalancedFPSLevelGeneratorTool::ZoneIsEdgePiece(int ConsideredZone)
+bool UBalancedFPSLevelGeneratorTool::SpawnPendingZoneRegions(double SpawnDeadline)
 {
-	return LevelZones[ConsideredZone]->ActorHasTag(LevelZones[ConsideredZone]->WANG_TILE_NINETEEN) ||
-		LevelZones[ConsideredZone]->ActorHasTag(LevelZones[ConsideredZone]->WANG_TILE_TWENTY) ||
-		LevelZones[ConsideredZone]->ActorHasTag(LevelZones[ConsideredZone]->WANG_TILE_TWENTY_ONE) ||
-		LevelZones[ConsideredZone]->ActorHasTag(LevelZones[ConsideredZone]->WANG_TILE_TWENTY_TWO);
-}
+	while (PendingZoneRegionIndex < PendingZoneRegions.Num())
+	{
+		const FIntRect& ZoneRegion = PendingZoneRegions[PendingZoneRegionIndex];
 
-bool UBalancedFPSLevelGeneratorTool::ZoneIsCornerPiece(int ConsideredZone)
-{
-	return LevelZones[ConsideredZone]->ActorHasTag(LevelZones[ConsideredZone]->WANG_TILE_THREE) ||
-		LevelZones[ConsideredZone]->ActorHasTag(LevelZones[ConsideredZone]->WANG_TILE_FOUR) ||
-		LevelZones[ConsideredZone]->ActorHasTag(LevelZones[ConsideredZone]->WANG_TILE_FIVE) ||
-		LevelZones[ConsideredZone]->ActorHasTag(LevelZones[ConsideredZone]->WANG_TILE_SIX);
-}
+		if (!bPendingZoneRegionBegun)
+		{
+			BeginZoneRegion(ZoneRegion);
+			bPendingZoneRegionBegun = true;
+		}
 
-bool UBalancedFPSLevelGeneratorTool::ZoneHasPureEvenZoneDispersion(float ConsideredZoneDispersionCoefficient)
-{
-	return ConsideredZoneDispersionCoefficient == PURE_EVEN_ZONE_DISPERSION;	
-}
+		// One cell at a time, so that spawning can stop part of the way through a region:
+		const int RegionCellCount = ZoneRegion.Area();
 
-bool UBalancedFPSLevelGeneratorTool::ZoneHasHalfEvenZoneDispersion(float ConsideredZoneDispersionCoefficient)
-{
-	return ConsideredZoneDispersionCoefficient == HALF_EVEN_ZONE_DISPERSION;
+		while (PendingZoneCellIndex < RegionCellCount)
+		{
+			if (FPlatformTime::Seconds() >= SpawnDeadline)
+			{
+				return false;
+			}
+
+			FIntRect ZoneCell = FIntRect(ZoneRegion.Min.X + PendingZoneCellIndex % ZoneRegion.Width(),
+				ZoneRegion.Min.Y + PendingZoneCellIndex / ZoneRegion.Width(), 0, 0);
+			ZoneCell.Max = ZoneCell.Min + FIntPoint(1, 1);
+
+			// The instanced panels were added for the whole region, in BeginZoneRegion():
+			if (!bUseInstancedWallPanels)
+			{
+				EncapsulateLevelGenerationArea(ZoneCell, PendingZoneLayout->GetHeight());
+			}
+
+			AddZonesToLevelGenerationArea(*PendingZoneLayout, ZoneCell);
+			PendingZoneCellIndex++;
+			SpawnedZoneCount++;
+		}
+
+		EndZoneRegion(ZoneRegion);
+		bPendingZoneRegionBegun = false;
+		PendingZoneCellIndex = 0;
+		PendingZoneRegionIndex++;
+	}
+
+	PendingZoneLayout.Reset();
+	PendingZoneRegions.Empty();
+
+	return true;
 }
 
-bool UBalancedFPSLevelGeneratorTool::ZoneIsWangTile2Or10(int ConsideredZone, bool CheckingForWangTile2)
+void UBalancedFPSLevelGeneratorTool::BeginZoneRegion(const FIntRect& ZoneRegion)
 {
-	// For any index of LevelZones, to get a constant value to identify WangTile2 or WangTile10:
-	int DefaultLevelZonesIndex = 0;
+	// Everything for a chunk is spawned into its own sub-level:
+	if (bGenerateInStreamingChunks)
+	{
+		UWorld* EditorWorld = GEditor->GetEditorWorldContext().World();
+		const int ChunkSize = FMath::Max(1, ChunkSizeInTiles);
+
+		FString ChunkPackageName = FString::Printf(TEXT("%s_Chunk_%d_%d"), *EditorWorld->GetOutermost()->GetName(),
+			ZoneRegion.Min.X / ChunkSize, ZoneRegion.Min.Y / ChunkSize);
+		PendingZoneRegionLevel = EditorLevelUtils::CreateNewLevel(EditorWorld, false, ULevelStreamingKismet::StaticClass(),
+			FPackageName::LongPackageNameToFilename(ChunkPackageName, FPackageName::GetMapPackageExtension()));
+
+		if (PendingZoneRegionLevel)
+		{
+			EditorLevelUtils::MakeLevelCurrent(PendingZoneRegionLevel);
+		}
+	}
 
-	if (CheckingForWangTile2)
+	if (bUseInstancedWallPanels)
 	{
-		return PlacedLevelZones[ConsideredZone]->ActorHasTag(LevelZones[DefaultLevelZonesIndex]->WANG_TILE_TWO);
+		EncapsulateLevelGenerationArea(ZoneRegion, PendingZoneLayout->GetHeight());
 	}
-	// WangTile10:
-	else
+
+	if (bPackZones)
 	{
-		return PlacedLevelZones[ConsideredZone]->ActorHasTag(LevelZones[DefaultLevelZonesIndex]->WANG_TILE_TEN);
-	}	
+		BeginPackedZoneRegion(ZoneRegion);
+	}
 }
 
-// To find an applicable Zone for this space in the level-generation area:
-void UBalancedFPSLevelGeneratorTool::FindApplicableZoneIndicesConsideringDispersion(int PlacedZoneIndex)
+void UBalancedFPSLevelGeneratorTool::BeginPackedZoneRegion(const FIntRect& ZoneRegion)
 {
-	// Choose a Zone with a lower value than this piece's Dispersion
-	// Coefficient:
-	for (int ZoneIterator = 0; ZoneIterator < LevelZones.Num() - 1;
-		ZoneIterator++)
+	UWorld* EditorWorld = GEditor->GetEditorWorldContext().World();
+	FActorSpawnParameters PackedSpawnParameters;
+	PackedSpawnParameters.OverrideLevel = EditorWorld->GetCurrentLevel();
+
+	PendingPackedZoneLayout = EditorWorld->SpawnActor<APackedZoneLayout>(APackedZoneLayout::StaticClass(),
+		FTransform::Identity, PackedSpawnParameters);
+
+	// Sanity check:
+	if (!PendingPackedZoneLayout)
 	{
-		if (LevelZones[ZoneIterator]->GetDispersonCoefficient() <
-			PlacedLevelZones[PlacedZoneIndex]->GetDispersonCoefficient())
-		{
-			ApplicableZoneIndices.push_back(ZoneIterator);
-		}
+		return;
+	}
+
+	PendingPackedZoneLayout->SetActorLabel(FString::Printf(TEXT("PackedZones_%d_%d"), ZoneRegion.Min.X, ZoneRegion.Min.Y));
+	INC_DWORD_STAT(STAT_ActorsSpawned);
+
+	TArray<TSubclassOf<AZone>> ZoneClasses;
+	for (UBlueprint* ZoneTileBlueprint : LevelZoneTileBlueprints)
+	{
+		ZoneClasses.Add(ZoneTileBlueprint ? ZoneTileBlueprint->GeneratedClass : nullptr);
 	}
+
+	// Each cell is a tile further east, and a tile further south (see GetZoneTransform()):
+	const int GridHeight = PendingZoneLayout->GetHeight();
+	PendingPackedZoneLayout->InitialiseRegion(ZoneRegion, ZoneClasses, GetZoneTransform(0, 0, GridHeight).GetLocation(),
+		FVector2D(DEFAULT_TILE_WIDTH, -DEFAULT_TILE_HEIGHT), DEFAULT_ZONE_SCALE);
 }
 
-int UBalancedFPSLevelGeneratorTool::GetApplicableZoneIndex(ZoneCollectionToChoose CollectionToConsider)
+void UBalancedFPSLevelGeneratorTool::EndZoneRegion(const FIntRect& ZoneRegion)
 {
-	// To Pick from the index-subset on a random basis:
-	std::default_random_engine RNG;
-	std::uniform_int_distribution<int> RandomDistribution;
-	RNG.seed(time(NULL));
+	// Into the chunk's sub-level (if generating in chunks), before it is saved:
+	if (PendingPackedZoneLayout)
+	{
+		PendingPackedZoneLayout->RealiseZoneMeshes();
+		PendingPackedZoneLayout = nullptr;
+	}
 
-	// Make a call to 'flush' the stream before using it, as well as seeding it:
-	RandomDistribution(RNG);
+	MergeGeneratedZoneMeshes(ZoneRegion);
 
-	// Pick from the respective collection (depending on which adjacent Zone is being considered):
-	switch (CollectionToConsider)
+	if (!PendingZoneRegionLevel)
 	{
-	case ZoneCollectionToChoose::WangTile2Collection:
-		RandomDistribution = std::uniform_int_distribution<int>(0,
-			ApplicableZoneIndicesForWangTile2.size() - 1);
-		return ApplicableZoneIndicesForWangTile2[RandomDistribution(RNG)];
-		break;
-
-	case ZoneCollectionToChoose::Wangtile10Collection:
-		RandomDistribution = std::uniform_int_distribution<int>(0,
-			ApplicableZoneIndicesForWangTile10.size() - 1);
-		return ApplicableZoneIndicesForWangTile10[RandomDistribution(RNG)];
-		break;
-	
-	// For the ApplicableZoneIndices collection:
-	case ZoneCollectionToChoose::OtherCollection:
-		RandomDistribution = std::uniform_int_distribution<int>(0,
-			ApplicableZoneIndices.size() - 1);
-		// APPLICABLE ZONES INDICES SOMETIMES HAS NO ITEMS, RESOLVE THIS!
-		return ApplicableZoneIndices[RandomDistribution(RNG)];
-		break;
+		return;
 	}
-	
-	return 0;
+
+	FEditorFileUtils::SaveLevel(PendingZoneRegionLevel);
+	AddStreamingVolumeForChunk(PendingZoneRegionLevel, GetZoneRegionBounds(ZoneRegion, PendingZoneLayout->GetHeight()));
+
+	UWorld* EditorWorld = GEditor->GetEditorWorldContext().World();
+	EditorLevelUtils::MakeLevelCurrent(EditorWorld->PersistentLevel);
+	EditorWorld->PersistentLevel->MarkPackageDirty();
+	PendingZoneRegionLevel = nullptr;
 }
 
-int UBalancedFPSLevelGeneratorTool::PickZoneConsideringAdjacencyToWangTile10Or2(int ConsideredAdjacentZoneID)
+void UBalancedFPSLevelGeneratorTool::BeginAsynchronousGeneration()
 {
-	if (ConsideredAdjacentZoneID == 2)
+	std::vector<FWangTileDefinition> ZoneTileSet;
+	FWangTileSolverSettings SolverSettings;
+	if (!PrepareZoneSolve(ZoneTileSet, SolverSettings))
 	{
-		return GetApplicableZoneIndex(ZoneCollectionToChoose::WangTile2Collection);
+		return;
 	}
-	// For WangTile10:
-	else
+
+	SpawnedZoneCount = 0;
+	PendingGenerationCancelled = MakeShareable(new std::atomic<bool>(false));
+	SolverSettings.CancellationFlag = PendingGenerationCancelled.Get();
+
+	// The solver only works on its own copies of the tile-set and settings, and the shared layout
+	// (the cancellation flag is captured so that it outlives the solve):
+	TSharedPtr<FWangTileGrid, ESPMode::ThreadSafe> ZoneLayout = MakeShareable(new FWangTileGrid());
+	TSharedPtr<FWangTileCandidateReport, ESPMode::ThreadSafe> CandidateReport = MakeShareable(new FWangTileCandidateReport());
+	TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe> GenerationCancelled = PendingGenerationCancelled;
+	const int32 CandidateCount = CandidateLayoutCount;
+	PendingZoneLayout = ZoneLayout;
+	PendingCandidateReport = CandidateReport;
+
+	PendingZoneSolve = Async<bool>(EAsyncExecution::ThreadPool,
+		[ZoneTileSet, SolverSettings, CandidateCount, ZoneLayout, CandidateReport, GenerationCancelled]()
+		{
+			return RunZoneSolver(ZoneTileSet, SolverSettings, CandidateCount, *ZoneLayout, *CandidateReport);
+		});
+
+	BeginGenerationTicker(FText::FromString("Generating level: placing Zones..."));
+}
+
+void UBalancedFPSLevelGeneratorTool::BeginGenerationTicker(const FText& ProgressText)
+{
+	// Show the progress, with a button to cancel the generation:
+	FNotificationInfo GenerationInfo(ProgressText);
+	GenerationInfo.bFireAndForget = false;
+	GenerationInfo.ExpireDuration = 0.0f;
+	GenerationInfo.ButtonDetails.Add(FNotificationButtonInfo(FText::FromString("Cancel"),
+		FText::FromString("Stop generating (anything already spawned is kept)."),
+		FSimpleDelegate::CreateUObject(this, &UBalancedFPSLevelGeneratorTool::CancelAsynchronousGeneration),
+		SNotificationItem::CS_Pending));
+
+	GenerationNotification = FSlateNotificationManager::Get().AddNotification(GenerationInfo);
+	if (GenerationNotification.IsValid())
 	{
-		return GetApplicableZoneIndex(ZoneCollectionToChoose::Wangtile10Collection);
+		GenerationNotification->SetCompletionState(SNotificationItem::CS_Pending);
 	}
 
-	return 0;
+	GenerationTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this,
+		&UBalancedFPSLevelGeneratorTool::TickAsynchronousGeneration));
 }
 
-void UBalancedFPSLevelGeneratorTool::FindApplicableZoneIndicesConsideringDefensiveness(bool IsGreaterThanThreshold)
+bool UBalancedFPSLevelGeneratorTool::TickAsynchronousGeneration(float DeltaTime)
 {
-	// Choose a Zone with a lower or greater value than the considered piece's
-	// Defensiveness Coefficient:
-	for (int ZoneIterator = 0; ZoneIterator < LevelZones.Num() - 1;
-		ZoneIterator++)
+	if (PendingGenerationCancelled->load())
 	{
-		// If the considered piece's Defensiveness is greater than or equal to the
-		// threshold, find a piece with a Defensiveness less than or equal to the
-		// threshold and vice versa:
-		if (IsGreaterThanThreshold)
+		EndAsynchronousGeneration(false, FText::FromString("Level generation cancelled."));
+		return false;
+	}
+
+	// Still placing the Zones (off the game thread):
+	if (PendingZoneSolve.IsValid())
+	{
+		if (!PendingZoneSolve.IsReady())
 		{
-			if (ZoneSubsetDefensivenessIsGreaterThanOrEqualToOrLessThanOrEqualToThreshold(
-				ZoneIterator, false))
-			{
-				ApplicableZoneIndices.push_back(ZoneIterator);
-			}
+			return true;
+		}
 
+		bool ZoneLayoutSolved = PendingZoneSolve.Get();
+		PendingZoneSolve = TFuture<bool>();
+
+		if (!ZoneLayoutSolved)
+		{
+			EndAsynchronousGeneration(false, FText::FromString("No Zone layout could be made."));
+			return false;
 		}
-		// Less than or equal to the threshold:
-		else
+
+		ReportZoneLayout(*PendingZoneLayout, *PendingCandidateReport);
+		AddLightSourceToLevelGenerationArea();
+
+		if (!BeginSpawningZoneLayout(PendingZoneLayout))
 		{
-			if (ZoneSubsetDefensivenessIsGreaterThanOrEqualToOrLessThanOrEqualToThreshold(
-				ZoneIterator, true))
-			{
-				ApplicableZoneIndices.push_back(ZoneIterator);
-			}
+			EndAsynchronousGeneration(false, FText::FromString("Level generation failed."));
+			return false;
 		}
 	}
-}
 
-// Boolean conditional checks:
+	// Spawn as much as the budget allows, this tick:
+	const int TotalZoneCount = PendingZoneLayout->GetCellCount();
+	if (SpawnPendingZoneRegions(FPlatformTime::Seconds() + SpawnBudgetMilliseconds / 1000.0))
+	{
+		EndAsynchronousGeneration(true, FText::FromString(FString::Printf(TEXT("Level generated (%d Zones)."),
+			TotalZoneCount)));
+		return false;
+	}
 
-bool UBalancedFPSLevelGeneratorTool::PlacedZoneDefensivenessIsGreaterThanOrEqualToOrLessThanOrEqualToThreshold(int ZoneIndexToCheckAgainstThreshold, bool IsGreaterThanOrEqualToCheck)
-{
-	if (IsGreaterThanOrEqualToCheck)
+	if (GenerationNotification.IsValid())
 	{
-		return PlacedLevelZones[ZoneIndexToCheckAgainstThreshold]->GetDefensivenessCoefficient() >=
-			ZONE_DEFENSIVENESS_COEFFICIENT_THRESHOLD;
+		GenerationNotification->SetText(FText::FromString(FString::Printf(TEXT("Generating level: spawned %d of %d Zones..."),
+			SpawnedZoneCount, TotalZoneCount)));
 	}
-	// Less than or equal to check:
-	else
+
+	return true;
+}
+
+void UBalancedFPSLevelGeneratorTool::CancelAsynchronousGeneration()
+{
+	if (PendingGenerationCancelled.IsValid())
 	{
-		return PlacedLevelZones[ZoneIndexToCheckAgainstThreshold]->GetDefensivenessCoefficient() <=
-			ZONE_DEFENSIVENESS_COEFFICIENT_THRESHOLD;
+		PendingGenerationCancelled->store(true);
 	}
-	
-	return false;
 }
 
-bool UBalancedFPSLevelGeneratorTool::ZoneSubsetDefensivenessIsGreaterThanOrEqualToOrLessThanOrEqualToThreshold(int ZoneIndexToCheckAgainstThreshold, bool IsGreaterThanOrEqualToCheck)
+void UBalancedFPSLevelGeneratorTool::EndAsynchronousGeneration(bool bSucceeded, const FText& ResultText)
 {
-	if (IsGreaterThanOrEqualToCheck)
+	FTicker::GetCoreTicker().RemoveTicker(GenerationTickerHandle);
+	GenerationTickerHandle.Reset();
+
+	// Leave a partly-spawned chunk saved, and the persistent level current:
+	if (bPendingZoneRegionBegun && PendingZoneRegions.IsValidIndex(PendingZoneRegionIndex))
 	{
-		return LevelZones[ZoneIndexToCheckAgainstThreshold]->GetDefensivenessCoefficient() >=
-			ZONE_DEFENSIVENESS_COEFFICIENT_THRESHOLD;
+		EndZoneRegion(PendingZoneRegions[PendingZoneRegionIndex]);
+		bPendingZoneRegionBegun = false;
 	}
-	// Less than or equal to check:
-	else
+
+	// Only a complete layout can be regenerated in part:
+	if (!bSucceeded)
+	{
+		GeneratedZoneLayout.Reset();
+	}
+
+	PendingZoneLayout.Reset();
+	PendingZoneRegions.Empty();
+	PendingZoneSolve = TFuture<bool>();
+	PendingCandidateReport.Reset();
+	PendingGenerationCancelled.Reset();
+
+	if (GenerationNotification.IsValid())
 	{
-		return LevelZones[ZoneIndexToCheckAgainstThreshold]->GetDefensivenessCoefficient() <=
-			ZONE_DEFENSIVENESS_COEFFICIENT_THRESHOLD;
+		GenerationNotification->SetText(ResultText);
+		GenerationNotification->SetCompletionState(bSucceeded ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+		GenerationNotification->ExpireAndFadeout();
+		GenerationNotification.Reset();
 	}
-	
-	return false;
+}
+
+bool UBalancedFPSLevelGeneratorTool::IsGenerating() const
+{
+	return GenerationTickerHandle.IsValid();
+}
+
+void UBalancedFPSLevelGeneratorTool::BeginDestroy()
+{
+	// The tool's window was closed part of the way through a generation:
+	if (IsGenerating())
+	{
+		CancelAsynchronousGeneration();
+		EndAsynchronousGeneration(false, FText::FromString("Level generation cancelled."));
+	}
+
+	// Stop listening for the Zone Blueprints being recompiled:
+	for (TWeakObjectPtr<UBlueprint>& ProfiledZoneBlueprint : ProfiledZoneBlueprints)
+	{
+		if (ProfiledZoneBlueprint.IsValid())
+		{
+			ProfiledZoneBlueprint->OnCompiled().RemoveAll(this);
+		}
+	}
+
+	ProfiledZoneBlueprints.Empty();
+
+	Super::BeginDestroy();
+}
+
+void UBalancedFPSLevelGeneratorTool::RegenerateDirtyRegion()
+{
+	if (IsGenerating())
+	{
+		return;
+	}
+
+	// Sanity check:
+	if (!GeneratedZoneLayout.IsValid() || bGeneratedInStreamingChunks || bGeneratedPackedZones)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(
+			"Only a level generated with this tool (since it was opened), and neither in streaming chunks"
+			" nor with packed Zones, can be regenerated in part."));
+		return;
+	}
+
+	std::vector<FWangTileDefinition> ZoneTileSet;
+	FWangTileSolverSettings SolverSettings;
+	if (!PrepareZoneSolve(ZoneTileSet, SolverSettings))
+	{
+		return;
+	}
+
+	LastGenerationTimings = FLevelGenerationTimings();
+	SET_DWORD_STAT(STAT_ActorsSpawned, 0);
+
+	// The merged meshes are merged again afterwards (with the Zones as they are then):
+	UnmergeGeneratedZoneMeshes();
+
+	// Follow any change to the level-generation area first (the cells that are cleared are refilled)...
+	std::vector<FWangTileRect> RefillRects;
+	const bool IsAreaChanged = ResizeGeneratedZoneLayout(FIntPoint(SolverSettings.GridWidth, SolverSettings.GridHeight),
+		RefillRects);
+	FWangTileGrid& ZoneLayout = *GeneratedZoneLayout;
+
+	// ...then solve the dirty region again, keeping the pinned Zones:
+	TArray<int32> PinnedCells;
+	for (const FIntPoint& PinnedZone : PinnedZones)
+	{
+		FIntPoint PinnedCell = GetGridCellForZone(PinnedZone, ZoneLayout.GetHeight());
+		if (ZoneLayout.IsValid(PinnedCell.X, PinnedCell.Y))
+		{
+			PinnedCells.Add(ZoneLayout.GetIndex(PinnedCell.X, PinnedCell.Y));
+			ZoneLayout[PinnedCells.Last()].SetPinned(true);
+		}
+	}
+
+	// The dirty region's rows are counted from LevelGenerationStartPoint, so its corners swap over in the grid:
+	const FIntPoint DirtyCellMin = GetGridCellForZone(FIntPoint(DirtyRegionMin.X, DirtyRegionMax.Y), ZoneLayout.GetHeight());
+	const FIntPoint DirtyCellMax = GetGridCellForZone(FIntPoint(DirtyRegionMax.X, DirtyRegionMin.Y), ZoneLayout.GetHeight());
+	const FWangTileRect RerollRect(DirtyCellMin.X, DirtyCellMin.Y, DirtyCellMax.X + 1, DirtyCellMax.Y + 1);
+
+	// A different reroll each time, so that the same dirty region can be regenerated until it suits:
+	RegenerationCount++;
+	const uint64 RerollSeed = FWangTileRandomStream::DeriveSeed(SolverSettings.Seed, RegenerationCount);
+
+	const double SolveStartTime = FPlatformTime::Seconds();
+
+	FWangTileSolver ZoneSolver(ZoneTileSet);
+	std::vector<int> ChangedCells;
+	bool ZoneLayoutResolved = ZoneSolver.Resolve(SolverSettings, ZoneLayout, RerollRect, RefillRects, RerollSeed,
+		ChangedCells);
+
+	LastGenerationTimings.SolveSeconds += FPlatformTime::Seconds() - SolveStartTime;
+
+	for (int32 PinnedCell : PinnedCells)
+	{
+		ZoneLayout[PinnedCell].SetPinned(false);
+	}
+
+	if (!ZoneLayoutResolved)
+	{
+		MergeGeneratedZoneMeshes(FIntRect(0, 0, ZoneLayout.GetWidth(), ZoneLayout.GetHeight()));
+		return;
+	}
+
+	// Move what was kept, if the area moved or changed size...
+	if (IsAreaChanged)
+	{
+		MoveGeneratedActors();
+	}
+
+	// ...then respawn only the Zones whose tile changed:
+	for (int ChangedCell : ChangedCells)
+	{
+		DestroyGeneratedActor(GeneratedZoneActors[ChangedCell]);
+		AddZonesToLevelGenerationArea(ZoneLayout, FIntRect(ZoneLayout.GetX(ChangedCell), ZoneLayout.GetY(ChangedCell),
+			ZoneLayout.GetX(ChangedCell) + 1, ZoneLayout.GetY(ChangedCell) + 1));
+	}
+
+	MergeGeneratedZoneMeshes(FIntRect(0, 0, ZoneLayout.GetWidth(), ZoneLayout.GetHeight()));
+	ReportZoneLayout(ZoneLayout, FWangTileCandidateReport());
+}
+
+void UBalancedFPSLevelGeneratorTool::PinSelectedZones()
+{
+	// Sanity check:
+	if (!GeneratedZoneLayout.IsValid())
+	{
+		return;
+	}
+
+	for (FSelectionIterator SelectedActor(GEditor->GetSelectedActorIterator()); SelectedActor; ++SelectedActor)
+	{
+		int32 CellIndex = GeneratedZoneActors.IndexOfByPredicate([&SelectedActor](const TWeakObjectPtr<AActor>& ZoneActor)
+		{
+			return ZoneActor.Get() == *SelectedActor;
+		});
+
+		if (CellIndex != INDEX_NONE)
+		{
+			// The same cell, counted from LevelGenerationStartPoint (see GetGridCellForZone()):
+			PinnedZones.AddUnique(FIntPoint(GeneratedZoneLayout->GetX(CellIndex),
+				GeneratedZoneLayout->GetHeight() - 1 - GeneratedZoneLayout->GetY(CellIndex)));
+		}
+	}
+}
+
+void UBalancedFPSLevelGeneratorTool::SaveLayout()
+{
+	// Sanity check:
+	if (IsGenerating() || !GeneratedZoneLayout.IsValid())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(
+			"Only a level generated with this tool (since it was opened) can be saved as a layout."));
+		return;
+	}
+
+	std::vector<FWangTileDefinition> ZoneTileSet;
+	if (!GatherZoneTileSet(ZoneTileSet))
+	{
+		return;
+	}
+
+	FWangTileLayoutHeader LayoutHeader;
+	LayoutHeader.Seed = static_cast<uint32>(Seed);
+	LayoutHeader.ExtentX = GeneratedLevelExtents.X;
+	LayoutHeader.ExtentY = GeneratedLevelExtents.Y;
+	LayoutHeader.TileSetHash = FWangTileLayoutFile::ComputeTileSetHash(ZoneTileSet);
+
+	if (!FZoneLayoutFile::SaveLayout(LayoutFilePath.FilePath, *GeneratedZoneLayout, LayoutHeader))
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Printf(
+			TEXT("The layout could not be saved to %s."), *LayoutFilePath.FilePath)));
+	}
+}
+
+void UBalancedFPSLevelGeneratorTool::LoadLayout()
+{
+	if (IsGenerating())
+	{
+		return;
+	}
+
+	std::vector<FWangTileDefinition> ZoneTileSet;
+	FWangTileSolverSettings SolverSettings;
+	if (!PrepareZoneSolve(ZoneTileSet, SolverSettings))
+	{
+		return;
+	}
+
+	const FString LayoutFilename = LayoutFilePath.FilePath;
+	FWangTileLayoutHeader LayoutHeader;
+	if (!FZoneLayoutFile::LoadLayoutHeader(LayoutFilename, LayoutHeader))
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Printf(
+			TEXT("%s is not a layout file (see SaveLayout)."), *LayoutFilename)));
+		return;
+	}
+
+	// A layout is only the indices of its Zones, so they must still be the same Zones:
+	if (LayoutHeader.TileSetHash != FWangTileLayoutFile::ComputeTileSetHash(ZoneTileSet))
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Printf(
+			TEXT("%s was saved with different Zone Blueprints (its Seed, %u, can be generated instead)."),
+			*LayoutFilename, LayoutHeader.Seed)));
+		return;
+	}
+
+	// The tool generates one floor (an arena of several is generated by AZoneArenaGenerator):
+	if (LayoutHeader.Depth > 1)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Printf(
+			TEXT("%s has %d floors (it can be loaded by a Zone Arena Generator instead)."),
+			*LayoutFilename, LayoutHeader.Depth)));
+		return;
+	}
+
+	Seed = static_cast<int32>(LayoutHeader.Seed);
+	LevelExtents = FVector2D(LayoutHeader.ExtentX, LayoutHeader.ExtentY);
+
+	LastGenerationTimings = FLevelGenerationTimings();
+	SET_DWORD_STAT(STAT_ActorsSpawned, 0);
+
+	TSharedPtr<FWangTileGrid, ESPMode::ThreadSafe> ZoneLayout = MakeShareable(new FWangTileGrid());
+
+	// Every cell is looked up in LevelZoneTileBlueprints, so any outside it are rejected as the file is read:
+	const int32 ZoneCount = LevelZoneTileBlueprints.Num();
+
+	// Read off the game thread (in place of the solve), then spawned over several ticks:
+	if (bGenerateAsynchronously)
+	{
+		SpawnedZoneCount = 0;
+		PendingGenerationCancelled = MakeShareable(new std::atomic<bool>(false));
+		PendingZoneLayout = ZoneLayout;
+		PendingCandidateReport = MakeShareable(new FWangTileCandidateReport());
+
+		PendingZoneSolve = Async<bool>(EAsyncExecution::ThreadPool,
+			[LayoutFilename, ZoneCount, ZoneLayout]()
+			{
+				FWangTileLayoutHeader LoadedHeader;
+				return FZoneLayoutFile::LoadLayout(LayoutFilename, ZoneCount, LoadedHeader, *ZoneLayout);
+			});
+
+		BeginGenerationTicker(FText::FromString("Loading level: reading Zones..."));
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_GenerateLevel);
+
+	if (!FZoneLayoutFile::LoadLayout(LayoutFilename, ZoneCount, LayoutHeader, *ZoneLayout))
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Printf(
+			TEXT("%s is cut short, does not match its checksum, or has a cell without a Zone."), *LayoutFilename)));
+		return;
+	}
+
+	ReportZoneLayout(*ZoneLayout, FWangTileCandidateReport());
+	AddLightSourceToLevelGenerationArea();
+
+	if (BeginSpawningZoneLayout(ZoneLayout))
+	{
+		SpawnPendingZoneRegions(TNumericLimits<double>::Max());
+	}
+}
+
+void UBalancedFPSLevelGeneratorTool::QueryRegionBalance()
+{
+	// Sanity check:
+	if (IsGenerating() || !GeneratedZoneLayout.IsValid() || GeneratedBalanceMap.IsEmpty())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(
+			"Only a level generated with this tool (since it was opened) can be queried for its balance."));
+		return;
+	}
+
+	// The query's rows are counted from LevelGenerationStartPoint, so its corners swap over in the grid:
+	const int GridHeight = GeneratedBalanceMap.GetHeight();
+	const FIntPoint QueryCellMin = GetGridCellForZone(FIntPoint(BalanceQueryMin.X, BalanceQueryMax.Y), GridHeight);
+	const FIntPoint QueryCellMax = GetGridCellForZone(FIntPoint(BalanceQueryMax.X, BalanceQueryMin.Y), GridHeight);
+
+	const FWangTileRegionBalance RegionBalance = GeneratedBalanceMap.GetRegionBalance(
+		FWangTileRect(QueryCellMin.X, QueryCellMin.Y, QueryCellMax.X + 1, QueryCellMax.Y + 1));
+
+	if (RegionBalance.CellCount == 0)
+	{
+		BalanceQueryResult = TEXT("No Zones are in the region.");
+		return;
+	}
+
+	BalanceQueryResult = FString::Printf(TEXT("%d Zones: Defensiveness %.4f, Flanking %.4f, Dispersion %.4f (mean)"),
+		RegionBalance.CellCount, RegionBalance.GetMean(EWangTileCoefficient::Defensiveness),
+		RegionBalance.GetMean(EWangTileCoefficient::Flanking), RegionBalance.GetMean(EWangTileCoefficient::Dispersion));
+}
+
+bool UBalancedFPSLevelGeneratorTool::ResizeGeneratedZoneLayout(const FIntPoint& GridSize,
+	std::vector<FWangTileRect>& OutRefillRects)
+{
+	FWangTileGrid& ZoneLayout = *GeneratedZoneLayout;
+	OutRefillRects.clear();
+
+	if (GridSize == FIntPoint(ZoneLayout.GetWidth(), ZoneLayout.GetHeight()) && LevelExtents == GeneratedLevelExtents &&
+		LevelGenerationStartPoint == GeneratedStartPoint)
+	{
+		return false;
+	}
+
+	// Keep the Zones where they are in the world (the grid's first row is the furthest from the start point):
+	const int OffsetX = FMath::RoundToInt((GeneratedStartPoint.X - LevelGenerationStartPoint.X) / DEFAULT_TILE_WIDTH);
+	const int OffsetY = FMath::RoundToInt(((LevelGenerationStartPoint.Y + LevelExtents.Y) -
+		(GeneratedStartPoint.Y + GeneratedLevelExtents.Y)) / DEFAULT_TILE_HEIGHT);
+	const int PreviousWidth = ZoneLayout.GetWidth();
+
+	ZoneLayout.Resize(GridSize.X, GridSize.Y, OffsetX, OffsetY, OutRefillRects);
+
+	// The actors move with their cells (and are destroyed with the cells that were cleared, or are now outside):
+	TArray<TWeakObjectPtr<AActor>> PreviousZoneActors = MoveTemp(GeneratedZoneActors);
+	TArray<TWeakObjectPtr<AActor>> PreviousPanelActors = MoveTemp(GeneratedPanelActors);
+	GeneratedZoneActors.Init(nullptr, ZoneLayout.GetCellCount());
+	GeneratedPanelActors.Init(nullptr, bGeneratedWithInstancedWallPanels ? 0 : 2 * ZoneLayout.GetCellCount());
+
+	for (int PreviousIndex = 0; PreviousIndex < PreviousZoneActors.Num(); PreviousIndex++)
+	{
+		const int GridX = PreviousIndex % PreviousWidth + OffsetX;
+		const int GridY = PreviousIndex / PreviousWidth + OffsetY;
+		const int CellIndex = ZoneLayout.IsValid(GridX, GridY) ? ZoneLayout.GetIndex(GridX, GridY) : INDEX_NONE;
+
+		// A cleared cell's Zone is respawned, once the cell is refilled:
+		if (CellIndex != INDEX_NONE && ZoneLayout[CellIndex].HasTile())
+		{
+			GeneratedZoneActors[CellIndex] = PreviousZoneActors[PreviousIndex];
+		}
+		else
+		{
+			DestroyGeneratedActor(PreviousZoneActors[PreviousIndex]);
+		}
+
+		// The panels stay wherever their cell is still within the area:
+		for (int PanelOffset = 0; PreviousPanelActors.Num() > 0 && PanelOffset < 2; PanelOffset++)
+		{
+			if (CellIndex != INDEX_NONE)
+			{
+				GeneratedPanelActors[2 * CellIndex + PanelOffset] = PreviousPanelActors[2 * PreviousIndex + PanelOffset];
+			}
+			else
+			{
+				DestroyGeneratedActor(PreviousPanelActors[2 * PreviousIndex + PanelOffset]);
+			}
+		}
+	}
+
+	GeneratedLevelExtents = LevelExtents;
+	GeneratedStartPoint = LevelGenerationStartPoint;
+
+	return true;
+}
+
+void UBalancedFPSLevelGeneratorTool::MoveGeneratedActors()
+{
+	const FWangTileGrid& ZoneLayout = *GeneratedZoneLayout;
+
+	for (int CellIndex = 0; CellIndex < ZoneLayout.GetCellCount(); CellIndex++)
+	{
+		const int GridX = ZoneLayout.GetX(CellIndex);
+		const int GridY = ZoneLayout.GetY(CellIndex);
+
+		if (AActor* ZoneActor = GeneratedZoneActors[CellIndex].Get())
+		{
+			ZoneActor->SetActorLocation(GetZoneTransform(GridX, GridY, ZoneLayout.GetHeight()).GetLocation());
+		}
+
+		if (bGeneratedWithInstancedWallPanels)
+		{
+			continue;
+		}
+
+		// Spawn the panels of the cells that are new to the area, and move the others:
+		AActor* BottomPanel = GeneratedPanelActors[2 * CellIndex].Get();
+		AActor* TopPanel = GeneratedPanelActors[2 * CellIndex + 1].Get();
+
+		if (!BottomPanel || !TopPanel)
+		{
+			DestroyGeneratedActor(GeneratedPanelActors[2 * CellIndex]);
+			DestroyGeneratedActor(GeneratedPanelActors[2 * CellIndex + 1]);
+			EncapsulateLevelGenerationArea(FIntRect(GridX, GridY, GridX + 1, GridY + 1), ZoneLayout.GetHeight());
+			continue;
+		}
+
+		FVector PanelTilePosition = GetPanelTilePosition(GridX, GridY, ZoneLayout.GetHeight());
+		BottomPanel->SetActorTransform(GetTopOrBottomWallPanelTransform(PanelTilePosition, false));
+		TopPanel->SetActorTransform(GetTopOrBottomWallPanelTransform(PanelTilePosition, true));
+	}
+
+	// The instanced faces are rebuilt for the whole area:
+	if (bGeneratedWithInstancedWallPanels)
+	{
+		for (TWeakObjectPtr<AActor>& PanelFace : GeneratedPanelFaces)
+		{
+			DestroyGeneratedActor(PanelFace);
+		}
+
+		GeneratedPanelFaces.Empty();
+		EncapsulateLevelGenerationArea(FIntRect(0, 0, ZoneLayout.GetWidth(), ZoneLayout.GetHeight()), ZoneLayout.GetHeight());
+	}
+
+	if (AActor* LightSource = GeneratedLightSource.Get())
+	{
+		LightSource->SetActorTransform(GetLightSourceTransform());
+	}
+}
+
+void UBalancedFPSLevelGeneratorTool::MergeGeneratedZoneMeshes(const FIntRect& ZoneRegion)
+{
+	// Sanity check:
+	if ((!bMergeZoneMeshes && !bBuildHLODClusters) || !GeneratedZoneLayout.IsValid())
+	{
+		return;
+	}
+
+	// Without HLOD clusters, the region is merged as one...
+	TArray<FIntRect> ClusterRegions;
+	if (!bBuildHLODClusters)
+	{
+		ClusterRegions.Add(ZoneRegion);
+	}
+	else
+	{
+		// ...otherwise, each cluster is aligned to the grid (rather than to the region), so that regenerating
+		// or chunking the level doesn't move the boundaries between clusters:
+		const int ClusterSize = FMath::Max(1, HLODClusterSizeInTiles);
+
+		for (int ClusterStartY = ZoneRegion.Min.Y - ZoneRegion.Min.Y % ClusterSize; ClusterStartY < ZoneRegion.Max.Y;
+			ClusterStartY += ClusterSize)
+		{
+			for (int ClusterStartX = ZoneRegion.Min.X - ZoneRegion.Min.X % ClusterSize; ClusterStartX < ZoneRegion.Max.X;
+				ClusterStartX += ClusterSize)
+			{
+				ClusterRegions.Add(FIntRect(FMath::Max(ClusterStartX, ZoneRegion.Min.X), FMath::Max(ClusterStartY, ZoneRegion.Min.Y),
+					FMath::Min(ClusterStartX + ClusterSize, ZoneRegion.Max.X), FMath::Min(ClusterStartY + ClusterSize, ZoneRegion.Max.Y)));
+			}
+		}
+	}
+
+	ULevel* CurrentLevel = GEditor->GetEditorWorldContext().World()->GetCurrentLevel();
+	TArray<AZone*> ClusterZones;
+
+	// The world's HLOD setup is only looked at (and changed, if need be) once for all of the clusters:
+	const int32 ClusterLODLevel = bBuildHLODClusters ? PrepareHLODClusterLevel() : INDEX_NONE;
+
+	for (const FIntRect& ClusterRegion : ClusterRegions)
+	{
+		ClusterZones.Reset(ClusterRegion.Area());
+
+		for (int GridY = ClusterRegion.Min.Y; GridY < ClusterRegion.Max.Y; GridY++)
+		{
+			for (int GridX = ClusterRegion.Min.X; GridX < ClusterRegion.Max.X; GridX++)
+			{
+				if (AZone* ClusterZone = Cast<AZone>(GeneratedZoneActors[GeneratedZoneLayout->GetIndex(GridX, GridY)].Get()))
+				{
+					ClusterZones.Add(ClusterZone);
+				}
+			}
+		}
+
+		if (ClusterZones.Num() == 0)
+		{
+			continue;
+		}
+
+		// The proxy mesh is built from the Zones' own meshes (before merging hides them):
+		ALODActor* ClusterActor = ClusterLODLevel != INDEX_NONE ? BuildHLODCluster(ClusterZones, ClusterRegion,
+			ClusterLODLevel) : nullptr;
+
+		if (!bMergeZoneMeshes)
+		{
+			continue;
+		}
+
+		TArray<AInstancedStaticMeshActor*> MergedActors;
+		FZoneMeshMerge::MergeZoneMeshes(CurrentLevel, ClusterZones, MergedActors);
+
+		for (AInstancedStaticMeshActor* MergedActor : MergedActors)
+		{
+			// The instances are hidden while the proxy mesh is drawn, as are the Zones (without being part of it):
+			if (ClusterActor)
+			{
+				MergedActor->GetInstancedStaticMeshComponent()->SetLODParentPrimitive(ClusterActor->GetStaticMeshComponent());
+			}
+
+			GeneratedMergedMeshActors.Add(MergedActor);
+			INC_DWORD_STAT(STAT_ActorsSpawned);
+		}
+	}
+}
+
+int32 UBalancedFPSLevelGeneratorTool::PrepareHLODClusterLevel()
+{
+	AWorldSettings* WorldSettings = GEditor->GetEditorWorldContext().World()->GetWorldSettings();
+
+	// Sanity check:
+	if (!WorldSettings)
+	{
+		return INDEX_NONE;
+	}
+
+	// The clusters are merged rather than simplified (so that no proxy-mesh plugin is needed), with their
+	// materials merged too (so that each cluster is one draw call), so any level set up that way will do:
+	TArray<FHierarchicalSimplification>& HLODSetup = WorldSettings->HierarchicalLODSetup;
+
+	for (int32 LODLevel = 0; LODLevel < HLODSetup.Num(); LODLevel++)
+	{
+		if (!HLODSetup[LODLevel].bSimplifyMesh && HLODSetup[LODLevel].MergeSetting.bMergeMaterials &&
+			FMath::IsNearlyEqual(HLODSetup[LODLevel].TransitionScreenSize, HLODTransitionScreenSize))
+		{
+			if (!WorldSettings->bEnableHierarchicalLODSystem)
+			{
+				UE_LOG(LogBalancedFPSLevelGeneratorTool, Warning, TEXT("Enabled the HLOD system of %s, for the HLOD clusters."),
+					*WorldSettings->GetWorld()->GetMapName());
+
+				WorldSettings->Modify();
+				WorldSettings->bEnableHierarchicalLODSystem = true;
+			}
+
+			return LODLevel;
+		}
+	}
+
+	// Otherwise, a level of its own is added after any the world already has (which are left as they are):
+	WorldSettings->Modify();
+
+	FHierarchicalSimplification& ClusterSetup = HLODSetup[HLODSetup.AddDefaulted()];
+	ClusterSetup.TransitionScreenSize = HLODTransitionScreenSize;
+	ClusterSetup.bSimplifyMesh = false;
+	ClusterSetup.MergeSetting.bMergeMaterials = true;
+	WorldSettings->bEnableHierarchicalLODSystem = true;
+
+	UE_LOG(LogBalancedFPSLevelGeneratorTool, Warning, TEXT("Added HLOD level %d to %s, for the HLOD clusters (with a transition screen size of %.3f)."),
+		HLODSetup.Num() - 1, *WorldSettings->GetWorld()->GetMapName(), HLODTransitionScreenSize);
+
+	return HLODSetup.Num() - 1;
+}
+
+ALODActor* UBalancedFPSLevelGeneratorTool::BuildHLODCluster(const TArray<AZone*>& ClusterZones, const FIntRect& ClusterRegion,
+	int32 ClusterLODLevel)
+{
+	SCOPE_CYCLE_COUNTER(STAT_HLODClusters);
+
+	UWorld* EditorWorld = GEditor->GetEditorWorldContext().World();
+	AWorldSettings* WorldSettings = EditorWorld->GetWorldSettings();
+	IHierarchicalLODUtilities* HLODUtilities = FModuleManager::LoadModuleChecked<IHierarchicalLODUtilitiesModule>(
+		"HierarchicalLODUtilities").GetUtilities();
+
+	// Sanity check:
+	if (!WorldSettings || !HLODUtilities || !WorldSettings->HierarchicalLODSetup.IsValidIndex(ClusterLODLevel))
+	{
+		return nullptr;
+	}
+
+	const FHierarchicalSimplification& ClusterSetup = WorldSettings->HierarchicalLODSetup[ClusterLODLevel];
+
+	// Spawned into the current level (the chunk's sub-level, if generating in chunks), as are its Zones:
+	ALODActor* ClusterActor = HLODUtilities->CreateNewClusterActor(EditorWorld, ClusterLODLevel, WorldSettings);
+
+	if (!ClusterActor)
+	{
+		return nullptr;
+	}
+
+	ClusterActor->SetActorLabel(FString::Printf(TEXT("HLODCluster_%d_%d"), ClusterRegion.Min.X, ClusterRegion.Min.Y));
+	INC_DWORD_STAT(STAT_ActorsSpawned);
+
+	for (AZone* ClusterZone : ClusterZones)
+	{
+		HLODUtilities->AddActorToCluster(ClusterZone, ClusterActor);
+	}
+
+	UPackage* ProxyPackage = HLODUtilities->CreateOrRetrieveLevelHLODPackage(EditorWorld->GetCurrentLevel());
+
+	if (!HLODUtilities->BuildStaticMeshForLODActor(ClusterActor, ProxyPackage, ClusterSetup))
+	{
+		HLODUtilities->DestroyCluster(ClusterActor);
+		EditorWorld->EditorDestroyActor(ClusterActor, true);
+		return nullptr;
+	}
+
+	GeneratedHLODActors.Add(ClusterActor);
+
+	return ClusterActor;
+}
+
+void UBalancedFPSLevelGeneratorTool::UnmergeGeneratedZoneMeshes()
+{
+	// The clusters first (which lets go of their Zones):
+	IHierarchicalLODUtilities* HLODUtilities = GeneratedHLODActors.Num() > 0 ?
+		FModuleManager::LoadModuleChecked<IHierarchicalLODUtilitiesModule>("HierarchicalLODUtilities").GetUtilities() : nullptr;
+
+	for (TWeakObjectPtr<AActor>& HLODActor : GeneratedHLODActors)
+	{
+		if (ALODActor* ClusterActor = Cast<ALODActor>(HLODActor.Get()))
+		{
+			HLODUtilities->DestroyCluster(ClusterActor);
+		}
+
+		DestroyGeneratedActor(HLODActor);
+	}
+
+	GeneratedHLODActors.Empty();
+
+	TArray<AZone*> GeneratedZones;
+	for (const TWeakObjectPtr<AActor>& GeneratedZoneActor : GeneratedZoneActors)
+	{
+		if (AZone* GeneratedZone = Cast<AZone>(GeneratedZoneActor.Get()))
+		{
+			GeneratedZones.Add(GeneratedZone);
+		}
+	}
+
+	TArray<AInstancedStaticMeshActor*> MergedActors;
+	for (const TWeakObjectPtr<AActor>& MergedActor : GeneratedMergedMeshActors)
+	{
+		if (AInstancedStaticMeshActor* MergedMeshActor = Cast<AInstancedStaticMeshActor>(MergedActor.Get()))
+		{
+			MergedActors.Add(MergedMeshActor);
+		}
+	}
+
+	FZoneMeshMerge::UnmergeZoneMeshes(GeneratedZones, MergedActors);
+	GeneratedMergedMeshActors.Empty();
+}
+
+void UBalancedFPSLevelGeneratorTool::DestroyGeneratedActor(TWeakObjectPtr<AActor>& GeneratedActor)
+{
+	if (AActor* ActorToDestroy = GeneratedActor.Get())
+	{
+		ActorToDestroy->GetWorld()->EditorDestroyActor(ActorToDestroy, true);
+	}
+
+	GeneratedActor.Reset();
+}
+
+FIntPoint UBalancedFPSLevelGeneratorTool::GetGridCellForZone(const FIntPoint& Zone, int GridHeight) const
+{
+	// The grid's first row is the furthest from LevelGenerationStartPoint (see GetZoneTransform()):
+	return FIntPoint(Zone.X, GridHeight - 1 - Zone.Y);
+}
+
+void UBalancedFPSLevelGeneratorTool::AddStreamingVolumeForChunk(ULevel* ChunkLevel, const FBox& ChunkBounds)
+{
+	UWorld* EditorWorld = GEditor->GetEditorWorldContext().World();
+	ULevelStreaming* ChunkStreamingLevel = FLevelUtils::FindStreamingLevel(ChunkLevel);
+
+	// Sanity check:
+	if (!ChunkStreamingLevel)
+	{
+		return;
+	}
+
+	// The volume lives in the persistent level, and reaches beyond the chunk by the streaming distance:
+	FActorSpawnParameters VolumeSpawnParameters;
+	VolumeSpawnParameters.OverrideLevel = EditorWorld->PersistentLevel;
+
+	ALevelStreamingVolume* ChunkStreamingVolume = EditorWorld->SpawnActor<ALevelStreamingVolume>(
+		ALevelStreamingVolume::StaticClass(), FTransform(ChunkBounds.GetCenter()), VolumeSpawnParameters);
+
+	if (!ChunkStreamingVolume)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_ActorsSpawned);
+
+	FVector VolumeSize = ChunkBounds.GetSize() + FVector(2.0f * ChunkStreamingDistance);
+
+	UCubeBuilder* VolumeBrushBuilder = NewObject<UCubeBuilder>();
+	VolumeBrushBuilder->X = VolumeSize.X;
+	VolumeBrushBuilder->Y = VolumeSize.Y;
+	VolumeBrushBuilder->Z = VolumeSize.Z;
+	VolumeBrushBuilder->Build(EditorWorld, ChunkStreamingVolume);
+
+	ChunkStreamingVolume->SetActorLabel(FString::Printf(TEXT("%s_StreamingVolume"),
+		*FPackageName::GetShortName(ChunkStreamingLevel->GetWorldAssetPackageFName())));
+	ChunkStreamingVolume->StreamingLevelNames.AddUnique(ChunkStreamingLevel->GetWorldAssetPackageFName());
+	ChunkStreamingLevel->EditorStreamingVolumes.AddUnique(ChunkStreamingVolume);
+	ChunkStreamingVolume->PostEditChange();
+}
+
+FBox UBalancedFPSLevelGeneratorTool::GetZoneRegionBounds(const FIntRect& ZoneRegion, int GridHeight) const
+{
+	// From the corner of the first Zone, to the opposite corner of the last (rows run southwards in the world):
+	FVector RegionMinimum = GetZoneTransform(ZoneRegion.Min.X, ZoneRegion.Max.Y - 1, GridHeight).GetLocation() -
+		FVector(ZONE_POSITION_OFFSET.X, ZONE_POSITION_OFFSET.Y, 0.0f);
+	FVector RegionMaximum = GetZoneTransform(ZoneRegion.Max.X - 1, ZoneRegion.Min.Y, GridHeight).GetLocation() +
+		FVector(ZONE_POSITION_OFFSET.X, ZONE_POSITION_OFFSET.Y, 0.0f);
+
+	// Including the encapsulation geometry:
+	RegionMinimum.Z = LevelGenerationStartPoint.Z - DEFAULT_ENCAPSULATION_OFFSET;
+	RegionMaximum.Z = LevelGenerationStartPoint.Z + DEFAULT_TILE_HEIGHT;
+
+	return FBox(RegionMinimum, RegionMaximum);
+}
+
+bool UBalancedFPSLevelGeneratorTool::GatherZoneTileSet(std::vector<FWangTileDefinition>& OutTileSet)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ZoneDiscovery);
+
+	CachedZoneProfiles.SetNum(LevelZoneTileBlueprints.Num());
+
+	OutTileSet.clear();
+	OutTileSet.reserve(LevelZoneTileBlueprints.Num());
+
+	for (int WangTileIndex = 0; WangTileIndex < LevelZoneTileBlueprints.Num(); WangTileIndex++)
+	{
+		const FZoneProfile* ZoneProfile = GetZoneProfile(WangTileIndex);
+
+		if (!ZoneProfile)
+		{
+			return false;
+		}
+
+		OutTileSet.push_back(FZoneTileSet::MakeTileDefinition(*ZoneProfile));
+	}
+
+	return true;
+}
+
+const FZoneProfile* UBalancedFPSLevelGeneratorTool::GetZoneProfile(int WangTileIndex)
+{
+	TOptional<FZoneProfile>& CachedZoneProfile = CachedZoneProfiles[WangTileIndex];
+
+	if (!CachedZoneProfile.IsSet())
+	{
+		UBlueprint* ZoneTileBlueprint = LevelZoneTileBlueprints[WangTileIndex];
+
+		// Sanity check:
+		if (!ZoneTileBlueprint || !ZoneTileBlueprint->GeneratedClass ||
+			!ZoneTileBlueprint->GeneratedClass->IsChildOf(AZone::StaticClass()))
+		{
+			return nullptr;
+		}
+
+		CachedZoneProfile = AZone::BuildZoneProfile(ZoneTileBlueprint->GeneratedClass, WangTileIndex);
+
+		// (Only once for each Blueprint):
+		if (!ProfiledZoneBlueprints.Contains(ZoneTileBlueprint))
+		{
+			ZoneTileBlueprint->OnCompiled().AddUObject(this, &UBalancedFPSLevelGeneratorTool::OnZoneBlueprintCompiled);
+			ProfiledZoneBlueprints.Add(ZoneTileBlueprint);
+		}
+	}
+
+	return &CachedZoneProfile.GetValue();
+}
+
+void UBalancedFPSLevelGeneratorTool::OnZoneBlueprintCompiled(UBlueprint* CompiledBlueprint)
+{
+	const int WangTileIndex = LevelZoneTileBlueprints.Find(CompiledBlueprint);
+
+	if (CachedZoneProfiles.IsValidIndex(WangTileIndex))
+	{
+		CachedZoneProfiles[WangTileIndex].Reset();
+	}
+}
+
+FWangTileSolverSettings UBalancedFPSLevelGeneratorTool::GetSolverSettings(int GridWidth, int GridHeight) const
+{
+	FWangTileSolverSettings Settings;
+	Settings.GridWidth = GridWidth;
+	Settings.GridHeight = GridHeight;
+	Settings.Seed = static_cast<uint32>(Seed);
+	Settings.PropagateConstraints = bPropagateConstraints;
+	Settings.RequireConnectivity = bRequireConnectivity;
+
+	// Let the solver use the task graph's worker threads (as well as this one):
+	if (bSolveInParallel)
+	{
+		Settings.ThreadCount = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+		Settings.ParallelFor = [](int TaskCount, const std::function<void(int TaskIndex)>& Task)
+		{
+			ParallelFor(TaskCount, [&Task](int32 TaskIndex) { Task(TaskIndex); });
+		};
+	}
+
+	// (The same rules as AZoneArenaGenerator, so a Seed generates the same layout in a game):
+	FZoneTileSet::ApplyPlacementRules(Settings);
+
+	return Settings;
+}
+
+FTransform UBalancedFPSLevelGeneratorTool::GetZoneTransform(int GridX, int GridY, int GridHeight) const
+{
+	// Work backwards from the last row (offset to fall within the level-generation area):
+	FVector ZonePosition = FVector(
+		LevelGenerationStartPoint.X + GridX * DEFAULT_TILE_WIDTH + ZONE_POSITION_OFFSET.X,
+		LevelGenerationStartPoint.Y + LevelExtents.Y - GridY * DEFAULT_TILE_HEIGHT - ZONE_POSITION_OFFSET.Y,
+		DEFAULT_TILE_Z_POSITION);
+
+	return FTransform(FRotator::ZeroRotator.Quaternion(), ZonePosition, DEFAULT_ZONE_SCALE);
 }
@@ -1,5 +0,0 @@
-// Copyright 1998-2013 Epic Games, Inc. All Rights Reserved.
-
-#include "InstancedStaticMeshActor.h"
-#include "ConstructorHelpers.h"
-#include "Runtime/Engine/Classes/Engine/World.h"
@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Dom/JsonObject.h"
+#include "BalancedFPSLevelGeneratorBenchmarkCommandlet.generated.h"
+
+/**
+ * Generates levels headlessly, over a matrix of LevelExtents and Seeds, and records how
+ * long each stage took (with the actor count, memory use and tiles per second) to a JSON
+ * file. If given a baseline file (from an earlier run), any regressions are flagged, and
+ * the commandlet returns 1.
+ *
+ * For example:
+ * UE4Editor-Cmd.exe Project.uproject -run=BalancedFPSLevelGeneratorBenchmark
+ *	-Map=/Game/Maps/ZoneTileSet -Extents=300x300+1000x1000+3000x3000 -Seeds=0+1+2
+ *	-Output=Benchmark.json -Baseline=BenchmarkBaseline.json -Tolerance=0.1
+ *
+ * The map is loaded again before each generation (the Zone Blueprints are profiled once,
+ * so the map need not hold any Zones).
+ */
+UCLASS()
+class BALANCEDFPSLEVELGENERATOR_API UBalancedFPSLevelGeneratorBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	// Functions/Methods:
+
+	/** Standard constructor. */
+	UBalancedFPSLevelGeneratorBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+
+	// Functions/Methods:
+
+	/** Generate one level, and record the result (or nullptr, if the map could not be loaded). */
+	TSharedPtr<FJsonObject> RunBenchmark(const FString& MapName, const FVector2D& LevelExtents, int32 Seed) const;
+
+	/**
+	* Compare each run against the run with the same LevelExtents and Seed in the baseline,
+	* adding a 'Regressions' array to each run that regressed. Returns the number of regressions.
+	*/
+	int32 FlagRegressions(const TArray<TSharedPtr<FJsonValue>>& Runs, const FString& BaselinePath,
+		float RegressionTolerance) const;
+
+	/** For matching runs against the baseline. */
+	static FString GetRunKey(const FJsonObject& Run);
+
+	/** Parse '300x300+1000x1000' (for -Extents). */
+	static TArray<FVector2D> ParseLevelExtents(const FString& ExtentsList);
+
+	/** Parse '0+1+2' (for -Seeds). */
+	static TArray<int32> ParseSeeds(const FString& SeedList);
+
+	// Constant Values:
+
+	/** How much slower (or larger) than the baseline a run may be, before it is flagged. */
+	const float DEFAULT_REGRESSION_TOLERANCE = 0.10f;
+
+	/** Timings shorter than this differ by noise alone, so they are never flagged. */
+	const double MINIMUM_REGRESSION_SECONDS = 0.01;
+
+	const float BYTES_PER_MEGABYTE = 1024.0f * 1024.0f;
+};
@@ -4,12 +4,28 @@
 
 #include "CoreMinimal.h"
 #include "BaseEditorTool.h"
+#include "Async/Future.h"
+#include "Misc/Optional.h"
+#include "Engine/EngineTypes.h"
+#include <atomic>
 
 // Bespoke header files:
 #include "Zone.h"
+#include "WangTileSolver.h"
+#include "WangTileBalanceMap.h"
+#include "ZoneTileSet.h"
 
 #include "BalancedFPSLevelGeneratorTool.generated.h"
 
+/** How long each stage of the last (non-asynchronous) generation took, in seconds. */
+struct FLevelGenerationTimings
+{
+	double SolveSeconds = 0.0;
+	double EncapsulationSeconds = 0.0;
+	double LightSourceSeconds = 0.0;
+	double ZoneSeconds = 0.0;
+};
+
 /**
  * This is the main class of this bundle, that handles the top-layer of level generation.
  * Functionality for certain components of this level generation, is handled by other
@@ -31,26 +47,47 @@ public:
 	UFUNCTION(Exec)
 	void GenerateLevel();
 
-	// Properties:
+	/** Pick a new Seed, for a different level on the next generation. */
+	UFUNCTION(Exec)
+	void RandomiseSeed();
+
+	/** 
+	* Choose the Zones in the dirty region afresh (and any Zones that then no longer suit their
+	* neighbours), and respawn only the Zones that changed. Any change to LevelExtents or
+	* LevelGenerationStartPoint is followed too, keeping the Zones still within the area.
+	*/
+	UFUNCTION(Exec)
+	void RegenerateDirtyRegion();
+
+	/** Add the Zones selected in the level viewport to PinnedZones. */
+	UFUNCTION(Exec)
+	void PinSelectedZones();
+
+	/** Save the last level generated (with its Seed and LevelExtents) to LayoutFilePath. */
+	UFUNCTION(Exec)
+	void SaveLayout();
+
+	/** 
+	* Rebuild the level saved in LayoutFilePath, without solving it again (Seed and LevelExtents
+	* are set to those it was saved with). It is spawned as GenerateLevel would spawn it.
+	*/
+	UFUNCTION(Exec)
+	void LoadLayout();
+
+	/** Show the balance of the Zones between BalanceQueryMin and BalanceQueryMax, in the last level generated. */
+	UFUNCTION(Exec)
+	void QueryRegionBalance();
+
+	/** Cancel an asynchronous generation, if the tool's window is closed part of the way through. */
+	virtual void BeginDestroy() override;
+
+	/** For the benchmark commandlet (see UBalancedFPSLevelGeneratorBenchmarkCommandlet). */
+	const FLevelGenerationTimings& GetLastGenerationTimings() const { return LastGenerationTimings; }
 
-	// Enumerations:
-
-	/** To check where Zone(s) are relative to the current position. */
-	enum ZoneAdjacencyDirection
-	{
-		Westwards,
-		Southwards,
-		Eastwords,
-		Northwords
-	};
-
-	/** For which collection to choose a Zone index from. */
-	enum ZoneCollectionToChoose
-	{
-		WangTile2Collection,
-		Wangtile10Collection,
-		OtherCollection
-	};
+	/** The number of Zones that fit along each axis of the level-generation area. */
+	FIntPoint GetZoneGridSize() const;
+
+	// Properties:
 
 	/** 
 	* UPROPERTY macro usage here allows these properties to be edited
@@ -64,6 +101,111 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Core Properties")
 	FVector LevelGenerationStartPoint;
 
+	/** Encapsulate the area with one instanced actor per face, rather than a WallPanel actor per panel. */
+	UPROPERTY(EditAnywhere, Category = "Core Properties")
+	bool bUseInstancedWallPanels;
+
+	/** The same Seed and LevelExtents will always generate the same level. */
+	UPROPERTY(EditAnywhere, Category = "Core Properties")
+	int32 Seed;
+
+	/** For a checksum of the last Zone layout generated (the same for a Seed on every machine). */
+	UPROPERTY(VisibleAnywhere, Category = "Core Properties")
+	FString LayoutChecksum;
+
+	/** Solve the Zone layout across every core (the layout is the same either way). */
+	UPROPERTY(EditAnywhere, Category = "Core Properties")
+	bool bSolveInParallel;
+
+	/** Solve this many layouts from Seed onwards, spawn the most balanced, and set Seed to its Seed. */
+	UPROPERTY(EditAnywhere, Category = "Balance", meta = (ClampMin = "1"))
+	int32 CandidateLayoutCount;
+
+	/** How balanced the spawned layout was against the other candidates (lower is better). */
+	UPROPERTY(VisibleAnywhere, Category = "Balance")
+	FString CandidateScoreSpread;
+
+	/** Only place Zones that leave every other Zone one that suits its neighbours (slower, not in parallel). */
+	UPROPERTY(EditAnywhere, Category = "Balance")
+	bool bPropagateConstraints;
+
+	/** Solve the Zones around any walkable part of the layout that is cut off again. */
+	UPROPERTY(EditAnywhere, Category = "Balance")
+	bool bRequireConnectivity;
+
+	/** How many walkable regions the last Zone layout generated has, and which are cut off (see FWangTileConnectivity). */
+	UPROPERTY(VisibleAnywhere, Category = "Balance")
+	FString ConnectivityReport;
+
+	/** The mean, range and spread of each Coefficient in the last layout (see FWangTileBalanceMap). */
+	UPROPERTY(VisibleAnywhere, Category = "Balance")
+	FString BalanceReport;
+
+	/** The corners of the Zones for QueryRegionBalance (counted as for the dirty region). */
+	UPROPERTY(EditAnywhere, Category = "Balance")
+	FIntPoint BalanceQueryMin;
+
+	UPROPERTY(EditAnywhere, Category = "Balance")
+	FIntPoint BalanceQueryMax;
+
+	/** The mean of each Coefficient in the Zones queried (by QueryRegionBalance). */
+	UPROPERTY(VisibleAnywhere, Category = "Balance")
+	FString BalanceQueryResult;
+
+	/** The corners of the Zones for RegenerateDirtyRegion, from the Zone at LevelGenerationStartPoint. */
+	UPROPERTY(EditAnywhere, Category = "Regeneration")
+	FIntPoint DirtyRegionMin;
+
+	UPROPERTY(EditAnywhere, Category = "Regeneration")
+	FIntPoint DirtyRegionMax;
+
+	/** Zones (counted as for the dirty region) that RegenerateDirtyRegion always keeps. */
+	UPROPERTY(EditAnywhere, Category = "Regeneration")
+	TArray<FIntPoint> PinnedZones;
+
+	/** Write each chunk of the area to its own streaming sub-level (the current level must be saved). */
+	UPROPERTY(EditAnywhere, Category = "Streaming")
+	bool bGenerateInStreamingChunks;
+
+	/** The width and height of each chunk, in Zones. */
+	UPROPERTY(EditAnywhere, Category = "Streaming", meta = (ClampMin = "1"))
+	int32 ChunkSizeInTiles;
+
+	/** How far a chunk's streaming volume reaches beyond it (so the chunk is loaded before it is seen). */
+	UPROPERTY(EditAnywhere, Category = "Streaming", meta = (ClampMin = "0.0"))
+	float ChunkStreamingDistance;
+
+	/** Place the Zones off the game thread, then spawn them over several (cancellable) ticks. */
+	UPROPERTY(EditAnywhere, Category = "Asynchronous Generation")
+	bool bGenerateAsynchronously;
+
+	/** How long each tick may spend spawning, when generating asynchronously. */
+	UPROPERTY(EditAnywhere, Category = "Asynchronous Generation", meta = (ClampMin = "1.0"))
+	float SpawnBudgetMilliseconds;
+
+	/** For SaveLayout and LoadLayout (and AZoneArenaGenerator::LoadArena), see FWangTileLayoutFile. */
+	UPROPERTY(EditAnywhere, Category = "Layout File", meta = (FilePathFilter = "wtl"))
+	FFilePath LayoutFilePath;
+
+	/** Draw (and collide) the Zones' objects with an instanced component per mesh (see FZoneMeshMerge). */
+	UPROPERTY(EditAnywhere, Category = "Mesh Merging")
+	bool bMergeZoneMeshes;
+
+	/** Build a merged proxy mesh for each HLODClusterSizeInTiles square of Zones (not for packed Zones). */
+	UPROPERTY(EditAnywhere, Category = "HLOD Clusters")
+	bool bBuildHLODClusters;
+
+	UPROPERTY(EditAnywhere, Category = "HLOD Clusters", meta = (ClampMin = "1"))
+	int32 HLODClusterSizeInTiles;
+
+	/** The fraction of the screen a cluster must shrink to, before its proxy mesh is drawn. */
+	UPROPERTY(EditAnywhere, Category = "HLOD Clusters", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float HLODTransitionScreenSize;
+
+	/** Record the Zones in one APackedZoneLayout per chunk, rather than spawning a Zone actor for each. */
+	UPROPERTY(EditAnywhere, Category = "Packed Output")
+	bool bPackZones;
+
 private:
 
 	// Functions/Methods:
@@ -71,66 +213,154 @@ private:
 	/** Create a box that encapsulates the area defined by the user. */
 	void InitialiseLevelGenerationArea();
 
-	/** First, static-mesh actors are used to create the box. */
-	void EncapsulateLevelGenerationArea();
+	/** First, static-mesh actors are used to create the box (over and under the given Zones). */
+	void EncapsulateLevelGenerationArea(const FIntRect& ZoneRegion, int GridHeight);
+
+	class AActor* SpawnTopOrBottomWallPanelTileForCurrentPosition(FVector PanelTilePosition, bool IsTopFaceTile);
+
+	/** For the corner of the panels over and under the Zone at the given grid cell. */
+	FVector GetPanelTilePosition(int GridX, int GridY, int GridHeight) const;
+
+	/** For the transform of a panel in either the top or bottom face. */
+	FTransform GetTopOrBottomWallPanelTransform(FVector PanelTilePosition, bool IsTopFaceTile) const;
 
-	void SpawnTopOrBottomWallPanelTileForCurrentPosition(FVector PanelTilePosition, bool IsTopFaceTile);
+	/** Spawn one instanced actor, that holds all of the panels of a face. */
+	class AActor* SpawnInstancedWallPanelFace(const TArray<FTransform>& PanelTransforms, const FString& FaceLabel);
+
+	/** For the static-mesh component (template) of the WallPanel Blueprint. */
+	class UStaticMeshComponent* FindWallPanelMeshTemplate() const;
 
 	/** Then spawn a light source, for that area. */
 	void AddLightSourceToLevelGenerationArea();
 
+	/** At the centre of the level-generation area. */
+	FTransform GetLightSourceTransform() const;
+
 	/** 
 	* Now the generator will populate that area with 
 	* Zones (Wang Tiles). 
 	*/
-	void AddZonesToLevelGenerationArea();
+	void AddZonesToLevelGenerationArea(const FWangTileGrid& ZoneLayout, const FIntRect& ZoneRegion);
 
-	/** For determining which tile to use. */
-	class UBlueprint* GetSuitableZoneTile(FVector2D CurrentPlacementPosition);
+	/** Gather what the solver needs (on the game thread). Returns false if the tile-set is incomplete. */
+	bool PrepareZoneSolve(std::vector<FWangTileDefinition>& OutZoneTileSet,
+		FWangTileSolverSettings& OutSolverSettings);
+
+	/** Run the solver over the level-generation area. Returns false if no layout could be made. */
+	bool SolveZoneLayout(FWangTileGrid& OutZoneLayout);
 
 	/** 
-	* This function also retrives a Zone index,
-	* but uses the Coefficients for comparison, intead
-	* of the edge-colours.
+	* Solve one layout, or the best of CandidateCount layouts (this can be called from any
+	* thread, as it only uses what it is given).
 	*/
-	int GetZoneConsideringCoefficients(int ZoneToCompareTo, ZoneAdjacencyDirection PlacedZoneAdjacency);
+	static bool RunZoneSolver(const std::vector<FWangTileDefinition>& ZoneTileSet,
+		const FWangTileSolverSettings& SolverSettings, int32 CandidateCount, FWangTileGrid& OutZoneLayout,
+		FWangTileCandidateReport& OutCandidateReport);
 
-	/** Get the Zone corresponding to the ZoneChoice. */
-	UBlueprint* GetTargetZone(int ZoneChoice);
+	/** Show the checksum of a solved layout (and its score, and Seed, if it was the best of several). */
+	void ReportZoneLayout(const FWangTileGrid& ZoneLayout, const FWangTileCandidateReport& CandidateReport);
 
-	// Helper functions:
+	/** Build the balance map of a layout (for QueryRegionBalance()), and show its report (and its connectivity). */
+	void ReportZoneBalance(const FWangTileGrid& ZoneLayout);
 
-	// Checking what piece or particular Wang-Tile this Zone is:
+	/** Show whether every walkable part of a layout can be reached from every other. */
+	void ReportZoneConnectivity(const std::vector<FWangTileDefinition>& ZoneTileSet, const FWangTileGrid& ZoneLayout);
 
-	bool ZoneIsEdgePiece(int ConsideredZone);
-	bool ZoneIsCornerPiece(int ConsideredZone);
-	bool ZoneIsWangTile2Or10(int ConsideredZone, bool CheckingForWangTile2);
-	
-	// For getting indices:
-	void FindApplicableZoneIndicesConsideringDispersion(int PlacedZoneIndex);
-	int GetApplicableZoneIndex(ZoneCollectionToChoose CollectionToConsider);
-	int PickZoneConsideringAdjacencyToWangTile10Or2(int ConsideredAdjacentZoneID);
-	void FindApplicableZoneIndicesConsideringDefensiveness(bool IsGreaterThanThreshold);
+	// Spawning (which can be spread across several ticks):
 
-	// Conditional checks:
+	/** 
+	* Split the layout into the regions to spawn: the whole area, or one region per
+	* streaming chunk. Returns false if the layout cannot be spawned.
+	*/
+	bool BeginSpawningZoneLayout(TSharedPtr<FWangTileGrid, ESPMode::ThreadSafe> ZoneLayout);
 
-	bool PlacedZoneDefensivenessIsGreaterThanOrEqualToOrLessThanOrEqualToThreshold(
-		int ZoneIndexToCheckAgainstThreshold, bool IsGreaterThanOrEqualToCheck);
-	bool ZoneSubsetDefensivenessIsGreaterThanOrEqualToOrLessThanOrEqualToThreshold(
-		int ZoneIndexToCheckAgainstThreshold, bool IsGreaterThanOrEqualToCheck);
+	/** Spawn the pending regions until the deadline (in seconds). Returns true once all are spawned. */
+	bool SpawnPendingZoneRegions(double SpawnDeadline);
 
-	// Considering Dispersion:
+	/** Create a chunk's sub-level (if generating in chunks), and add its instanced panels. */
+	void BeginZoneRegion(const FIntRect& ZoneRegion);
 
-	bool ZoneHasPureEvenZoneDispersion(float ConsideredZoneDispersionCoefficient);
-	bool ZoneHasHalfEvenZoneDispersion(float ConsideredZoneDispersionCoefficient);
+	/** Save a chunk's sub-level, and add its streaming volume. */
+	void EndZoneRegion(const FIntRect& ZoneRegion);
 
-	// Properties:
+	/** Spawn the packed-Zone actor for the region (which AddZonesToLevelGenerationArea() then records into). */
+	void BeginPackedZoneRegion(const FIntRect& ZoneRegion);
+
+	// Asynchronous generation:
+
+	void BeginAsynchronousGeneration();
+
+	/** Show the progress of an asynchronous generation (which can be cancelled), and start ticking it. */
+	void BeginGenerationTicker(const FText& ProgressText);
+	bool TickAsynchronousGeneration(float DeltaTime);
+	void CancelAsynchronousGeneration();
+	void EndAsynchronousGeneration(bool bSucceeded, const FText& ResultText);
+	bool IsGenerating() const;
+
+	// Regenerating part of the last level generated:
+
+	/** 
+	* Follow any change to the level-generation area, keeping the Zones still within it where they
+	* are. Returns true if the area changed (OutRefillRects then holds the cells to fill).
+	*/
+	bool ResizeGeneratedZoneLayout(const FIntPoint& GridSize, std::vector<FWangTileRect>& OutRefillRects);
+
+	/** Move the Zones, panels and light source kept by ResizeGeneratedZoneLayout() to their new positions. */
+	void MoveGeneratedActors();
+
+	/** 
+	* Merge the meshes of the generated Zones in the given region, if bMergeZoneMeshes (see
+	* FZoneMeshMerge), and build their HLOD clusters, if bBuildHLODClusters.
+	*/
+	void MergeGeneratedZoneMeshes(const FIntRect& ZoneRegion);
+
+	/**
+	* For the index of the world's HLOD level that the clusters are built at: the first that suits
+	* them, or one added for them (the world's other levels are never changed). INDEX_NONE if the
+	* world has no settings.
+	*/
+	int32 PrepareHLODClusterLevel();
 
 	/** 
-	* For populating with applicable Zone indices, after determining such,
-	* based on the Coefficients of Zones.
+	* For the HLOD cluster of the given Zones, at the given HLOD level, with its proxy mesh built from
+	* their meshes (or nullptr, if it could not be built).
 	*/
-	std::vector<int> ApplicableZoneIndices;
+	class ALODActor* BuildHLODCluster(const TArray<AZone*>& ClusterZones, const FIntRect& ClusterRegion,
+		int32 ClusterLODLevel);
+
+	/** Show the generated Zones' own meshes again, and destroy the merged actors and HLOD clusters. */
+	void UnmergeGeneratedZoneMeshes();
+
+	void DestroyGeneratedActor(TWeakObjectPtr<class AActor>& GeneratedActor);
+
+	/** For the grid cell of a Zone (as counted for DirtyRegionMin, DirtyRegionMax and PinnedZones). */
+	FIntPoint GetGridCellForZone(const FIntPoint& Zone, int GridHeight) const;
+
+	/** So that the chunk is only loaded when the player is near it. */
+	void AddStreamingVolumeForChunk(class ULevel* ChunkLevel, const FBox& ChunkBounds);
+
+	/** For the world-space bounds of the given Zones (including the encapsulation). */
+	FBox GetZoneRegionBounds(const FIntRect& ZoneRegion, int GridHeight) const;
+
+	/** 
+	* Describe each Zone Blueprint to the solver, from its (cached) profile.
+	* Returns false if any are missing.
+	*/
+	bool GatherZoneTileSet(std::vector<FWangTileDefinition>& OutTileSet);
+
+	/** For the profile of the Zone Blueprint at WangTileIndex (built once, then again only if it is recompiled). */
+	const FZoneProfile* GetZoneProfile(int WangTileIndex);
+
+	/** So that the profile of a recompiled Zone Blueprint is built again. */
+	void OnZoneBlueprintCompiled(UBlueprint* CompiledBlueprint);
+
+	/** For the tiles the solver places in the corners, along the edges and next to WangTile2/10. */
+	FWangTileSolverSettings GetSolverSettings(int GridWidth, int GridHeight) const;
+
+	/** The world-space transform for the Zone at the given grid cell. */
+	FTransform GetZoneTransform(int GridX, int GridY, int GridHeight) const;
+
+	// Properties:
 
 	/** The default scale for the panels of the level. */
 	FVector DefaultRelativePanelScale;
@@ -145,40 +375,65 @@ private:
 	/** All of the Zone Blueprints (Wang Tiles) to be used in level generation. */
 	TArray<UBlueprint*> LevelZoneTileBlueprints;
 
-	/** For the Zone Blueprints to spawn. */
-	TArray<AZone*> LevelZones;
+	/** For the profile of each Zone Blueprint (indexed as LevelZoneTileBlueprints, and unset until built). */
+	TArray<TOptional<FZoneProfile>> CachedZoneProfiles;
 
-	/** For all of the zones placed in the level (from the LevelZoneTileBlueprints set). */
-	TArray<AZone*> PlacedLevelZones;
+	/** The Zone Blueprints that have been profiled (to stop listening for them being recompiled). */
+	TArray<TWeakObjectPtr<UBlueprint>> ProfiledZoneBlueprints;
 
-	/** As for some reason, the position of the Zones would not match-up to their actual position. */
-	std::vector<FVector2D> PlacedZonePositions;
+	// For a generation that is part of the way through:
 
-	/** 
-	* For the relative locations of the corners of a 
-	* level-generation area:
-	*/
-	FVector2D TopLeftCorner;
-	FVector2D TopRightCorner;
-	FVector2D BottomRightCorner;
-	FVector2D BottomLeftCorner;
+	/** The layout being spawned (shared with the solver's thread, when generating asynchronously). */
+	TSharedPtr<FWangTileGrid, ESPMode::ThreadSafe> PendingZoneLayout;
+	TFuture<bool> PendingZoneSolve;
+	TSharedPtr<FWangTileCandidateReport, ESPMode::ThreadSafe> PendingCandidateReport;
+	TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe> PendingGenerationCancelled;
 
-	/** 
-	* For determining which Zone to choose from, based on Coefficient 
-	* comparison between a given Zone and either WangTile2 or WangTile10.
-	*/
-	std::vector<int> ApplicableZoneIndicesForWangTile2;
-	std::vector<int> ApplicableZoneIndicesForWangTile10;
+	/** The regions still to spawn, and how far through the current region spawning is. */
+	TArray<FIntRect> PendingZoneRegions;
+	int PendingZoneRegionIndex;
+	int PendingZoneCellIndex;
+	bool bPendingZoneRegionBegun;
 
-	// Constant Values:
+	/** The sub-level of the chunk being spawned (if generating in chunks). */
+	class ULevel* PendingZoneRegionLevel;
 
-	/** 
-	* For the tag used to identify Blueprints already in the level, when it's loaded
-	* or a level has already been generated. 
-	*/
-	const FName TILE_SPAWN_BLUEPRINT_TAG = "TileSpawnBlueprint";
-	/** For a count of all of the Blueprints that represent Zones. */
-	const int TOTAL_ZONE_BLUEPRINT_COUNT = 22;
+	/** The packed Zones of the region being spawned (if bPackZones). */
+	class APackedZoneLayout* PendingPackedZoneLayout;
+
+	int SpawnedZoneCount;
+
+	TSharedPtr<class SNotificationItem> GenerationNotification;
+	FDelegateHandle GenerationTickerHandle;
+
+	FLevelGenerationTimings LastGenerationTimings;
+
+	// For the last level generated (so that parts of it can be regenerated):
+
+	TSharedPtr<FWangTileGrid, ESPMode::ThreadSafe> GeneratedZoneLayout;
+
+	/** The Coefficients of each cell of GeneratedZoneLayout, with their summed-area tables. */
+	FWangTileBalanceMap GeneratedBalanceMap;
+
+	/** Indexed by cell (with the bottom and then top panel of each cell, if the panels are not instanced). */
+	TArray<TWeakObjectPtr<class AActor>> GeneratedZoneActors;
+	TArray<TWeakObjectPtr<class AActor>> GeneratedPanelActors;
+
+	TArray<TWeakObjectPtr<class AActor>> GeneratedPanelFaces;
+	TArray<TWeakObjectPtr<class AActor>> GeneratedMergedMeshActors;
+	TArray<TWeakObjectPtr<class AActor>> GeneratedHLODActors;
+	TWeakObjectPtr<class AActor> GeneratedLightSource;
+
+	FVector2D GeneratedLevelExtents;
+	FVector GeneratedStartPoint;
+	bool bGeneratedWithInstancedWallPanels;
+	bool bGeneratedInStreamingChunks;
+	bool bGeneratedPackedZones;
+
+	/** So that each regeneration rerolls the dirty region differently. */
+	uint32 RegenerationCount;
+
+	// Constant Values:
 
 	// Other default tile properties:
 
@@ -211,43 +466,4 @@ private:
 	* operations are also used on this value).
 	*/
 	const float DEFAULT_ENCAPSULATION_OFFSET = 10.0f;
-
-	// For the indices of the Zones (stored in a TArray):
-
-	const int ZONE_ONE_INDEX = 0;
-	const int ZONE_TWO_INDEX = 1;
-	const int ZONE_THREE_INDEX = 2;
-	const int ZONE_FOUR_INDEX = 3;
-	const int ZONE_FIVE_INDEX = 4;
-	const int ZONE_SIX_INDEX = 5;
-	const int ZONE_SEVEN_INDEX = 6;
-	const int ZONE_EIGHT_INDEX = 7;
-	const int ZONE_NINE_INDEX = 8;
-	const int ZONE_TEN_INDEX = 9;
-	const int ZONE_ELEVEN_INDEX = 10;
-	const int ZONE_TWELVE_INDEX = 11;
-	const int ZONE_THIRTEEN_INDEX = 12;
-	const int ZONE_FOURTEEN_INDEX = 13;
-	const int ZONE_FIFTHTEEN_INDEX = 14;
-	const int ZONE_SIXTEEN_INDEX = 15;
-	const int ZONE_SEVENTEEN_INDEX = 16;
-	const int ZONE_EIGHTEEN_INDEX = 17;
-	const int ZONE_NINETEEN_INDEX = 18;
-	const int ZONE_TWENTY_INDEX = 19;
-	const int ZONE_TWENTY_ONE_INDEX = 20;
-	const int ZONE_TWENTY_TWO_INDEX = 21;
-
-	// Used in comparsion between Coefficients:
-
-	/** Only 1 Component in the Zone. */
-	const float PURE_EVEN_ZONE_DISPERSION = 1.0f;
-
-	/** For 2 Components in the zone. */
-	const float HALF_EVEN_ZONE_DISPERSION = 0.50f;
-
-	/** For a corner piece. */
-	const float CORNER_PIECE_ZONE_DISPERSION = 0.250f;
-
-	/** For comparing Zone Defensiveness Coefficient Values. */
-	const float ZONE_DEFENSIVENESS_COEFFICIENT_THRESHOLD = 0.80f;
 };
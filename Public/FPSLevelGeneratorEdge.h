@@ -1,20 +0,0 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "UObject/NoExportTypes.h"
-#include "FPSLevelGeneratorEdge.generated.h"
-
-/**
- * 
- */
-UCLASS()
-class BALANCEDFPSLEVELGENERATOR_API UFPSLevelGeneratorEdge : public UObject
-{
-	GENERATED_BODY()
-
-public:
-
-	
-};